@@ -1,6 +1,7 @@
 #include "Alarm.h"
 #include "Utils.h"
 #include "SysTime.h"
+#include "I2cScheduler.h"
 
 #include <mutex>
 #include <stdio.h>
@@ -42,7 +43,10 @@ bool Alarm::Initialize()
 
 bool Alarm::IsConnected()
 {
-    return _pca9536.GetMode(DC_MOTOR) == IO_OUTPUT && _pca9536.GetMode(GREEN_LED) == IO_OUTPUT && _pca9536.GetMode(RED_LED) == IO_OUTPUT;
+    // The configuration must be read back from the device, not from the cache
+    // A failed read would look like output pins
+    _pca9536.InvalidateCache();
+    return _pca9536.IsConnected() && _pca9536.GetMode(DC_MOTOR) == IO_OUTPUT && _pca9536.GetMode(GREEN_LED) == IO_OUTPUT && _pca9536.GetMode(RED_LED) == IO_OUTPUT;
 }
 
 uint8_t Alarm::GetPinState(pin_t pin)
@@ -178,6 +182,7 @@ void Alarm::StopBlinkGreenAlarm()
 std::thread Alarm::TurnOnBlinkRedAlarmThread()
 {
     return std::thread([=] {
+        I2cPriorityScope priorityScope(highPriority);
         TurnOnBlinkRedAlarm();
     });
 }
@@ -185,6 +190,7 @@ std::thread Alarm::TurnOnBlinkRedAlarmThread()
 std::thread Alarm::TurnOnBlinkLedsAlarmThread()
 {
     return std::thread([=] {
+        I2cPriorityScope priorityScope(highPriority);
         TurnOnBlinkLedsAlarm();
     });
 }
@@ -192,6 +198,7 @@ std::thread Alarm::TurnOnBlinkLedsAlarmThread()
 std::thread Alarm::TurnOnBlinkGreenAlarmThread()
 {
     return std::thread([=] {
+        I2cPriorityScope priorityScope(highPriority);
         TurnOnBlinkGreenAlarm();
     });
 }
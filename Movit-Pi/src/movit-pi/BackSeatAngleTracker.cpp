@@ -1,32 +1,24 @@
 #include "BackSeatAngleTracker.h"
-#include "FixedImu.h"
-#include "MobileImu.h"
 #include "Utils.h"
 #include <math.h>
 
-BackSeatAngleTracker::BackSeatAngleTracker(): _angle(10)
+BackSeatAngleTracker::BackSeatAngleTracker()
 {
 }
 
-bool BackSeatAngleTracker::IsInclined()
+bool BackSeatAngleTracker::IsInclined(ImuFrame &fixedFrame)
 {
-    FixedImu *fixedImu = FixedImu::GetInstance();
-    double pitch = fixedImu->GetPitch();
-    double roll = fixedImu->GetRoll();
+    double pitch = fixedFrame.GetPitch();
+    double roll = fixedFrame.GetRoll();
 
     return pitch > ALLOWED_INCLINATION_ANGLE || pitch < ALLOWED_INCLINATION_ANGLE * -1
         || roll > ALLOWED_INCLINATION_ANGLE || roll < ALLOWED_INCLINATION_ANGLE * -1;
 }
 
-int BackSeatAngleTracker::GetBackSeatAngle()
+float BackSeatAngleTracker::GetBackSeatAngle(ImuFrame &fixedFrame, ImuFrame &mobileFrame)
 {
-    MobileImu *mobileImu = MobileImu::GetInstance();
-    FixedImu *fixedImu = FixedImu::GetInstance();
+    double fixedPitch = fixedFrame.GetPitch();
+    double mobilePitch = mobileFrame.GetPitch();
 
-    double fixedPitch = mobileImu->GetPitch();
-    double mobilePitch = fixedImu->GetPitch();
-
-    _angle.AddSample(static_cast<int>(fixedPitch - mobilePitch));
-
-    return _angle.GetAverage();
+    return static_cast<float>(mobilePitch - fixedPitch);
 }
@@ -1,7 +1,7 @@
 #ifndef BACK_SEAT_ANGLE_TRACKER_H
 #define BACK_SEAT_ANGLE_TRACKER_H
 
-#include "MovingAverage.h"
+#include "ImuFrame.h"
 
 #define NUMBER_OF_AXIS 3
 #define ALLOWED_INCLINATION_ANGLE 10
@@ -10,11 +10,11 @@ class BackSeatAngleTracker
 {
 public:
   BackSeatAngleTracker();
-  bool IsInclined();
-  int GetBackSeatAngle();
-
-private:
-  MovingAverage<int> _angle;
+  // Both frames must come from the same tick
+  bool IsInclined(ImuFrame &fixedFrame);
+  // Angle between the seat and the backrest, in degrees. Not averaged, the
+  // frames already come from the fusion of the full rate samples.
+  float GetBackSeatAngle(ImuFrame &fixedFrame, ImuFrame &mobileFrame);
 };
 
 #endif // BACK_SEAT_ANGLE_TRACKER_H
@@ -0,0 +1,65 @@
+#include "Bcm2835I2cBackend.h"
+#include "bcm2835.h"
+
+Bcm2835I2cBackend::Bcm2835I2cBackend(uint32_t baudrate) : _baudrate(baudrate)
+{
+}
+
+bool Bcm2835I2cBackend::Open()
+{
+    bcm2835_i2c_set_baudrate(_baudrate);
+    _isSlaveAddressValid = false;
+    return true;
+}
+
+void Bcm2835I2cBackend::Close()
+{
+    _isSlaveAddressValid = false;
+}
+
+void Bcm2835I2cBackend::SetSlaveAddress(uint8_t devAddr)
+{
+    if (!_isSlaveAddressValid || _slaveAddress != devAddr)
+    {
+        bcm2835_i2c_setSlaveAddress(devAddr);
+        _slaveAddress = devAddr;
+        _isSlaveAddressValid = true;
+    }
+}
+
+bool Bcm2835I2cBackend::Transfer(i2c_segment_t *segments, uint8_t count)
+{
+    uint8_t i = 0;
+    while (i < count)
+    {
+        i2c_segment_t &segment = segments[i];
+        uint8_t response;
+
+        SetSlaveAddress(segment.devAddr);
+
+        if (!segment.isRead && (i + 1) < count && segments[i + 1].isRead && segments[i + 1].devAddr == segment.devAddr)
+        {
+            // Register pointer write followed by a read: keep the repeated start
+            i2c_segment_t &next = segments[i + 1];
+            response = bcm2835_i2c_write_read_rs(reinterpret_cast<char *>(segment.data), segment.length,
+                                                 reinterpret_cast<char *>(next.data), next.length);
+            i += 2;
+        }
+        else if (segment.isRead)
+        {
+            response = bcm2835_i2c_read(reinterpret_cast<char *>(segment.data), segment.length);
+            i++;
+        }
+        else
+        {
+            response = bcm2835_i2c_write(reinterpret_cast<const char *>(segment.data), segment.length);
+            i++;
+        }
+
+        if (response != BCM2835_I2C_REASON_OK)
+        {
+            return false;
+        }
+    }
+    return true;
+}
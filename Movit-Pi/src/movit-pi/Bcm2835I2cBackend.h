@@ -0,0 +1,26 @@
+#ifndef BCM2835_I2C_BACKEND_H
+#define BCM2835_I2C_BACKEND_H
+
+#include "I2cBackend.h"
+
+// I2C through the bcm2835 library (direct access to the BSC1 peripheral).
+// The BSC controller only knows write, read and write-then-read with a repeated
+// start, so a transfer is split in as many of those as needed.
+class Bcm2835I2cBackend : public I2cBackend
+{
+  public:
+    Bcm2835I2cBackend(uint32_t baudrate);
+
+    bool Open();
+    void Close();
+    bool Transfer(i2c_segment_t *segments, uint8_t count);
+
+  private:
+    void SetSlaveAddress(uint8_t devAddr);
+
+    uint32_t _baudrate;
+    bool _isSlaveAddressValid = false;
+    uint8_t _slaveAddress = 0;
+};
+
+#endif // BCM2835_I2C_BACKEND_H
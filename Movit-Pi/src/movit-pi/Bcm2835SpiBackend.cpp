@@ -0,0 +1,37 @@
+#include "Bcm2835SpiBackend.h"
+#include "bcm2835.h"
+
+bool Bcm2835SpiBackend::Open()
+{
+    return true;
+}
+
+void Bcm2835SpiBackend::Close()
+{
+    bcm2835_close();
+}
+
+void Bcm2835SpiBackend::SetupChipSelect(uint8_t pin)
+{
+    bcm2835_gpio_fsel(pin, BCM2835_GPIO_FSEL_OUTP);
+    bcm2835_gpio_write(pin, HIGH);
+}
+
+void Bcm2835SpiBackend::Select(uint8_t pin)
+{
+    bcm2835_spi_begin();
+    bcm2835_spi_setDataMode(BCM2835_SPI_MODE0);
+    bcm2835_spi_setClockDivider(BCM2835_SPI_CLOCK_DIVIDER_256);
+    bcm2835_gpio_write(pin, LOW);
+}
+
+void Bcm2835SpiBackend::Deselect(uint8_t pin)
+{
+    bcm2835_gpio_write(pin, HIGH);
+    bcm2835_spi_end();
+}
+
+uint8_t Bcm2835SpiBackend::Transfer(uint8_t data)
+{
+    return bcm2835_spi_transfer(data);
+}
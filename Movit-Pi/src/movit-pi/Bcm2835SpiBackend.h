@@ -0,0 +1,19 @@
+#ifndef BCM2835_SPI_BACKEND_H
+#define BCM2835_SPI_BACKEND_H
+
+#include "SpiBackend.h"
+
+// SPI0 through the bcm2835 library, mode 0, with the chip select on a GPIO.
+class Bcm2835SpiBackend : public SpiBackend
+{
+  public:
+    bool Open();
+    void Close();
+
+    void SetupChipSelect(uint8_t pin);
+    void Select(uint8_t pin);
+    void Deselect(uint8_t pin);
+    uint8_t Transfer(uint8_t data);
+};
+
+#endif // BCM2835_SPI_BACKEND_H
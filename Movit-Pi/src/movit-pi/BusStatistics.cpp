@@ -0,0 +1,124 @@
+#include "BusStatistics.h"
+#include <stdio.h>
+
+static uint8_t GetBucket(uint32_t microseconds)
+{
+    if (microseconds < 2)
+    {
+        return 0;
+    }
+    uint8_t bucket = 31 - __builtin_clz(microseconds);
+    return bucket < BUS_LATENCY_BUCKETS ? bucket : BUS_LATENCY_BUCKETS - 1;
+}
+
+void BusStatistics::Record(uint8_t channel, uint8_t address, BusOperation operation, uint32_t microseconds, bool isSuccessful)
+{
+    if (channel >= BUS_CHANNEL_COUNT || address >= BUS_ADDRESS_COUNT || operation >= busOperationCount)
+    {
+        return;
+    }
+
+    latency_histogram_t &histogram = _histograms[channel][address][operation];
+    histogram.count.fetch_add(1, std::memory_order_relaxed);
+    histogram.totalMicroseconds.fetch_add(microseconds, std::memory_order_relaxed);
+    histogram.buckets[GetBucket(microseconds)].fetch_add(1, std::memory_order_relaxed);
+    if (!isSuccessful)
+    {
+        histogram.errors.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    uint32_t maxMicroseconds = histogram.maxMicroseconds.load(std::memory_order_relaxed);
+    while (microseconds > maxMicroseconds && !histogram.maxMicroseconds.compare_exchange_weak(maxMicroseconds, microseconds, std::memory_order_relaxed))
+    {
+    }
+}
+
+// The counters of a device are read one by one while the bus threads keep
+// updating them, so a snapshot can be off by the transactions in progress.
+std::vector<bus_statistics_t> BusStatistics::GetStatistics()
+{
+    std::vector<bus_statistics_t> statistics;
+    for (uint8_t channel = 0; channel < BUS_CHANNEL_COUNT; channel++)
+    {
+        for (uint8_t address = 0; address < BUS_ADDRESS_COUNT; address++)
+        {
+            for (uint8_t operation = 0; operation < busOperationCount; operation++)
+            {
+                latency_histogram_t &histogram = _histograms[channel][address][operation];
+                uint32_t count = histogram.count.load(std::memory_order_relaxed);
+                if (count == 0)
+                {
+                    continue;
+                }
+
+                bus_statistics_t device;
+                device.channel = channel;
+                device.address = address;
+                device.operation = static_cast<BusOperation>(operation);
+                device.count = count;
+                device.errors = histogram.errors.load(std::memory_order_relaxed);
+                device.averageMicroseconds = static_cast<uint32_t>(histogram.totalMicroseconds.load(std::memory_order_relaxed) / count);
+                device.maxMicroseconds = histogram.maxMicroseconds.load(std::memory_order_relaxed);
+                for (uint8_t bucket = 0; bucket < BUS_LATENCY_BUCKETS; bucket++)
+                {
+                    device.buckets[bucket] = histogram.buckets[bucket].load(std::memory_order_relaxed);
+                }
+                statistics.push_back(device);
+            }
+        }
+    }
+    return statistics;
+}
+
+void BusStatistics::Print()
+{
+    printf("Bus latency statistics:\n");
+    for (const bus_statistics_t &device : GetStatistics())
+    {
+        printf("%s 0x%02X %s: %u transactions, %u errors, average %u us, max %u us\n",
+               GetChannelName(device.channel).c_str(), device.address, GetOperationName(device.operation).c_str(),
+               device.count, device.errors, device.averageMicroseconds, device.maxMicroseconds);
+
+        for (uint8_t bucket = 0; bucket < BUS_LATENCY_BUCKETS; bucket++)
+        {
+            if (device.buckets[bucket] != 0)
+            {
+                printf("    %-14s %u\n", GetBucketName(bucket).c_str(), device.buckets[bucket]);
+            }
+        }
+    }
+}
+
+std::string BusStatistics::GetChannelName(uint8_t channel)
+{
+    if (channel == BUS_SPI_CHANNEL)
+    {
+        return "spi";
+    }
+    return "i2c" + std::to_string(channel);
+}
+
+std::string BusStatistics::GetOperationName(BusOperation operation)
+{
+    switch (operation)
+    {
+    case busRead:
+        return "read";
+    case busWrite:
+        return "write";
+    case busTransfer:
+        return "transfer";
+    default:
+        return "unknown";
+    }
+}
+
+std::string BusStatistics::GetBucketName(uint8_t bucket)
+{
+    uint32_t low = bucket == 0 ? 0 : 1u << bucket;
+    if (bucket == BUS_LATENCY_BUCKETS - 1)
+    {
+        return ">= " + std::to_string(low) + " us";
+    }
+    return std::to_string(low) + "-" + std::to_string(1u << (bucket + 1)) + " us";
+}
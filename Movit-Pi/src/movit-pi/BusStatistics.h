@@ -0,0 +1,80 @@
+#ifndef BUS_STATISTICS_H
+#define BUS_STATISTICS_H
+
+#include "I2Cdev.h"
+#include <atomic>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+// Bucket i counts the transactions that took from 2^i to 2^(i+1) microseconds,
+// the first bucket starts at 0 and the last one has no upper bound (>= 32 ms)
+#define BUS_LATENCY_BUCKETS 16
+#define BUS_ADDRESS_COUNT 128
+
+// Channels 0 to busCount - 1 are the I2C buses, the last one is the SPI bus,
+// where the address is the chip select pin
+#define BUS_SPI_CHANNEL busCount
+#define BUS_CHANNEL_COUNT (busCount + 1)
+
+enum BusOperation
+{
+    busRead = 0, // I2C transaction with a read segment
+    busWrite,    // I2C transaction with only write segments
+    busTransfer, // SPI transaction, from chip select to deselect
+    busOperationCount
+};
+
+struct bus_statistics_t
+{
+    uint8_t channel;
+    uint8_t address;
+    BusOperation operation;
+    uint32_t count;
+    uint32_t errors; // NACKs and other failed transactions
+    uint32_t averageMicroseconds;
+    uint32_t maxMicroseconds;
+    uint32_t buckets[BUS_LATENCY_BUCKETS];
+};
+
+// Latency histograms and error counts of every device, since the start of the
+// program. The counters are atomics updated without any lock, so the bus
+// threads never wait on a reader.
+class BusStatistics
+{
+  public:
+    static BusStatistics *GetInstance()
+    {
+        static BusStatistics instance;
+        return &instance;
+    }
+
+    void Record(uint8_t channel, uint8_t address, BusOperation operation, uint32_t microseconds, bool isSuccessful);
+
+    // Devices with at least one transaction
+    std::vector<bus_statistics_t> GetStatistics();
+    void Print();
+
+    static std::string GetChannelName(uint8_t channel);
+    static std::string GetOperationName(BusOperation operation);
+    static std::string GetBucketName(uint8_t bucket);
+
+  private:
+    BusStatistics() = default;
+    BusStatistics(const BusStatistics &) = delete;
+    BusStatistics &operator=(const BusStatistics &) = delete;
+
+    struct latency_histogram_t
+    {
+        std::atomic<uint32_t> count;
+        std::atomic<uint32_t> errors;
+        std::atomic<uint64_t> totalMicroseconds;
+        std::atomic<uint32_t> maxMicroseconds;
+        std::atomic<uint32_t> buckets[BUS_LATENCY_BUCKETS];
+    };
+
+    // Zero-initialized with the static instance
+    latency_histogram_t _histograms[BUS_CHANNEL_COUNT][BUS_ADDRESS_COUNT][busOperationCount];
+};
+
+#endif // BUS_STATISTICS_H
@@ -0,0 +1,329 @@
+#include "CenterOfPressure.h"
+
+#include <chrono>
+#include <float.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#endif
+
+#define BENCHMARK_FRAME_COUNT 256
+#define BENCHMARK_SENSOR_PASSES 2000000 // Sensors computed per size, divided in frames
+
+namespace
+{
+// Keeps the compiler from dropping the benchmarked computations
+volatile double benchmarkSink = 0;
+
+typedef float float4_t __attribute__((vector_size(16)));
+
+// Center of the whole mat from the sums over the lanes
+Coord_t GetGlobalCenter(float fz, float sumX, float sumY, const force_plate_geometry_t &geometry)
+{
+    if (fz == 0)
+    {
+        return {0.0f, 0.0f};
+    }
+    return {sumX / fz + geometry.distZ0, sumY / fz + geometry.distZ0};
+}
+
+void ResizeResult(const pressure_mat_layout_t &layout, center_of_pressure_t &result)
+{
+    result.plates.resize(layout.laneCount);
+    result.loads.resize(layout.laneCount);
+}
+} // namespace
+
+void CreatePressureMatLayout(uint8_t rows, uint8_t columns, const force_plate_geometry_t &geometry, pressure_mat_layout_t &layout)
+{
+    layout.rows = rows;
+    layout.columns = columns;
+    layout.plateCount = (rows - 1) * (columns - 1);
+    layout.laneCount = (layout.plateCount + FORCE_PLATE_LANE_COUNT - 1) / FORCE_PLATE_LANE_COUNT * FORCE_PLATE_LANE_COUNT;
+    layout.geometry = geometry;
+
+    for (uint8_t corner = 0; corner < FORCE_PLATE_CORNER_COUNT; corner++)
+    {
+        layout.sensors[corner].assign(layout.laneCount, 0);
+    }
+    layout.positionX.assign(layout.laneCount, 0);
+    layout.positionY.assign(layout.laneCount, 0);
+
+    // Sensor of the row and the column, in the logical order
+    auto sensor = [rows](uint8_t row, uint8_t column) { return static_cast<uint16_t>(column * rows + row); };
+
+    for (uint8_t row = 0; row + 1 < rows; row++)
+    {
+        for (uint8_t column = 0; column + 1 < columns; column++)
+        {
+            const uint16_t plate = row * (columns - 1) + column;
+            layout.sensors[0][plate] = sensor(row + 1, column + 1);
+            layout.sensors[1][plate] = sensor(row + 1, column);
+            layout.sensors[2][plate] = sensor(row, column);
+            layout.sensors[3][plate] = sensor(row, column + 1);
+
+            // The sensors are 2 * distX apart, the mat centered on 0 and its
+            // front towards y
+            layout.positionX[plate] = (2 * column + 2 - columns) * geometry.distX;
+            layout.positionY[plate] = (rows - 2 - 2 * row) * geometry.distY;
+        }
+    }
+}
+
+void FillPressureFrame(const pressure_mat_layout_t &layout, const uint16_t *sensors, pressure_frame_t &frame)
+{
+    for (uint8_t corner = 0; corner < FORCE_PLATE_CORNER_COUNT; corner++)
+    {
+        std::vector<float> &loads = frame.corners[corner];
+        loads.resize(layout.laneCount);
+        const uint16_t *plateSensors = layout.sensors[corner].data();
+        for (uint16_t plate = 0; plate < layout.plateCount; plate++)
+        {
+            loads[plate] = static_cast<float>(sensors[plateSensors[plate]]);
+        }
+        for (uint16_t lane = layout.plateCount; lane < layout.laneCount; lane++)
+        {
+            loads[lane] = 0;
+        }
+    }
+}
+
+void ComputeCenterOfPressureReference(const pressure_mat_layout_t &layout, const pressure_frame_t &frame, center_of_pressure_t &result)
+{
+    const force_plate_geometry_t &geometry = layout.geometry;
+    ResizeResult(layout, result);
+
+    float globalFx = 0, globalFy = 0, globalFz = 0, globalMx = 0, globalMy = 0;
+    for (uint16_t plate = 0; plate < layout.laneCount; plate++)
+    {
+        const float fz1 = frame.corners[0][plate];
+        const float fz2 = frame.corners[1][plate];
+        const float fz3 = frame.corners[2][plate];
+        const float fz4 = frame.corners[3][plate];
+
+        // The plates themselves get no height correction, only the whole mat
+        const float fx = (fz1 + fz2) + (fz3 + fz4);
+        const float fy = (fz1 + fz4) + (fz2 + fz3);
+        const float fz = fz1 + fz2 + fz3 + fz4;
+        const float mx = -geometry.distY * (fz1 + fz2 - fz3 - fz4);
+        const float my = geometry.distX * (-fz1 + fz2 + fz3 - fz4);
+
+        Coord_t &center = result.plates[plate];
+        center = fz != 0 ? Coord_t{-my / fz, mx / fz} : Coord_t{0.0f, 0.0f};
+        result.loads[plate] = fz;
+
+        globalFx += fx;
+        globalFy += fy;
+        globalFz += fz;
+        globalMx += (layout.positionY[plate] + center.y) * fz;
+        globalMy -= (layout.positionX[plate] + center.x) * fz;
+    }
+
+    const float globalMx1 = globalMx + geometry.distZ0 * globalFy;
+    const float globalMy1 = globalMy - geometry.distZ0 * globalFx;
+    result.global = globalFz != 0 ? Coord_t{-globalMy1 / globalFz, globalMx1 / globalFz} : Coord_t{0.0f, 0.0f};
+    result.load = globalFz;
+}
+
+// The plate formulae come down to, for each lane:
+//     x = distX * (fz1 - fz2 - fz3 + fz4) / fz
+//     y = -distY * (fz1 + fz2 - fz3 - fz4) / fz
+// and the moments of the mat to sums of the numerators.
+void ComputeCenterOfPressureVector(const pressure_mat_layout_t &layout, const pressure_frame_t &frame, center_of_pressure_t &result)
+{
+    const force_plate_geometry_t &geometry = layout.geometry;
+    ResizeResult(layout, result);
+
+    float4_t globalFz = {0, 0, 0, 0};
+    float4_t globalX = globalFz;
+    float4_t globalY = globalFz;
+    for (uint16_t lane = 0; lane < layout.laneCount; lane += FORCE_PLATE_LANE_COUNT)
+    {
+        float4_t dax, day, c1, c2, c3, c4;
+        memcpy(&dax, &layout.positionX[lane], sizeof(dax));
+        memcpy(&day, &layout.positionY[lane], sizeof(day));
+        memcpy(&c1, &frame.corners[0][lane], sizeof(c1));
+        memcpy(&c2, &frame.corners[1][lane], sizeof(c2));
+        memcpy(&c3, &frame.corners[2][lane], sizeof(c3));
+        memcpy(&c4, &frame.corners[3][lane], sizeof(c4));
+
+        const float4_t sum12 = c1 + c2;
+        const float4_t sum34 = c3 + c4;
+        const float4_t fz = sum12 + sum34;
+        const float4_t momentX = (c1 - c2) + (c4 - c3);
+        const float4_t momentY = sum12 - sum34;
+
+        // FLT_MIN keeps an unloaded plate at 0 without a branch: all its
+        // corners are 0, the moments as well
+        const float4_t inverseFz = 1 / (fz + FLT_MIN);
+        const float4_t x = geometry.distX * momentX * inverseFz;
+        const float4_t y = -geometry.distY * momentY * inverseFz;
+        for (uint8_t i = 0; i < FORCE_PLATE_LANE_COUNT; i++)
+        {
+            result.plates[lane + i] = {x[i], y[i]};
+        }
+        memcpy(&result.loads[lane], &fz, sizeof(fz));
+
+        globalFz += fz;
+        globalX += dax * fz + geometry.distX * momentX;
+        globalY += day * fz - geometry.distY * momentY;
+    }
+
+    result.load = (globalFz[0] + globalFz[1]) + (globalFz[2] + globalFz[3]);
+    result.global = GetGlobalCenter(result.load,
+                                    (globalX[0] + globalX[1]) + (globalX[2] + globalX[3]),
+                                    (globalY[0] + globalY[1]) + (globalY[2] + globalY[3]), geometry);
+}
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+namespace
+{
+static_assert(sizeof(Coord_t) == 2 * sizeof(float), "The NEON version stores the centers as pairs of floats");
+
+float HorizontalSum(float32x4_t value)
+{
+    const float32x2_t half = vadd_f32(vget_low_f32(value), vget_high_f32(value));
+    return vget_lane_f32(vpadd_f32(half, half), 0);
+}
+} // namespace
+
+// Same steps as the vector version
+void ComputeCenterOfPressureNeon(const pressure_mat_layout_t &layout, const pressure_frame_t &frame, center_of_pressure_t &result)
+{
+    const force_plate_geometry_t &geometry = layout.geometry;
+    ResizeResult(layout, result);
+
+    float32x4_t globalFz = vdupq_n_f32(0);
+    float32x4_t globalX = globalFz;
+    float32x4_t globalY = globalFz;
+    for (uint16_t lane = 0; lane < layout.laneCount; lane += FORCE_PLATE_LANE_COUNT)
+    {
+        const float32x4_t dax = vld1q_f32(&layout.positionX[lane]);
+        const float32x4_t day = vld1q_f32(&layout.positionY[lane]);
+        const float32x4_t c1 = vld1q_f32(&frame.corners[0][lane]);
+        const float32x4_t c2 = vld1q_f32(&frame.corners[1][lane]);
+        const float32x4_t c3 = vld1q_f32(&frame.corners[2][lane]);
+        const float32x4_t c4 = vld1q_f32(&frame.corners[3][lane]);
+
+        const float32x4_t sum12 = vaddq_f32(c1, c2);
+        const float32x4_t sum34 = vaddq_f32(c3, c4);
+        const float32x4_t fz = vaddq_f32(sum12, sum34);
+        const float32x4_t momentX = vaddq_f32(vsubq_f32(c1, c2), vsubq_f32(c4, c3));
+        const float32x4_t momentY = vsubq_f32(sum12, sum34);
+
+        const float32x4_t safeFz = vaddq_f32(fz, vdupq_n_f32(FLT_MIN));
+#ifdef __aarch64__
+        const float32x4_t inverseFz = vdivq_f32(vdupq_n_f32(1), safeFz);
+#else
+        // ARMv7 has no vector division: estimate refined by two Newton steps
+        float32x4_t inverseFz = vrecpeq_f32(safeFz);
+        inverseFz = vmulq_f32(vrecpsq_f32(safeFz, inverseFz), inverseFz);
+        inverseFz = vmulq_f32(vrecpsq_f32(safeFz, inverseFz), inverseFz);
+#endif
+
+        // Coord_t is x then y, the lanes are stored interleaved
+        float32x4x2_t center;
+        center.val[0] = vmulq_f32(vmulq_n_f32(momentX, geometry.distX), inverseFz);
+        center.val[1] = vmulq_f32(vmulq_n_f32(momentY, -geometry.distY), inverseFz);
+        vst2q_f32(&result.plates[lane].x, center);
+        vst1q_f32(&result.loads[lane], fz);
+
+        globalFz = vaddq_f32(globalFz, fz);
+        globalX = vaddq_f32(globalX, vmlaq_n_f32(vmulq_f32(dax, fz), momentX, geometry.distX));
+        globalY = vaddq_f32(globalY, vmlsq_n_f32(vmulq_f32(day, fz), momentY, geometry.distY));
+    }
+
+    result.load = HorizontalSum(globalFz);
+    result.global = GetGlobalCenter(result.load, HorizontalSum(globalX), HorizontalSum(globalY), geometry);
+}
+#endif
+
+void BenchmarkCenterOfPressure()
+{
+    typedef void (*kernel_t)(const pressure_mat_layout_t &, const pressure_frame_t &, center_of_pressure_t &);
+    struct
+    {
+        const char *name;
+        kernel_t kernel;
+    } kernels[] = {
+        {"reference", ComputeCenterOfPressureReference},
+        {"vector", ComputeCenterOfPressureVector},
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+        {"neon", ComputeCenterOfPressureNeon},
+#endif
+    };
+
+    const force_plate_geometry_t geometry = {2.0f, 2.0f, 0.001f};
+    const uint8_t sizes[] = {PRESSURE_MAT_DEFAULT_SIZE, 8, PRESSURE_MAT_MAX_SIZE};
+    for (uint8_t size : sizes)
+    {
+        pressure_mat_layout_t layout;
+        CreatePressureMatLayout(size, size, geometry, layout);
+        const uint16_t sensorCount = size * size;
+        const uint32_t passCount = BENCHMARK_SENSOR_PASSES / (sensorCount * BENCHMARK_FRAME_COUNT) + 1;
+
+        // Loads of the 10 bits ADC, about half of the sensors unloaded so
+        // some plates are empty
+        std::vector<uint16_t> sensors(BENCHMARK_FRAME_COUNT * sensorCount);
+        std::vector<pressure_frame_t> frames(BENCHMARK_FRAME_COUNT);
+        srand(1);
+        for (uint16_t i = 0; i < BENCHMARK_FRAME_COUNT; i++)
+        {
+            for (uint16_t j = 0; j < sensorCount; j++)
+            {
+                sensors[i * sensorCount + j] = rand() % 2 ? rand() % 1024 : 0;
+            }
+            FillPressureFrame(layout, &sensors[i * sensorCount], frames[i]);
+        }
+
+        for (const auto &kernel : kernels)
+        {
+            center_of_pressure_t reference, result;
+            double error = 0;
+            for (uint16_t i = 0; i < BENCHMARK_FRAME_COUNT; i++)
+            {
+                ComputeCenterOfPressureReference(layout, frames[i], reference);
+                kernel.kernel(layout, frames[i], result);
+                for (uint16_t plate = 0; plate < layout.plateCount; plate++)
+                {
+                    error = fmax(error, fabs(result.plates[plate].x - reference.plates[plate].x));
+                    error = fmax(error, fabs(result.plates[plate].y - reference.plates[plate].y));
+                }
+                error = fmax(error, fabs(result.global.x - reference.global.x));
+                error = fmax(error, fabs(result.global.y - reference.global.y));
+            }
+
+            double sum = 0;
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            for (uint32_t pass = 0; pass < passCount; pass++)
+            {
+                for (uint16_t i = 0; i < BENCHMARK_FRAME_COUNT; i++)
+                {
+                    kernel.kernel(layout, frames[i], result);
+                    sum += result.global.x + result.plates[0].y;
+                }
+            }
+            const double elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / (passCount * BENCHMARK_FRAME_COUNT);
+            benchmarkSink = sum;
+            printf("center of pressure %2ix%-2i %-10s %8.1f ns/frame, %5.2f ns/sensor, error %.2g\n", size, size, kernel.name, elapsed, elapsed / sensorCount, error);
+        }
+
+        double sum = 0;
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for (uint32_t pass = 0; pass < passCount; pass++)
+        {
+            for (uint16_t i = 0; i < BENCHMARK_FRAME_COUNT; i++)
+            {
+                FillPressureFrame(layout, &sensors[i * sensorCount], frames[i]);
+                sum += frames[i].corners[0][pass % layout.plateCount];
+            }
+        }
+        const double elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / (passCount * BENCHMARK_FRAME_COUNT);
+        benchmarkSink = sum;
+        printf("pressure frame fill %2ix%-2i           %8.1f ns/frame, %5.2f ns/sensor\n", size, size, elapsed, elapsed / sensorCount);
+    }
+}
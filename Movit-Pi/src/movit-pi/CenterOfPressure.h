@@ -0,0 +1,87 @@
+#ifndef CENTER_OF_PRESSURE_H
+#define CENTER_OF_PRESSURE_H
+
+#include "DataType.h"
+
+#include <stdint.h>
+#include <vector>
+
+// Center of pressure of the mat from the Kistler force plate formulae. Each
+// 2x2 block of neighbouring sensors is a force plate, the plates overlap: a
+// mat of rows x columns sensors has (rows - 1) x (columns - 1) plates, row by
+// row from the front left one. On the 3x3 mat, they are the 4 quadrants.
+//
+//     FRONT LEFT         FRONT RIGHT       Corners of a plate, y
+//     Plate0   Plate1    ...               Corner3  Corner4    |
+//     ...                                  Corner2  Corner1    |------->x
+//
+// The frame holds the sensors corner by corner with a lane per plate, a
+// structure of arrays: the plates are computed 4 at a time in the lanes of a
+// 4 float vector, and the whole mat in one pass linear in the sensor count.
+
+#define FORCE_PLATE_CORNER_COUNT 4
+#define FORCE_PLATE_LANE_COUNT 4 // Plates in a vector
+
+struct force_plate_geometry_t
+{
+    float distX;  // Half of the distance between two columns of sensors
+    float distY;  // Half of the distance between two rows of sensors
+    float distZ0; // Half of the plate height
+};
+
+// The plates of a mat, built once from its size
+struct pressure_mat_layout_t
+{
+    uint8_t rows = 0;
+    uint8_t columns = 0;
+    uint16_t plateCount = 0;
+    uint16_t laneCount = 0;                                  // plateCount rounded up to whole vectors
+    std::vector<uint16_t> sensors[FORCE_PLATE_CORNER_COUNT]; // Logical sensor at each corner of each plate
+    std::vector<float> positionX;                            // Center of each plate in the mat, 0 in the
+    std::vector<float> positionY;                            // lanes past the plates
+    force_plate_geometry_t geometry;
+};
+
+struct pressure_frame_t
+{
+    std::vector<float> corners[FORCE_PLATE_CORNER_COUNT]; // Non-negative loads, laneCount each
+};
+
+// laneCount plates, the lanes past the plates at 0
+struct center_of_pressure_t
+{
+    std::vector<Coord_t> plates; // In the frame of each plate
+    std::vector<float> loads;    // Vertical force on each plate
+    Coord_t global;              // In the frame of the mat
+    float load;                  // Of all the plates, the inner sensors count more than once
+};
+
+void CreatePressureMatLayout(uint8_t rows, uint8_t columns, const force_plate_geometry_t &geometry, pressure_mat_layout_t &layout);
+
+// The sensors of the mat, in the logical order, to the corners of the frame
+void FillPressureFrame(const pressure_mat_layout_t &layout, const uint16_t *sensors, pressure_frame_t &frame);
+
+// An unloaded plate, or mat, has its center at 0. The reference follows the
+// plate formulae one plate at a time. The vector versions use their
+// simplified form: the FSRs only measure vertical forces, and the plate
+// formulae take the sums of the sensors as the horizontal forces too.
+void ComputeCenterOfPressureReference(const pressure_mat_layout_t &layout, const pressure_frame_t &frame, center_of_pressure_t &result);
+void ComputeCenterOfPressureVector(const pressure_mat_layout_t &layout, const pressure_frame_t &frame, center_of_pressure_t &result);
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+void ComputeCenterOfPressureNeon(const pressure_mat_layout_t &layout, const pressure_frame_t &frame, center_of_pressure_t &result);
+#endif
+
+inline void ComputeCenterOfPressure(const pressure_mat_layout_t &layout, const pressure_frame_t &frame, center_of_pressure_t &result)
+{
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+    ComputeCenterOfPressureNeon(layout, frame, result);
+#else
+    ComputeCenterOfPressureVector(layout, frame, result);
+#endif
+}
+
+// Prints the cost per frame of each version on mats of several sizes, and the
+// error of the vector ones
+void BenchmarkCenterOfPressure();
+
+#endif // CENTER_OF_PRESSURE_H
@@ -2,13 +2,14 @@
 #include <chrono>
 #include "NetworkManager.h"
 #include "SysTime.h"
+#include "I2cScheduler.h"
 
 #define REQUIRED_SITTING_TIME 5
 #define DELTA_ANGLE_THRESHOLD 5
 
 #define CHECK_SENSORS_STATE_PERIOD 20
-#define VIBRATION_EMISSION_FREQUENCY 60 // Hz
-#define VIBRATION_EMISSION_THRESOLD 2   // m/s^2
+#define VIBRATION_READ_PERIOD 250      // Milliseconds, the sample ring holds 1 s at 1 kHz
+#define VIBRATION_SUMMARY_PERIOD 1000  // Milliseconds between two summaries
 
 using std::chrono::duration_cast;
 using std::chrono::milliseconds;
@@ -74,6 +75,7 @@ void ChairManager::UpdateDevices()
         _deviceManager->CalibrateIMU();
         _isIMUCalibrationChanged = true;
     }
+    SendImuCalibrationProgress();
     if (_deviceManager->IsImuCalibrated() && _isIMUCalibrationChanged)
     {
         _mosquittoBroker->SendIsIMUCalib(true, _currentDatetime);
@@ -83,7 +85,7 @@ void ChairManager::UpdateDevices()
     _prevIsSomeoneThere = _isSomeoneThere;
     _isSomeoneThere = _deviceManager->IsSomeoneThere();
     _prevChairAngle = _currentChairAngle;
-    _currentChairAngle = _deviceManager->GetBackSeatAngle();
+    _currentChairAngle = static_cast<int>(lround(_deviceManager->GetBackSeatAngle()));
     bool prevIsMoving = _isMoving;
     _isMoving = _deviceManager->IsMoving();
     _isChairInclined = _deviceManager->IsChairInclined();
@@ -146,16 +148,68 @@ void ChairManager::UpdateDevices()
     _mosquittoBroker->SendSensorsState(_deviceManager->GetSensorState(), _currentDatetime);
 }
 
+// Sent at each change of sensor or pass, and every second in between
+void ChairManager::SendImuCalibrationProgress()
+{
+    std::string imuName;
+    imu_calibration_progress_t progress;
+    if (!_deviceManager->GetImuCalibrationProgress(imuName, progress))
+    {
+        return;
+    }
+
+    if (progress.state != _imuCalibrationProgress.state || progress.pass != _imuCalibrationProgress.pass ||
+        _imuCalibrationTimer.Elapsed() >= IMU_CALIBRATION_EMISSION_PERIOD.count())
+    {
+        _imuCalibrationTimer.Reset();
+        _mosquittoBroker->SendImuCalibrationProgress(imuName, progress, Imu::GetCalibrationStateName(progress.state), _currentDatetime);
+    }
+    _imuCalibrationProgress = progress;
+
+    if (progress.state == calibrationFailed && _isIMUCalibrationChanged)
+    {
+        _mosquittoBroker->SendIsIMUCalib(false, _currentDatetime);
+        _isIMUCalibrationChanged = false;
+    }
+}
+
+// Follows every sample of the fixed IMU, whatever the rate of the main loop,
+// and publishes one summary per second, never the samples themselves
 void ChairManager::ReadVibrations()
 {
+    FixedImu *fixedImu = _deviceManager->GetFixedImu();
+    ImuSampleRing::Cursor cursor = fixedImu->GetSampleCursor();
+    std::vector<imu_sample_t> samples;
+    VibrationAnalyzer analyzer;
+    Timer summaryTimer;
+
     while (_isVibrationsActivated)
     {
-        double acceleration = _deviceManager->GetXAcceleration();
-        if (acceleration > VIBRATION_EMISSION_THRESOLD || acceleration < -VIBRATION_EMISSION_THRESOLD)
+        sleep_for_milliseconds(VIBRATION_READ_PERIOD);
+
+        // The windows can't span a gap, or a change of rate
+        samples.clear();
+        const uint16_t sampleRate = fixedImu->GetSampleRate();
+        if (fixedImu->ReadSamples(cursor, samples) > 0 || sampleRate != analyzer.GetSampleRate())
+        {
+            analyzer.Reset(sampleRate);
+        }
+
+        // Along the seat, where the gravity is -1 g when the chair is level
+        for (const imu_sample_t &sample : samples)
         {
-            _mosquittoBroker->SendVibration(acceleration, _currentDatetime);
+            analyzer.AddSample(static_cast<float>(sample.accelerations[AXIS::x] / ACCELEROMETER_SENSITIVITY * GRAVITY));
+        }
+
+        if (summaryTimer.Elapsed() >= VIBRATION_SUMMARY_PERIOD)
+        {
+            summaryTimer.Reset();
+            vibration_summary_t summary;
+            if (analyzer.GetSummary(summary))
+            {
+                _mosquittoBroker->SendVibration(summary, std::to_string(_deviceManager->GetTimeSinceEpoch()));
+            }
         }
-        sleep_for_milliseconds(SECONDS_TO_MILLISECONDS / VIBRATION_EMISSION_FREQUENCY);
     }
 }
 
@@ -166,9 +220,7 @@ void ChairManager::SetVibrationsActivated(bool isVibrationsActivated)
 
 std::thread ChairManager::ReadVibrationsThread()
 {
-    return std::thread([=] {
-        ReadVibrations();
-    });
+    return std::thread([=] { ReadVibrations(); });
 }
 
 void ChairManager::ReadFromServer()
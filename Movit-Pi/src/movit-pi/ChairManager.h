@@ -6,7 +6,9 @@
 #include "Timer.h"
 #include "DeviceManager.h"
 #include "SecondsCounter.h"
+#include "VibrationAnalyzer.h"
 
+#include <atomic>
 #include <string>
 #include <unistd.h>
 #include <chrono>
@@ -29,6 +31,7 @@ class ChairManager
     static constexpr auto CHAIR_ANGLE_EMISSION_PERIOD = std::chrono::milliseconds(1000);
     static constexpr auto WIFI_VALIDATION_PERIOD = std::chrono::seconds(10);
     static constexpr auto HEARTBEAT_PERIOD = std::chrono::milliseconds(1000);
+    static constexpr auto IMU_CALIBRATION_EMISSION_PERIOD = std::chrono::milliseconds(1000);
 
     static constexpr int MINIMUM_ANGLE = 15; // degrees
 
@@ -50,11 +53,13 @@ class ChairManager
     bool _isChairInclined = false;
     bool _isWifiChanged = false;
     bool _setAlarmOn = false;
-    bool _isVibrationsActivated = true;
+    std::atomic<bool> _isVibrationsActivated{true};
     bool _isIMUCalibrationChanged = false;
     bool _isPressureMatCalibrationChanged = false;
     bool _overrideNotification = false;
 
+    imu_calibration_progress_t _imuCalibrationProgress;
+
     pressure_mat_data_t _pressureMatData;
     tilt_settings_t _tiltSettings;
 
@@ -63,6 +68,7 @@ class ChairManager
     Timer _chairAngleTimer;
     Timer _heartbeatTimer;
     Timer _failedTiltTimer;
+    Timer _imuCalibrationTimer;
 
     void CheckIfUserHasBeenSittingForRequiredTime();
     void CheckIfBackRestIsRequired();
@@ -71,6 +77,7 @@ class ChairManager
     void CheckIfRequiredBackSeatAngleIsMaintained();
     void CheckIfBackSeatIsBackToInitialPosition();
     void OverrideNotification();
+    void SendImuCalibrationProgress();
     void ReadVibrations();
 };
 
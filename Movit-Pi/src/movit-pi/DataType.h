@@ -1,9 +1,21 @@
 #pragma once
 
 #include <stdint.h>
+#include <vector>
 
 #define NUMBER_OF_AXIS 3
-#define PRESSURE_SENSOR_COUNT 9
+
+// The sensors of the pressure mat are in the logical order: the columns from
+// left to right, each from front to back.
+#define PRESSURE_MAT_MIN_SIZE 2 // Rows or columns, one force plate
+#define PRESSURE_MAT_MAX_SIZE 16 // 22 MAX11611, 65 are addressable: 1 on the bus, 8 per TCA9548A
+#define PRESSURE_MAT_DEFAULT_SIZE 3
+#define DEFAULT_PRESSURE_SENSOR_COUNT (PRESSURE_MAT_DEFAULT_SIZE * PRESSURE_MAT_DEFAULT_SIZE)
+#define PRESSURE_MAT_ADC_ADDRESS 0x35 // MAX11611_DEFAULT_ADDRESS
+#define PRESSURE_MAT_MUX_ADDRESS 0x70 // TCA9548A_DEFAULT_ADDRESS
+
+// MAX11611 channel wired to each sensor of the default 3x3 mat
+constexpr uint8_t DEFAULT_PRESSURE_CHANNEL_MAP[DEFAULT_PRESSURE_SENSOR_COUNT] = {5, 7, 6, 2, 4, 3, 1, 0, 8};
 
 struct Coord_t
 {
@@ -17,17 +29,69 @@ struct imu_offset_t
     int gyroscopeOffsets[NUMBER_OF_AXIS] = {0, 0, 0};
 };
 
+struct imu_sample_t
+{
+    uint64_t timestamp; // Steady clock, in microseconds
+    int16_t accelerations[NUMBER_OF_AXIS];
+    int16_t rotations[NUMBER_OF_AXIS];
+    float quaternion[4]; // w, x, y, z from the DMP, else w = 1
+};
+
+enum ImuCalibrationState
+{
+    calibrationIdle,
+    calibrationBias,         // Raw bias, without offsets
+    calibrationSensitivity,  // Response to a first estimate of the offsets
+    calibrationVerification, // Offsets solved from the two previous points
+    calibrationDone,
+    calibrationFailed
+};
+
+struct imu_calibration_progress_t
+{
+    ImuCalibrationState state = calibrationIdle;
+    uint8_t pass = 0;                                   // Both sensors are measured at each pass
+    uint8_t maxPasses = 0;                              // The calibration fails past it
+    uint8_t passProgress = 0;                           // Percent of the largest number of samples of a pass
+    int accelerometerErrors[NUMBER_OF_AXIS] = {0, 0, 0}; // Distance to the target of the last pass, in LSB
+    int gyroscopeErrors[NUMBER_OF_AXIS] = {0, 0, 0};
+};
+
 struct pressure_mat_offset_t
 {
-    uint16_t analogOffset[PRESSURE_SENSOR_COUNT] = {0, 0, 0, 0, 0, 0, 0, 0, 0};
+    std::vector<uint16_t> analogOffset = std::vector<uint16_t>(DEFAULT_PRESSURE_SENSOR_COUNT, 0); // One per sensor
     uint32_t totalSensorMean = 0;
     float detectionThreshold = 0;
 };
 
+struct pressure_mat_adc_t
+{
+    uint8_t address = PRESSURE_MAT_ADC_ADDRESS;
+    int8_t muxChannel = -1; // TCA9548A channel, -1 directly on the bus
+    uint8_t muxAddress = PRESSURE_MAT_MUX_ADDRESS; // TCA9548A of the channel, 0x70 to 0x77
+    uint8_t channelCount = DEFAULT_PRESSURE_SENSOR_COUNT;
+};
+
+// The channels of the ADCs are numbered one after the other
+struct pressure_mat_geometry_t
+{
+    uint8_t rows = PRESSURE_MAT_DEFAULT_SIZE;
+    uint8_t columns = PRESSURE_MAT_DEFAULT_SIZE;
+    std::vector<pressure_mat_adc_t> adcs = std::vector<pressure_mat_adc_t>(1);
+};
+
+// Hardware channel of each sensor, empty for the default wiring: the map
+// above for a 3x3 mat, else the channels in order
+struct pressure_mat_channel_map_t
+{
+    std::vector<uint16_t> channels;
+};
+
 struct pressure_mat_data_t
 {
     Coord_t centerOfPressure = {0.0f, 0.0f};
-    Coord_t quadrantPressure[PRESSURE_SENSOR_COUNT] = {{0.0f, 0.0f}, {0.0f, 0.0f}, {0.0f, 0.0f}, {0.0f, 0.0f}};
+    std::vector<Coord_t> quadrantPressure; // Of each force plate, the quadrants of a 3x3 mat
+    std::vector<float> quadrantLoad;       // Share of the load of each force plate
 };
 
 struct notifications_settings_t
@@ -3,6 +3,7 @@
 #include "FixedImu.h"
 #include "MobileImu.h"
 #include "I2Cdev.h"
+#include "SPIdev.h"
 #include "Utils.h"
 #include "SysTime.h"
 
@@ -66,6 +67,7 @@ bool DeviceManager::IsPressureMatConnected()
 void DeviceManager::InitializeDevices()
 {
     I2Cdev::Initialize();
+    SPIdev::Initialize();
 
     _fileManager->Read();
 
@@ -79,6 +81,15 @@ void DeviceManager::InitializeDevices()
     _isMotionSensorInitialized = _motionSensor->Initialize();
     _datetimeRTC->SetCurrentDateTimeThread().detach();
 
+    const int monitoredDevices[] = {DEVICES::alarmSensor, DEVICES::fixedImu, DEVICES::mobileImu, DEVICES::motionSensor, DEVICES::pressureMat};
+    for (const int device : monitoredDevices)
+    {
+        _sensorHealth.Register(device, IsSensorConnected(device),
+                               [this, device] { return ProbeSensor(device); },
+                               [this, device] { return ReinitializeSensor(device); });
+    }
+    _sensorHealth.Start();
+
     _fileManager->Save();
 
     printf("Setup Done\n");
@@ -86,6 +97,8 @@ void DeviceManager::InitializeDevices()
 
 bool DeviceManager::InitializePressureMat()
 {
+    _pressureMat->SetGeometry(_fileManager->GetPressureMatGeometry());
+    _pressureMat->SetChannelMap(_fileManager->GetPressureMatChannelMap());
     pressure_mat_offset_t pressureMatOffset = _fileManager->GetPressureMatoffset();
     _pressureMat->SetOffsets(pressureMatOffset);
     _isPressureMatInitialized = _pressureMat->Initialize();
@@ -159,71 +172,150 @@ void DeviceManager::CalibrateIMU()
 
 void DeviceManager::CalibrateFixedIMU()
 {
-    printf("Calibrating FixedIMU ... \n");
-    _fixedImu->CalibrateAndSetOffsets();
-    _fileManager->SetFixedImuOffsets(_fixedImu->GetOffset());
-    _fileManager->Save();
-    _isFixedImuCalibrated = true;
-    printf("DONE\n");
+    _isFixedImuCalibrated = false;
+    _isFixedImuCalibrationRequested = true;
 }
 
 void DeviceManager::CalibrateMobileIMU()
 {
-    printf("Calibrating MobileIMU ... \n");
-    _mobileImu->CalibrateAndSetOffsets();
-    _fileManager->SetMobileImuOffsets(_mobileImu->GetOffset());
-    _fileManager->Save();
-    _isMobileImuCalibrated = true;
-    printf("DONE\n");
+    _isMobileImuCalibrated = false;
+    _isMobileImuCalibrationRequested = true;
+}
+
+// Runs one step of the IMU calibration in progress, or starts the next one
+void DeviceManager::UpdateImuCalibration()
+{
+    _hasImuCalibrationProgress = false;
+
+    if (_calibratingImu == nullptr)
+    {
+        if (_isFixedImuCalibrationRequested && _sensorState.fixedAccelerometerValid)
+        {
+            _isFixedImuCalibrationRequested = false;
+            _calibratingImu = _fixedImu;
+        }
+        else if (_isMobileImuCalibrationRequested && _sensorState.mobileAccelerometerValid)
+        {
+            _isMobileImuCalibrationRequested = false;
+            _calibratingImu = _mobileImu;
+        }
+        else
+        {
+            return;
+        }
+
+        printf("Calibrating %s ... \n", _calibratingImu->GetName().c_str());
+        _calibratingImu->StartCalibration();
+    }
+
+    const bool isFixedImu = _calibratingImu == _fixedImu;
+    const bool isValid = isFixedImu ? _sensorState.fixedAccelerometerValid : _sensorState.mobileAccelerometerValid;
+    if (!isValid)
+    {
+        _calibratingImu->CancelCalibration();
+    }
+
+    const ImuCalibrationState state = _calibratingImu->UpdateCalibration();
+    _imuCalibrationProgress = _calibratingImu->GetCalibrationProgress();
+    _imuCalibrationName = _calibratingImu->GetName();
+    _hasImuCalibrationProgress = true;
+
+    if (state == calibrationDone)
+    {
+        if (isFixedImu)
+        {
+            _fileManager->SetFixedImuOffsets(_fixedImu->GetOffset());
+            _isFixedImuCalibrated = true;
+        }
+        else
+        {
+            _fileManager->SetMobileImuOffsets(_mobileImu->GetOffset());
+            _isMobileImuCalibrated = true;
+        }
+        _fileManager->Save();
+        printf("DONE\n");
+    }
+    else if (!_calibratingImu->IsCalibrating())
+    {
+        // The previous offsets were restored, they are still usable if valid
+        const bool isCalibrated = Imu::IsImuOffsetValid(_calibratingImu->GetOffset());
+        if (isFixedImu)
+        {
+            _isFixedImuCalibrated = isCalibrated;
+        }
+        else
+        {
+            _isMobileImuCalibrated = isCalibrated;
+        }
+        printf("FAIL\n");
+    }
+    else
+    {
+        return;
+    }
+    _calibratingImu = nullptr;
+}
+
+bool DeviceManager::GetImuCalibrationProgress(std::string &imuName, imu_calibration_progress_t &progress)
+{
+    imuName = _imuCalibrationName;
+    progress = _imuCalibrationProgress;
+    return _hasImuCalibrationProgress;
 }
 
 void DeviceManager::Update()
 {
     _timeSinceEpoch = _datetimeRTC->GetTimeSinceEpoch();
 
-    _sensorState.notificationModuleValid = GetSensorValidity(DEVICES::alarmSensor, IsAlarmConnected());
-    _sensorState.fixedAccelerometerValid = GetSensorValidity(DEVICES::fixedImu, IsFixedImuConnected());
-    _sensorState.mobileAccelerometerValid = GetSensorValidity(DEVICES::mobileImu, IsMobileImuConnected());
-    _sensorState.pressureMatValid = GetSensorValidity(DEVICES::pressureMat, IsPressureMatConnected());
-    // TODO: Refactorer le test de connection du motion sensor car il prend beaucoup trop de temps
-    // UpdateSensor(DEVICES::motionSensor, _deviceManager->IsMotionSensorConnected());
+    {
+        // Connection probes must not delay the sampling. Dead sensors are not
+        // probed here, the health thread waits for them to answer again and
+        // they are re-initialized here, between two ticks.
+        I2cPriorityScope priorityScope(lowPriority);
+        _sensorHealth.Reinitialize();
+        _sensorState.notificationModuleValid = GetSensorValidity(DEVICES::alarmSensor);
+        _sensorState.fixedAccelerometerValid = GetSensorValidity(DEVICES::fixedImu);
+        _sensorState.mobileAccelerometerValid = GetSensorValidity(DEVICES::mobileImu);
+        _sensorState.pressureMatValid = GetSensorValidity(DEVICES::pressureMat);
+        _isMotionSensorValid = GetSensorValidity(DEVICES::motionSensor);
+    }
+
+    I2cPriorityScope priorityScope(realTimePriority);
+
+    UpdateImuCalibration();
+
+    // Captured once per tick, every consumer below reads these frames
+    _fixedImuFrame = _sensorState.fixedAccelerometerValid ? _fixedImu->Capture() : ImuFrame();
+    _mobileImuFrame = _sensorState.mobileAccelerometerValid ? _mobileImu->Capture() : ImuFrame();
 
-    if (_isMotionSensorInitialized)
+    if (_isMotionSensorValid && _isMotionSensorInitialized)
     {
         _motionSensor->GetDeltaXY();
         _isMoving = _motionSensor->IsMoving();
     }
 
-    if (_isFixedImuInitialized && _isMobileImuInitialized && _isFixedImuCalibrated && _isMobileImuCalibrated)
+    // A device that was re-initialized but not calibrated yet is not used
+    if (_sensorState.fixedAccelerometerValid && _sensorState.mobileAccelerometerValid && _isFixedImuCalibrated && _isMobileImuCalibrated)
     {
         // Data: Angle (centrales intertielles mobile/fixe)
-        _backSeatAngle = _backSeatAngleTracker.GetBackSeatAngle();
+        _backSeatAngle = _backSeatAngleTracker.GetBackSeatAngle(_fixedImuFrame, _mobileImuFrame);
     }
     else
     {
         _backSeatAngle = DEFAULT_BACK_SEAT_ANGLE;
     }
 
-    if (_isFixedImuInitialized && _isFixedImuCalibrated)
+    if (_sensorState.fixedAccelerometerValid && _isFixedImuCalibrated)
     {
-        _isChairInclined = _backSeatAngleTracker.IsInclined();
+        _isChairInclined = _backSeatAngleTracker.IsInclined(_fixedImuFrame);
     }
 
-    if (_isPressureMatInitialized && IsPressureMatCalibrated())
+    if (_sensorState.pressureMatValid && IsPressureMatCalibrated())
     {
         _pressureMat->Update();
     }
 }
 
-double DeviceManager::GetXAcceleration()
-{
-    if (_isFixedImuInitialized)
-    {
-        return _fixedImu->GetXAcceleration();
-    }
-    return 0;
-}
-
 void DeviceManager::UpdateNotificationsSettings(notifications_settings_t notificationsSettings)
 {
     _notificationsSettings = notificationsSettings;
@@ -272,41 +364,66 @@ bool DeviceManager::IsSensorStateChanged(const int device)
     return false;
 }
 
-bool DeviceManager::GetSensorValidity(const int device, const bool isConnected)
+bool DeviceManager::GetSensorValidity(const int device)
 {
-    bool ret = isConnected;
-    Sensor *sensor;
-    try
+    if (!_sensorHealth.IsAvailable(device))
     {
-        sensor = GetSensor(device);
+        return false;
     }
-    catch (const InvalidSensorException &e)
+
+    bool isConnected = IsSensorConnected(device);
+    _sensorHealth.ReportProbe(device, isConnected);
+    return isConnected;
+}
+
+bool DeviceManager::IsSensorConnected(const int device)
+{
+    switch (device)
     {
-        printf("%s", e.what());
+    case alarmSensor:
+        return IsAlarmConnected();
+    case mobileImu:
+        return IsMobileImuConnected();
+    case fixedImu:
+        return IsFixedImuConnected();
+    case motionSensor:
+        return IsMotionSensorConnected();
+    case pressureMat:
+        return IsPressureMatConnected();
+    default:
         return false;
     }
+}
+
+// Called by the health thread while a sensor is dead. A bus that could not
+// be opened, at startup or since, is retried before each probe of its devices.
+bool DeviceManager::ProbeSensor(const int device)
+{
+    I2Cdev::OpenBuses();
+    return IsSensorConnected(device);
+}
 
-    if (!isConnected)
+// Called from Update(), through the health manager, when a dead sensor
+// answers again
+bool DeviceManager::ReinitializeSensor(const int device)
+{
+    switch (device)
     {
-        if (typeid(sensor) == typeid(FixedImu))
-        {
-            ret = InitializeFixedImu();
-        }
-        else if (typeid(sensor) == typeid(MobileImu))
-        {
-            ret = InitializeMobileImu();
-        }
-        else if (typeid(sensor) == typeid(ForcePlate))
-        {
-            ret = InitializePressureMat();
-        }
-        else
-        {
-            ret = sensor->Initialize();
-        }
+    case alarmSensor:
+        _isAlarmInitialized = _alarm.Initialize();
+        return _isAlarmInitialized;
+    case mobileImu:
+        return InitializeMobileImu();
+    case fixedImu:
+        return InitializeFixedImu();
+    case motionSensor:
+        _isMotionSensorInitialized = _motionSensor->Initialize();
+        return _isMotionSensorInitialized;
+    case pressureMat:
+        return InitializePressureMat();
+    default:
+        return false;
     }
-
-    return ret;
 }
 
 void DeviceManager::TurnOff()
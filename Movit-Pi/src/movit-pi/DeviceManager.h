@@ -1,6 +1,7 @@
 #ifndef DEVICE_MANAGER_H
 #define DEVICE_MANAGER_H
 
+#include <atomic>
 #include <string>
 
 #include "Imu.h"
@@ -14,6 +15,7 @@
 #include "FileManager.h"
 #include "Sensor.h"
 #include "PressureMat.h"
+#include "SensorHealthManager.h"
 
 class DeviceManager
 {
@@ -35,15 +37,17 @@ class DeviceManager
 
     pressure_mat_data_t GetPressureMatData() { return _pressureMat->GetPressureMatData(); }
 
-    int GetBackSeatAngle() { return _backSeatAngle; }
+    float GetBackSeatAngle() { return _backSeatAngle; }
     int GetTimeSinceEpoch() { return _timeSinceEpoch; }
 
-    double GetXAcceleration();
-
+    // The IMU calibrations are only requested here, Update() runs them one
+    // after the other, a bounded step per tick
     void CalibrateIMU();
     void CalibrateFixedIMU();
     void CalibrateMobileIMU();
     void CalibratePressureMat();
+    // Progress of the IMU calibration that ran during the last update
+    bool GetImuCalibrationProgress(std::string &imuName, imu_calibration_progress_t &progress);
 
     void TurnOff();
 
@@ -83,27 +87,40 @@ class DeviceManager
     const int32_t DEFAULT_BACK_SEAT_ANGLE = 0;
 
     Sensor *GetSensor(const int device);
-    bool GetSensorValidity(const int device, const bool isConnected);
+    bool GetSensorValidity(const int device);
+    bool IsSensorConnected(const int device);
+    bool ProbeSensor(const int device);
+    bool ReinitializeSensor(const int device);
     bool IsSensorStateChanged(const int device);
 
     bool InitializeFixedImu();
     bool InitializeMobileImu();
     bool InitializePressureMat();
-
-    bool _isAlarmInitialized = false;
-    bool _isFixedImuInitialized = false;
-    bool _isMobileImuInitialized = false;
-    bool _isMotionSensorInitialized = false;
-    bool _isPressureMatInitialized = false;
-
-    bool _isFixedImuCalibrated = false;
-    bool _isMobileImuCalibrated = false;
-
+    void UpdateImuCalibration();
+
+    // Also written by the connection probes of the health thread
+    std::atomic<bool> _isAlarmInitialized{false};
+    std::atomic<bool> _isFixedImuInitialized{false};
+    std::atomic<bool> _isMobileImuInitialized{false};
+    std::atomic<bool> _isMotionSensorInitialized{false};
+    std::atomic<bool> _isPressureMatInitialized{false};
+
+    std::atomic<bool> _isFixedImuCalibrated{false};
+    std::atomic<bool> _isMobileImuCalibrated{false};
+    std::atomic<bool> _isFixedImuCalibrationRequested{false};
+    std::atomic<bool> _isMobileImuCalibrationRequested{false};
+
+    Imu *_calibratingImu = nullptr;
+    imu_calibration_progress_t _imuCalibrationProgress;
+    std::string _imuCalibrationName;
+    bool _hasImuCalibrationProgress = false;
+
+    bool _isMotionSensorValid = false;
     bool _isMoving = false;
     bool _isChairInclined = false;
 
-    int _timeSinceEpoch = 0;
-    int _backSeatAngle = 0;
+    std::atomic<int> _timeSinceEpoch{0}; // Also read by the vibration thread
+    float _backSeatAngle = 0;
 
     FileManager *_fileManager;
 
@@ -112,8 +129,11 @@ class DeviceManager
     MobileImu *_mobileImu;
     FixedImu *_fixedImu;
     BackSeatAngleTracker _backSeatAngleTracker;
+    ImuFrame _fixedImuFrame;
+    ImuFrame _mobileImuFrame;
     PressureMat *_pressureMat;
     MotionSensor *_motionSensor;
+    SensorHealthManager _sensorHealth;
 
     notifications_settings_t _notificationsSettings;
     sensor_state_t _sensorState;
@@ -0,0 +1,104 @@
+#include "FastMath.h"
+#include "Utils.h"
+
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define BENCHMARK_DIRECTION_COUNT 4096
+#define BENCHMARK_PASS_COUNT 100
+
+namespace
+{
+// Keeps the compiler from dropping the benchmarked computations
+volatile double benchmarkSink = 0;
+} // namespace
+
+void ComputeTiltAnglesPrecise(const double *gravity, double &pitch, double &roll)
+{
+    const double *a = gravity;
+    pitch = atan2(-1 * a[AXIS::z], sqrt(a[AXIS::x] * a[AXIS::x] + a[AXIS::y] * a[AXIS::y])) * RADIANS_TO_DEGREES;
+    roll = atan2(a[AXIS::x], a[AXIS::y]) * RADIANS_TO_DEGREES + 90;
+}
+
+void ComputeTiltAnglesFast(const float *gravity, float &pitch, float &roll)
+{
+    const float *a = gravity;
+    const float horizontalSquare = a[AXIS::x] * a[AXIS::x] + a[AXIS::y] * a[AXIS::y];
+    const float horizontal = horizontalSquare > 0 ? horizontalSquare * FastInverseSqrt(horizontalSquare) : 0;
+    pitch = FastAtan2(-a[AXIS::z], horizontal) * static_cast<float>(RADIANS_TO_DEGREES);
+    roll = FastAtan2(a[AXIS::x], a[AXIS::y]) * static_cast<float>(RADIANS_TO_DEGREES) + 90;
+}
+
+void BenchmarkTiltAngles()
+{
+    // Directions all over the sphere, in raw counts of the accelerometer
+    static double directions[BENCHMARK_DIRECTION_COUNT][3];
+    static float fastDirections[BENCHMARK_DIRECTION_COUNT][3];
+    srand(1);
+    for (uint16_t i = 0; i < BENCHMARK_DIRECTION_COUNT; i++)
+    {
+        const double z = 2.0 * rand() / RAND_MAX - 1;
+        const double azimuth = 2 * M_PI * rand() / RAND_MAX;
+        const double norm = 16384 * (0.5 + 1.0 * rand() / RAND_MAX);
+        const double horizontal = sqrt(1 - z * z);
+        directions[i][AXIS::x] = norm * horizontal * cos(azimuth);
+        directions[i][AXIS::y] = norm * horizontal * sin(azimuth);
+        directions[i][AXIS::z] = norm * z;
+        for (uint8_t axis = 0; axis < 3; axis++)
+        {
+            fastDirections[i][axis] = static_cast<float>(directions[i][axis]);
+        }
+    }
+
+    double pitchError = 0, rollError = 0, meanError = 0;
+    for (uint16_t i = 0; i < BENCHMARK_DIRECTION_COUNT; i++)
+    {
+        double pitch, roll;
+        float fastPitch, fastRoll;
+        ComputeTiltAnglesPrecise(directions[i], pitch, roll);
+        ComputeTiltAnglesFast(fastDirections[i], fastPitch, fastRoll);
+
+        // The roll wraps around at 270 degrees
+        const double rollDifference = fmod(fabs(fastRoll - roll), 360);
+        pitchError = fmax(pitchError, fabs(fastPitch - pitch));
+        rollError = fmax(rollError, fmin(rollDifference, 360 - rollDifference));
+        meanError += fabs(fastPitch - pitch) / (2 * BENCHMARK_DIRECTION_COUNT) + fmin(rollDifference, 360 - rollDifference) / (2 * BENCHMARK_DIRECTION_COUNT);
+    }
+
+    double sum = 0;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (uint16_t pass = 0; pass < BENCHMARK_PASS_COUNT; pass++)
+    {
+        for (uint16_t i = 0; i < BENCHMARK_DIRECTION_COUNT; i++)
+        {
+            double pitch, roll;
+            ComputeTiltAnglesPrecise(directions[i], pitch, roll);
+            sum += pitch + roll;
+        }
+    }
+    const double preciseElapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+    float fastSum = 0;
+    start = std::chrono::steady_clock::now();
+    for (uint16_t pass = 0; pass < BENCHMARK_PASS_COUNT; pass++)
+    {
+        for (uint16_t i = 0; i < BENCHMARK_DIRECTION_COUNT; i++)
+        {
+            float pitch, roll;
+            ComputeTiltAnglesFast(fastDirections[i], pitch, roll);
+            fastSum += pitch + roll;
+        }
+    }
+    const double fastElapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+    const double calls = static_cast<double>(BENCHMARK_PASS_COUNT) * BENCHMARK_DIRECTION_COUNT;
+    printf("pitch and roll: libm %.1f ns, fast %.1f ns (x%.1f), fast error max %.5f deg pitch, %.5f deg roll, mean %.6f deg\n",
+           preciseElapsed / calls, fastElapsed / calls, preciseElapsed / fastElapsed, pitchError, rollError, meanError);
+    benchmarkSink = sum + fastSum;
+#ifdef MOVIT_FAST_MATH
+    printf("pitch and roll: fast version in use\n");
+#else
+    printf("pitch and roll: libm version in use\n");
+#endif
+}
@@ -0,0 +1,77 @@
+#ifndef FAST_MATH_H
+#define FAST_MATH_H
+
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+
+// Approximations of the orientation math, cheaper than libm on the ARMv6 and
+// ARMv7 cores without a fast double precision unit. MOVIT_FAST_MATH selects
+// them for the pitch and the roll, the libm versions stay the reference.
+// BenchmarkTiltAngles() reports their cost and their error.
+
+// 1 / sqrt(x) from the bit trick of Quake III, refined by two Newton steps to a
+// relative error below 5e-6. x must be positive.
+inline float FastInverseSqrt(float x)
+{
+    uint32_t bits;
+    memcpy(&bits, &x, sizeof(bits));
+    bits = 0x5f3759df - (bits >> 1);
+    float y;
+    memcpy(&y, &bits, sizeof(y));
+
+    const float halfX = 0.5f * x;
+    y *= 1.5f - halfX * y * y;
+    y *= 1.5f - halfX * y * y;
+    return y;
+}
+
+// atan2 in radians, from an odd minimax polynomial of atan on [-1, 1], within
+// about 2e-6 rad (0.0001 degree). The other octants are folded onto it.
+inline float FastAtan2(float y, float x)
+{
+    const float absX = fabsf(x);
+    const float absY = fabsf(y);
+    if (absX == 0 && absY == 0)
+    {
+        return 0;
+    }
+
+    const bool isSteep = absY > absX;
+    const float t = isSteep ? absX / absY : absY / absX;
+    const float t2 = t * t;
+    float angle = t * (0.99997726f + t2 * (-0.33262347f + t2 * (0.19354346f + t2 * (-0.11643287f + t2 * (0.05265332f - t2 * 0.01172120f)))));
+
+    if (isSteep)
+    {
+        angle = static_cast<float>(M_PI_2) - angle;
+    }
+    if (x < 0)
+    {
+        angle = static_cast<float>(M_PI) - angle;
+    }
+    return y < 0 ? -angle : angle;
+}
+
+// Pitch and roll in degrees from the direction of gravity in the IMU axes, in
+// any unit: raw counts work as well as g. Both angles come out of one pass.
+void ComputeTiltAnglesPrecise(const double *gravity, double &pitch, double &roll);
+void ComputeTiltAnglesFast(const float *gravity, float &pitch, float &roll);
+
+inline void ComputeTiltAngles(const double *gravity, double &pitch, double &roll)
+{
+#ifdef MOVIT_FAST_MATH
+    const float fastGravity[3] = {static_cast<float>(gravity[0]), static_cast<float>(gravity[1]), static_cast<float>(gravity[2])};
+    float fastPitch, fastRoll;
+    ComputeTiltAnglesFast(fastGravity, fastPitch, fastRoll);
+    pitch = fastPitch;
+    roll = fastRoll;
+#else
+    ComputeTiltAnglesPrecise(gravity, pitch, roll);
+#endif
+}
+
+// Prints the cost of both versions and the error of the fast one
+void BenchmarkTiltAngles();
+
+#endif // FAST_MATH_H
@@ -15,6 +15,8 @@ const string SETTINGS_FILENAME = "settings.txt";
 const string TILTS_SETTINGS_OBJECT = "tilt_settings";
 const string NOTIFICATIONS_SETTINGS_OBJECT = "notifications_settings";
 const string PRESSURE_MAT_OBJECT = "pressure_mat_offset";
+const string PRESSURE_MAT_CHANNEL_MAP_OBJECT = "pressure_mat_channel_map";
+const string PRESSURE_MAT_GEOMETRY_OBJECT = "pressure_mat_geometry";
 const string FIXED_IMU_OBJECT = "fixed_imu_offset";
 const string MOBILE_IMU_OBJECT = "mobile_imu_offset";
 
@@ -38,6 +40,8 @@ void FileManager::Read()
         if (doc.IsObject())
         {
             _pressureMatOffset = ParsePressureMatOffset(doc);
+            _pressureMatGeometry = ParsePressureMatGeometry(doc);
+            _pressureMatChannelMap = ParsePressureMatChannelMap(doc);
             _notificationsSettings = ParseNotificationsSettings(doc);
             _fixedImuOffset = ParseIMUOffset(doc, FIXED_IMU_OBJECT);
             _mobileImuOffset = ParseIMUOffset(doc, MOBILE_IMU_OBJECT);
@@ -54,6 +58,8 @@ void FileManager::Save()
 
     writer.StartObject();
     FormatPressureMatOffset(writer, _pressureMatOffset, PRESSURE_MAT_OBJECT);
+    FormatPressureMatGeometry(writer, _pressureMatGeometry, PRESSURE_MAT_GEOMETRY_OBJECT);
+    FormatPressureMatChannelMap(writer, _pressureMatChannelMap, PRESSURE_MAT_CHANNEL_MAP_OBJECT);
     FormatImuOffset(writer, _fixedImuOffset, FIXED_IMU_OBJECT);
     FormatImuOffset(writer, _mobileImuOffset, MOBILE_IMU_OBJECT);
     FormatNotificationsSettings(writer, _notificationsSettings, NOTIFICATIONS_SETTINGS_OBJECT);
@@ -80,9 +86,9 @@ void FileManager::FormatPressureMatOffset(Writer<StringBuffer> &writer, pressure
     writer.StartObject();
     writer.Key("analogOffset");
     writer.StartArray();
-    for (unsigned i = 0; i < PRESSURE_SENSOR_COUNT; i++)
+    for (uint16_t analogOffset : offset.analogOffset)
     {
-        writer.Int(offset.analogOffset[i]);
+        writer.Int(analogOffset);
     }
     writer.EndArray();
     writer.Key("totalSensorMean");
@@ -92,6 +98,47 @@ void FileManager::FormatPressureMatOffset(Writer<StringBuffer> &writer, pressure
     writer.EndObject();
 }
 
+void FileManager::FormatPressureMatChannelMap(Writer<StringBuffer> &writer, pressure_mat_channel_map_t channelMap, string objectName)
+{
+    writer.Key(objectName.c_str());
+    writer.StartObject();
+    writer.Key("channels");
+    writer.StartArray();
+    for (uint16_t channel : channelMap.channels)
+    {
+        writer.Int(channel);
+    }
+    writer.EndArray();
+    writer.EndObject();
+}
+
+void FileManager::FormatPressureMatGeometry(Writer<StringBuffer> &writer, pressure_mat_geometry_t geometry, string objectName)
+{
+    writer.Key(objectName.c_str());
+    writer.StartObject();
+    writer.Key("rows");
+    writer.Int(geometry.rows);
+    writer.Key("columns");
+    writer.Int(geometry.columns);
+    writer.Key("adcs");
+    writer.StartArray();
+    for (const pressure_mat_adc_t &adc : geometry.adcs)
+    {
+        writer.StartObject();
+        writer.Key("address");
+        writer.Int(adc.address);
+        writer.Key("muxChannel");
+        writer.Int(adc.muxChannel);
+        writer.Key("muxAddress");
+        writer.Int(adc.muxAddress);
+        writer.Key("channels");
+        writer.Int(adc.channelCount);
+        writer.EndObject();
+    }
+    writer.EndArray();
+    writer.EndObject();
+}
+
 void FileManager::FormatImuOffset(Writer<StringBuffer> &writer, imu_offset_t offset, string objectName)
 {
     writer.Key(objectName.c_str());
@@ -208,6 +255,7 @@ pressure_mat_offset_t FileManager::ParsePressureMatOffset(Document &document)
         Value &jsonArray = object["analogOffset"];
         if (jsonArray.IsArray())
         {
+            ret.analogOffset.resize(jsonArray.Size());
             for (size_t i = 0; i < jsonArray.Size(); i++)
             {
                 ret.analogOffset[i] = jsonArray[i].GetInt();
@@ -221,6 +269,85 @@ pressure_mat_offset_t FileManager::ParsePressureMatOffset(Document &document)
     return ret;
 }
 
+// The map is optional, the settings written before it get the default wiring
+pressure_mat_channel_map_t FileManager::ParsePressureMatChannelMap(Document &document)
+{
+    pressure_mat_channel_map_t ret;
+
+    if (document.HasMember(PRESSURE_MAT_CHANNEL_MAP_OBJECT.c_str()) && document[PRESSURE_MAT_CHANNEL_MAP_OBJECT.c_str()].IsObject())
+    {
+        Value &object = document[PRESSURE_MAT_CHANNEL_MAP_OBJECT.c_str()];
+
+        // Its size is checked against the geometry by the pressure mat
+        if (object.HasMember("channels") && object["channels"].IsArray())
+        {
+            Value &jsonArray = object["channels"];
+            ret.channels.resize(jsonArray.Size());
+            for (size_t i = 0; i < jsonArray.Size(); i++)
+            {
+                // Out of range, the map is rejected by the pressure mat
+                ret.channels[i] = jsonArray[i].IsUint() && jsonArray[i].GetUint() < UINT16_MAX ? jsonArray[i].GetUint() : UINT16_MAX;
+            }
+        }
+    }
+
+    return ret;
+}
+
+// Optional as well, the default is the 3x3 mat on a single MAX11611. Values
+// out of range are rejected by the pressure mat.
+pressure_mat_geometry_t FileManager::ParsePressureMatGeometry(Document &document)
+{
+    pressure_mat_geometry_t ret;
+
+    if (document.HasMember(PRESSURE_MAT_GEOMETRY_OBJECT.c_str()) && document[PRESSURE_MAT_GEOMETRY_OBJECT.c_str()].IsObject())
+    {
+        Value &object = document[PRESSURE_MAT_GEOMETRY_OBJECT.c_str()];
+        auto getSize = [](Value &value) { return value.IsUint() && value.GetUint() <= UINT8_MAX ? static_cast<uint8_t>(value.GetUint()) : 0; };
+
+        if (object.HasMember("rows"))
+        {
+            ret.rows = getSize(object["rows"]);
+        }
+        if (object.HasMember("columns"))
+        {
+            ret.columns = getSize(object["columns"]);
+        }
+        if (object.HasMember("adcs") && object["adcs"].IsArray())
+        {
+            Value &jsonArray = object["adcs"];
+            ret.adcs.resize(jsonArray.Size());
+            for (size_t i = 0; i < jsonArray.Size(); i++)
+            {
+                if (!jsonArray[i].IsObject())
+                {
+                    ret.adcs[i].channelCount = 0;
+                    continue;
+                }
+                if (jsonArray[i].HasMember("address"))
+                {
+                    ret.adcs[i].address = getSize(jsonArray[i]["address"]);
+                }
+                if (jsonArray[i].HasMember("muxChannel") && jsonArray[i]["muxChannel"].IsInt())
+                {
+                    const int muxChannel = jsonArray[i]["muxChannel"].GetInt();
+                    ret.adcs[i].muxChannel = muxChannel < 0 ? -1 : static_cast<int8_t>(muxChannel < INT8_MAX ? muxChannel : INT8_MAX);
+                }
+                if (jsonArray[i].HasMember("muxAddress"))
+                {
+                    ret.adcs[i].muxAddress = getSize(jsonArray[i]["muxAddress"]);
+                }
+                if (jsonArray[i].HasMember("channels"))
+                {
+                    ret.adcs[i].channelCount = getSize(jsonArray[i]["channels"]);
+                }
+            }
+        }
+    }
+
+    return ret;
+}
+
 imu_offset_t FileManager::GetMobileImuOffsets()
 {
     imu_offset_t ret;
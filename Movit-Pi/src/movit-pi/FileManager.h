@@ -16,6 +16,8 @@ class FileManager
 
 	notifications_settings_t GetNotificationsSettings() { return _notificationsSettings; }
 	pressure_mat_offset_t GetPressureMatoffset() { return _pressureMatOffset; }
+	pressure_mat_channel_map_t GetPressureMatChannelMap() { return _pressureMatChannelMap; }
+	pressure_mat_geometry_t GetPressureMatGeometry() { return _pressureMatGeometry; }
 	tilt_settings_t GetTiltSettings() { return _tiltSettings; }
 	imu_offset_t GetMobileImuOffsets();
 	imu_offset_t GetFixedImuOffsets();
@@ -41,18 +43,24 @@ class FileManager
 
 	notifications_settings_t _notificationsSettings;
 	pressure_mat_offset_t _pressureMatOffset;
+	pressure_mat_channel_map_t _pressureMatChannelMap;
+	pressure_mat_geometry_t _pressureMatGeometry;
 	tilt_settings_t _tiltSettings;
 	imu_offset_t _mobileImuOffset;
 	imu_offset_t _fixedImuOffset;
 
 	void FormatNotificationsSettings(rapidjson::Writer<rapidjson::StringBuffer> &writer, notifications_settings_t notificationsSettings, std::string objectName);
 	void FormatPressureMatOffset(rapidjson::Writer<rapidjson::StringBuffer> &writer, pressure_mat_offset_t offset, std::string objectName);
+	void FormatPressureMatChannelMap(rapidjson::Writer<rapidjson::StringBuffer> &writer, pressure_mat_channel_map_t channelMap, std::string objectName);
+	void FormatPressureMatGeometry(rapidjson::Writer<rapidjson::StringBuffer> &writer, pressure_mat_geometry_t geometry, std::string objectName);
 	void FormatTiltSettings(rapidjson::Writer<rapidjson::StringBuffer> &writer, tilt_settings_t tiltSettings, std::string objectName);
 	void FormatImuOffset(rapidjson::Writer<rapidjson::StringBuffer> &writer, imu_offset_t offset, std::string objectName);
 
 	imu_offset_t ParseIMUOffset(rapidjson::Document &document, std::string objectName);
 	notifications_settings_t ParseNotificationsSettings(rapidjson::Document &document);
 	pressure_mat_offset_t ParsePressureMatOffset(rapidjson::Document &document);
+	pressure_mat_channel_map_t ParsePressureMatChannelMap(rapidjson::Document &document);
+	pressure_mat_geometry_t ParsePressureMatGeometry(rapidjson::Document &document);
 	tilt_settings_t ParseTiltSettings(rapidjson::Document &document);
 };
 
@@ -0,0 +1,114 @@
+#include "Filters.h"
+
+#include <chrono>
+#include <numeric>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define BENCHMARK_SAMPLE_COUNT 1000000
+#define BENCHMARK_PATTERN_LENGTH 1024
+#define BENCHMARK_SHORT_WINDOW 10 // The motion sensor window
+#define BENCHMARK_LONG_WINDOW 100
+
+namespace
+{
+// Keeps the compiler from dropping the benchmarked computations
+volatile double benchmarkSink = 0;
+
+// The MovingAverage replaced by Filters.h: a fixed 256 slot buffer whatever
+// the window, summed again at each call from an int 0
+template <class T>
+class LegacyMovingAverage
+{
+  public:
+    LegacyMovingAverage(uint8_t windowSize) : _windowSize(windowSize) {}
+
+    void AddSample(T sample)
+    {
+        _values[_pos] = sample;
+        _pos++;
+        if (_pos >= _windowSize)
+        {
+            _pos = 0;
+            _windowFilled = true;
+        }
+    }
+
+    double GetAverage()
+    {
+        if (_windowFilled)
+        {
+            return static_cast<double>(std::accumulate(_values, _values + _windowSize, 0) / _windowSize);
+        }
+        if (_pos == 0)
+        {
+            return 0.0f;
+        }
+        return static_cast<double>(std::accumulate(_values, _values + _pos, 0) / _pos);
+    }
+
+  private:
+    uint8_t _windowSize = 0;
+    uint8_t _pos = 0;
+    T _values[256];
+    bool _windowFilled = false;
+};
+
+// Range sensor like samples, in millimeters
+int16_t samples[BENCHMARK_PATTERN_LENGTH];
+
+template <class Filter>
+void Measure(const char *name, Filter filter, size_t size)
+{
+    double sum = 0;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < BENCHMARK_SAMPLE_COUNT; i++)
+    {
+        sum += filter(samples[i % BENCHMARK_PATTERN_LENGTH]);
+    }
+    const double elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    benchmarkSink = sum;
+    printf("%-28s %6.1f ns/sample, %5zu bytes\n", name, elapsed / BENCHMARK_SAMPLE_COUNT, size);
+}
+} // namespace
+
+void BenchmarkFilters()
+{
+    srand(1);
+    for (uint16_t i = 0; i < BENCHMARK_PATTERN_LENGTH; i++)
+    {
+        samples[i] = static_cast<int16_t>(500 + 100 * sin(i * 0.05) + rand() % 21 - 10);
+    }
+
+    // Each filter gets a sample and gives its output, as the sensors use them
+    LegacyMovingAverage<int16_t> legacyShort(BENCHMARK_SHORT_WINDOW);
+    Measure("legacy average (10)", [&](int16_t sample) { legacyShort.AddSample(sample); return legacyShort.GetAverage(); }, sizeof(legacyShort));
+    LegacyMovingAverage<int16_t> legacyLong(BENCHMARK_LONG_WINDOW);
+    Measure("legacy average (100)", [&](int16_t sample) { legacyLong.AddSample(sample); return legacyLong.GetAverage(); }, sizeof(legacyLong));
+
+    MovingAverage<int16_t, BENCHMARK_SHORT_WINDOW> averageShort;
+    Measure("moving average (10)", [&](int16_t sample) { averageShort.AddSample(sample); return averageShort.GetAverage(); }, sizeof(averageShort));
+    MovingAverage<int16_t, BENCHMARK_LONG_WINDOW> averageLong;
+    Measure("moving average (100)", [&](int16_t sample) { averageLong.AddSample(sample); return averageLong.GetAverage(); }, sizeof(averageLong));
+
+    MovingMedian<int16_t, BENCHMARK_SHORT_WINDOW> medianShort;
+    Measure("moving median (10)", [&](int16_t sample) { medianShort.AddSample(sample); return medianShort.GetMedian(); }, sizeof(medianShort));
+    MovingMedian<int16_t, BENCHMARK_LONG_WINDOW> medianLong;
+    Measure("moving median (100)", [&](int16_t sample) { medianLong.AddSample(sample); return medianLong.GetMedian(); }, sizeof(medianLong));
+
+    ExponentialAverage exponential(0.1f);
+    Measure("exponential average", [&](int16_t sample) { return exponential.AddSample(sample); }, sizeof(exponential));
+    BiquadLowPass lowPass;
+    lowPass.Configure(100, 5);
+    Measure("biquad low-pass", [&](int16_t sample) { return lowPass.AddSample(sample); }, sizeof(lowPass));
+
+    // The legacy sum started from an int, the fractions were lost
+    LegacyMovingAverage<float> legacyFloat(BENCHMARK_SHORT_WINDOW);
+    MovingAverage<float, BENCHMARK_SHORT_WINDOW> averageFloat;
+    for (uint8_t i = 0; i < BENCHMARK_SHORT_WINDOW; i++)
+    {
+        legacyFloat.AddSample(0.75f);
+        averageFloat.AddSample(0.75f);
+    }
+    printf("average of 0.75: legacy %.2f, moving average %.2f\n", legacyFloat.GetAverage(), averageFloat.GetAverage());
+}
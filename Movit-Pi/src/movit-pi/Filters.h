@@ -0,0 +1,198 @@
+#ifndef FILTERS_H
+#define FILTERS_H
+
+#include <algorithm>
+#include <math.h>
+#include <stdint.h>
+#include <type_traits>
+
+// Streaming filters, one sample at a time. Each one takes the memory of its
+// window and nothing more, sized at compile time.
+
+// Mean of the last WindowSize samples, from a running sum: the oldest sample
+// is subtracted as the new one is added. The integer samples are summed as
+// integers, exactly, the floating point ones in double.
+template <class T, uint16_t WindowSize>
+class MovingAverage
+{
+    static_assert(WindowSize > 0, "A MovingAverage needs a window");
+
+  public:
+    void AddSample(T sample)
+    {
+        if (_count == WindowSize)
+        {
+            _sum -= _values[_position];
+        }
+        else
+        {
+            _count++;
+        }
+
+        _values[_position] = sample;
+        _sum += sample;
+        _position = _position + 1 == WindowSize ? 0 : _position + 1;
+    }
+
+    // Mean of the samples added so far until the window is filled, 0 without samples
+    double GetAverage() const
+    {
+        return _count == 0 ? 0.0 : static_cast<double>(_sum) / _count;
+    }
+
+    uint16_t GetCount() const { return _count; }
+    bool IsFilled() const { return _count == WindowSize; }
+
+    void Reset()
+    {
+        _count = 0;
+        _position = 0;
+        _sum = 0;
+    }
+
+  private:
+    typedef typename std::conditional<std::is_floating_point<T>::value, double, int64_t>::type sum_t;
+
+    T _values[WindowSize];
+    uint16_t _count = 0;
+    uint16_t _position = 0;
+    sum_t _sum = 0;
+};
+
+// First order low-pass, y += alpha * (x - y). The first sample initializes it.
+class ExponentialAverage
+{
+  public:
+    explicit ExponentialAverage(float alpha = 1) : _alpha(alpha) {}
+
+    // Time constant in seconds of the samples taken every period seconds
+    void SetTimeConstant(float timeConstant, float period)
+    {
+        _alpha = period / (timeConstant + period);
+    }
+
+    float AddSample(float sample)
+    {
+        _value = _isInitialized ? _value + _alpha * (sample - _value) : sample;
+        _isInitialized = true;
+        return _value;
+    }
+
+    float GetValue() const { return _value; }
+    void Reset() { _isInitialized = false; }
+
+  private:
+    float _alpha;
+    float _value = 0;
+    bool _isInitialized = false;
+};
+
+// Second order Butterworth low-pass (Q = 1 / sqrt(2)) from the Audio EQ
+// Cookbook, in transposed direct form II. The state starts at the first
+// sample, without a step from 0.
+class BiquadLowPass
+{
+  public:
+    void Configure(float sampleRate, float cutoffFrequency, float q = static_cast<float>(M_SQRT1_2))
+    {
+        const double omega = 2 * M_PI * cutoffFrequency / sampleRate;
+        const double alpha = sin(omega) / (2 * q);
+        const double a0 = 1 + alpha;
+        _b0 = static_cast<float>((1 - cos(omega)) / 2 / a0);
+        _b1 = static_cast<float>((1 - cos(omega)) / a0);
+        _b2 = _b0;
+        _a1 = static_cast<float>(-2 * cos(omega) / a0);
+        _a2 = static_cast<float>((1 - alpha) / a0);
+        Reset();
+    }
+
+    float AddSample(float sample)
+    {
+        if (!_isInitialized)
+        {
+            // Steady state of a constant input, the DC gain is 1
+            _z1 = sample * (1 - _b0);
+            _z2 = sample * (_b2 - _a2);
+            _isInitialized = true;
+        }
+
+        const float output = _b0 * sample + _z1;
+        _z1 = _b1 * sample - _a1 * output + _z2;
+        _z2 = _b2 * sample - _a2 * output;
+        return output;
+    }
+
+    void Reset() { _isInitialized = false; }
+
+  private:
+    float _b0 = 1, _b1 = 0, _b2 = 0, _a1 = 0, _a2 = 0;
+    float _z1 = 0, _z2 = 0;
+    bool _isInitialized = false;
+};
+
+// Median of the last WindowSize samples, rejects isolated outliers. The
+// window is kept sorted next to the samples in arrival order: a new sample
+// replaces the oldest with two binary searches and a move of at most the
+// window. With the short windows of the sensors, this beats the heaps and the
+// skip lists, which also need more memory.
+template <class T, uint16_t WindowSize>
+class MovingMedian
+{
+    static_assert(WindowSize > 0, "A MovingMedian needs a window");
+
+  public:
+    void AddSample(T sample)
+    {
+        T *end = _sorted + _count;
+        if (_count == WindowSize)
+        {
+            // Out with the oldest, the window keeps its size
+            T *oldest = std::lower_bound(_sorted, end, _values[_position]);
+            std::copy(oldest + 1, end, oldest);
+            end--;
+        }
+        else
+        {
+            _count++;
+        }
+
+        T *insertion = std::upper_bound(_sorted, end, sample);
+        std::copy_backward(insertion, end, end + 1);
+        *insertion = sample;
+
+        _values[_position] = sample;
+        _position = _position + 1 == WindowSize ? 0 : _position + 1;
+    }
+
+    // Mean of the two middle samples for an even count, 0 without samples
+    double GetMedian() const
+    {
+        if (_count == 0)
+        {
+            return 0.0;
+        }
+        const uint16_t middle = _count / 2;
+        return _count % 2 ? static_cast<double>(_sorted[middle]) : (static_cast<double>(_sorted[middle - 1]) + _sorted[middle]) / 2;
+    }
+
+    uint16_t GetCount() const { return _count; }
+    bool IsFilled() const { return _count == WindowSize; }
+
+    void Reset()
+    {
+        _count = 0;
+        _position = 0;
+    }
+
+  private:
+    T _values[WindowSize]; // In arrival order
+    T _sorted[WindowSize];
+    uint16_t _count = 0;
+    uint16_t _position = 0;
+};
+
+// Prints the cost per sample of each filter, and of the MovingAverage it
+// replaced
+void BenchmarkFilters();
+
+#endif // FILTERS_H
@@ -7,7 +7,6 @@
 class FixedImu : public Imu
 {
   public:
-    double GetXAcceleration();
     static FixedImu *GetInstance()
     {
         static FixedImu instance;
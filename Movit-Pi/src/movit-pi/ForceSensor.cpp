@@ -3,47 +3,50 @@
 // Description
 //---------------------------------------------------------------------------------------
 
-#include "MAX11611.h"    //10-Bit ADC
 #include "ForceSensor.h" //variables and modules initialisation
-#include "GlobalForcePlate.h"
+#include "SysTime.h"
 
 #include <stdio.h>
 #include <unistd.h>
 
 ForceSensor::ForceSensor()
 {
-    for (uint8_t i = 0; i < PRESSURE_SENSOR_COUNT; i++)
-    {
-        _analogData[i] = 0;
-        _analogOffset[i] = 0;
-    }
-    _totalSensorMean = 0;
-    _detectionThreshold = 0;
+    SetSensorCount(DEFAULT_PRESSURE_SENSOR_COUNT);
 }
 
 ForceSensor::~ForceSensor() {}
 
+void ForceSensor::SetSensorCount(uint16_t sensorCount)
+{
+    _analogData.assign(sensorCount, 0);
+    _analogOffset.assign(sensorCount, 0);
+    _totalSensorMean = 0;
+    _detectionThreshold = 0;
+    _presence.Get<0>().Configure(_detectionThreshold);
+}
+
 pressure_mat_offset_t ForceSensor::GetOffsets()
 {
     pressure_mat_offset_t ret;
 
-    for (int i = 0; i < PRESSURE_SENSOR_COUNT; i++)
-    {
-        ret.analogOffset[i] = _analogOffset[i];
-    }
+    ret.analogOffset = _analogOffset;
     ret.detectionThreshold = _detectionThreshold;
     ret.totalSensorMean = _totalSensorMean;
 
     return ret;
 }
 
+// The offsets of a mat of another size are ignored, it needs a calibration
 void ForceSensor::SetOffsets(pressure_mat_offset_t offset)
 {
-    for (int i = 0; i < PRESSURE_SENSOR_COUNT; i++)
+    if (offset.analogOffset.size() != _analogOffset.size())
     {
-        _analogOffset[i] = offset.analogOffset[i];
+        return;
     }
+
+    _analogOffset = offset.analogOffset;
     _detectionThreshold = offset.detectionThreshold;
+    _presence.Get<0>().Configure(_detectionThreshold);
     _totalSensorMean = offset.totalSensorMean;
 }
 
@@ -52,7 +55,7 @@ void ForceSensor::SetOffsets(pressure_mat_offset_t offset)
 //Force sensor individual calibration - establish initial offset
 //Used by presence detection and center of pressure displacement functions
 //---------------------------------------------------------------------------------------
-void ForceSensor::CalibrateForceSensor(MAX11611 &max11611, uint16_t *max11611Data, uint8_t maxIterations)
+void ForceSensor::CalibrateForceSensor(std::function<void()> acquire)
 {
     /***************************** FRS MAP *****************************/
     /* FRONT LEFT                                          FRONT RIGHT */
@@ -60,53 +63,33 @@ void ForceSensor::CalibrateForceSensor(MAX11611 &max11611, uint16_t *max11611Dat
     /* max11611Data[8]         max11611Data[5]         max11611Data[2] */
     /* max11611Data[9]         max11611Data[6]         max11611Data[3] */
     /*******************************************************************/
-    if (!maxIterations)
-    {
-        printf("Error: Invalid iteration number.\n");
-        return;
-    }
-
     const float calibrationRatio = 0.75;
-    uint16_t sensorMean[PRESSURE_SENSOR_COUNT]; //Individual iterations sensors mean
-    _totalSensorMean = 0;                       //Final sensors analog data reading mean
-
-    //Sensor mean table initialization
-    for (uint8_t i = 0; i < PRESSURE_SENSOR_COUNT; i++)
-    {
-        sensorMean[i] = 0;
-    }
+    std::vector<MovingAverage<uint16_t, PRESSURE_CALIBRATION_ITERATIONS>> sensorMean(_analogData.size()); //Individual iterations sensors mean
+    _totalSensorMean = 0;                                                                                 //Final sensors analog data reading mean
 
     //Mean generation for calibration operation
-    for (uint8_t i = 0; i < maxIterations; i++)
+    for (uint8_t i = 0; i < PRESSURE_CALIBRATION_ITERATIONS; i++)
     {
         //Update sensor analog data readings
-        printf("\n%i ", (maxIterations - i));
-        _max11611.GetData(PRESSURE_SENSOR_COUNT, _max11611Data);
-        for (uint8_t i = 0; i < PRESSURE_SENSOR_COUNT; i++)
-        {
-            SetAnalogData(i, _max11611Data[i]);
-        }
+        printf("\n%i ", (PRESSURE_CALIBRATION_ITERATIONS - i));
+        acquire();
         //Force analog data readings mean
-        for (uint8_t j = 0; j < PRESSURE_SENSOR_COUNT; j++)
+        for (uint16_t j = 0; j < sensorMean.size(); j++)
         {
-            sensorMean[j] += GetAnalogData(j);
-
-            if (i == maxIterations - 1)
-            {
-                sensorMean[j] /= maxIterations;
-            }
+            sensorMean[j].AddSample(GetAnalogData(j));
         }
-        delay(1000);
+        sleep_for_milliseconds(1000);
     }
 
     //Total sensors analog data readings mean
-    for (uint8_t i = 0; i < PRESSURE_SENSOR_COUNT; i++)
+    for (uint16_t i = 0; i < sensorMean.size(); i++)
     {
-        _analogOffset[i] = sensorMean[i];
-        _totalSensorMean += sensorMean[i];
+        _analogOffset[i] = static_cast<uint16_t>(sensorMean[i].GetAverage());
+        _totalSensorMean += _analogOffset[i];
     }
-    _totalSensorMean /= maxIterations;
+    _totalSensorMean /= PRESSURE_CALIBRATION_ITERATIONS;
     _detectionThreshold = calibrationRatio * _totalSensorMean;
+    _presence.Get<0>().Configure(_detectionThreshold);
     printf("\ntotalmeansen = %i \n", _totalSensorMean);
     printf("\ndetectionThreshold = %f\n", _detectionThreshold);
 
@@ -128,30 +111,10 @@ bool ForceSensor::IsUserDetected()
 
     //Total of all sensors reading analog data
     float sensedPresence = 0;
-    for (uint8_t i = 0; i < PRESSURE_SENSOR_COUNT; i++)
-    {
-        sensedPresence += static_cast<float>(_analogData[i]);
-    }
-    if (!PRESSURE_SENSOR_COUNT)
+    for (uint16_t analogData : _analogData)
     {
-        sensedPresence /= PRESSURE_SENSOR_COUNT;
+        sensedPresence += static_cast<float>(analogData);
     }
-    return sensedPresence > _detectionThreshold;
-}
-
-uint16_t ForceSensor::GetAnalogData(uint8_t index)
-{
-    //Rearrange analog data to fix a hardware problem.
-    uint16_t rearrangedAnalogData[PRESSURE_SENSOR_COUNT];
-    rearrangedAnalogData[0] = _analogData[5];
-    rearrangedAnalogData[1] = _analogData[7];
-    rearrangedAnalogData[2] = _analogData[6];
-    rearrangedAnalogData[3] = _analogData[2];
-    rearrangedAnalogData[4] = _analogData[4];
-    rearrangedAnalogData[5] = _analogData[3];
-    rearrangedAnalogData[6] = _analogData[1];
-    rearrangedAnalogData[7] = _analogData[0];
-    rearrangedAnalogData[8] = _analogData[8];
-
-    return rearrangedAnalogData[index];
+    _presence.Push(sensedPresence);
+    return _presence.Get<1>().GetValue() > 0;
 }
@@ -1,9 +1,14 @@
 #ifndef FORCE_SENSOR_H
 #define FORCE_SENSOR_H
 
-#include "MAX11611.h"
 #include "Utils.h"
 #include "DataType.h"
+#include "Pipeline.h"
+
+#include <functional>
+#include <vector>
+
+#define PRESSURE_CALIBRATION_ITERATIONS 10 // Measures, 1 s apart, in the calibration mean
 
 class ForceSensor
 {
@@ -11,24 +16,28 @@ class ForceSensor
     ForceSensor();
     ~ForceSensor();
 
-    void CalibrateForceSensor(MAX11611 &max11611, uint16_t *max11611Data, uint8_t maxIteration);
+    // acquire() sets the analog data of the next calibration measure
+    void CalibrateForceSensor(std::function<void()> acquire);
     bool IsUserDetected();
 
     pressure_mat_offset_t GetOffsets();
-    uint16_t GetAnalogData(uint8_t index);
 
     void SetOffsets(pressure_mat_offset_t offset);
-    void SetAnalogData(uint8_t index, uint16_t analogdata) { _analogData[index] = analogdata; }
+    // In the logical order, the hardware channels are remapped when acquired
+    uint16_t GetAnalogData(uint16_t index) { return _analogData[index]; }
+    void SetAnalogData(uint16_t index, uint16_t analogdata) { _analogData[index] = analogdata; }
 
-  private:
-    uint16_t _analogData[PRESSURE_SENSOR_COUNT];
-    uint16_t _analogOffset[PRESSURE_SENSOR_COUNT];
+    // Clears the data and the offsets of the previous mat
+    void SetSensorCount(uint16_t sensorCount);
+    uint16_t GetSensorCount() { return static_cast<uint16_t>(_analogData.size()); }
 
-    MAX11611 _max11611;
-    uint16_t _max11611Data[PRESSURE_SENSOR_COUNT];
+  private:
+    std::vector<uint16_t> _analogData;
+    std::vector<uint16_t> _analogOffset;
     uint32_t _totalSensorMean;
 
     float _detectionThreshold;
+    Pipeline<Threshold, Hold> _presence; // Total of the sensors to seated or not
 };
 
 #endif // FORCE_SENSOR_H
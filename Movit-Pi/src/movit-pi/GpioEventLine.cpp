@@ -0,0 +1,58 @@
+#include "GpioEventLine.h"
+#include "LinuxGpioEventLine.h"
+#include "SimGpioEventLine.h"
+
+#include <algorithm>
+#include <chrono>
+#include <errno.h>
+
+#ifdef MOVIT_SIM
+GpioBackendType selectedGpioBackend = simGpioBackend;
+#else
+GpioBackendType selectedGpioBackend = gpiochipBackend;
+#endif
+std::string selectedGpioChip = GPIO_DEFAULT_CHIP;
+
+/** Choose the GPIO backend.
+ * @param backendType gpiochipBackend (default, simGpioBackend in the
+ * simulation build) or simGpioBackend
+ * @param chip Character device of the GPIO chip, only used by gpiochipBackend
+ */
+void GpioEventLine::SelectBackend(GpioBackendType backendType, std::string chip)
+{
+    selectedGpioBackend = backendType;
+    selectedGpioChip = chip;
+}
+
+std::unique_ptr<GpioEventLine> GpioEventLine::Create(unsigned line)
+{
+    if (selectedGpioBackend == simGpioBackend)
+    {
+        return std::unique_ptr<GpioEventLine>(new SimGpioEventLine(line));
+    }
+    return std::unique_ptr<GpioEventLine>(new LinuxGpioEventLine(selectedGpioChip, line));
+}
+
+/** Wait for events on file descriptors, ignoring the signals.
+ * The signal handlers of main.cpp (SIGINT, SIGUSR1) can run on any thread,
+ * including a thread blocked in Wait().
+ * @param timeoutMs Total timeout, negative to wait forever
+ * @return Return value of the last poll()
+ */
+int GpioEventLine::PollWithoutInterruption(struct pollfd *fds, nfds_t count, int timeoutMs)
+{
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+    int remainingMs = timeoutMs;
+    while (true)
+    {
+        int result = poll(fds, count, remainingMs);
+        if (result >= 0 || errno != EINTR)
+        {
+            return result;
+        }
+        if (timeoutMs >= 0)
+        {
+            remainingMs = static_cast<int>(std::max<int64_t>(0, std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now()).count()));
+        }
+    }
+}
@@ -0,0 +1,55 @@
+#ifndef GPIO_EVENT_LINE_H
+#define GPIO_EVENT_LINE_H
+
+#include <memory>
+#include <poll.h>
+#include <stdint.h>
+#include <string>
+
+#define GPIO_DEFAULT_CHIP "/dev/gpiochip0"
+
+// INT pins of the IMUs on the MOvIT board (BCM numbering)
+#define FIXED_IMU_INTERRUPT_LINE 17
+#define MOBILE_IMU_INTERRUPT_LINE 27
+
+enum GpioBackendType
+{
+    gpiochipBackend,
+    simGpioBackend
+};
+
+enum GpioWaitResult
+{
+    gpioEdge,
+    gpioTimeout,
+    gpioError
+};
+
+// Rising edges of a GPIO input. The waiting thread sleeps in the kernel until
+// an edge, it never polls the line.
+class GpioEventLine
+{
+  public:
+    virtual ~GpioEventLine() = default;
+
+    virtual bool Open() = 0;
+    virtual void Close() = 0;
+
+    // Blocks until the next rising edge, or the timeout. Edges that occurred
+    // since the previous call are returned at once, as a single edge.
+    // @param timestamp Steady clock time of the wake-up, in microseconds
+    virtual GpioWaitResult Wait(int timeoutMs, uint64_t &timestamp) = 0;
+    // Makes the Wait() in progress, and the next ones, return gpioError
+    virtual void Interrupt() = 0;
+
+    // Must be called before Create() to have any effect
+    static void SelectBackend(GpioBackendType backendType, std::string chip);
+    static std::unique_ptr<GpioEventLine> Create(unsigned line);
+
+  protected:
+    // poll() that is restarted with the remaining timeout when a signal
+    // handler interrupts it, SA_RESTART does not apply to poll()
+    static int PollWithoutInterruption(struct pollfd *fds, nfds_t count, int timeoutMs);
+};
+
+#endif // GPIO_EVENT_LINE_H
@@ -28,17 +28,253 @@ THE SOFTWARE.
 */
 
 #include "I2Cdev.h"
+#include "BusStatistics.h"
+#ifndef MOVIT_SIM
+#include "Bcm2835I2cBackend.h"
+#endif
+#include "LinuxI2cBackend.h"
+#include "MPU6050.h"
+#include "RecordingI2cBackend.h"
+#include "ReplayI2cBackend.h"
+#include "SimI2cBackend.h"
 #include <stdio.h>
+#include <algorithm>
+#include <chrono>
+#include <memory>
 #include <mutex>
+#include <vector>
 
-std::mutex mutex;
+#define I2C_BENCHMARK_TRANSACTION_COUNT 2000
+#define I2C_BENCHMARK_BURST_LENGTH 14 // Accelerometer, temperature and gyroscope of an MPU6050
 
-I2Cdev::I2Cdev() {}
+struct i2c_bus_config_t
+{
+    bool isSelected;
+    I2cBackendType backendType;
+    std::string device;
+};
+
+#ifdef MOVIT_SIM
+#define I2C_DEFAULT_BACKEND simBackend
+#else
+#define I2C_DEFAULT_BACKEND bcm2835Backend
+#endif
+
+i2c_bus_config_t busConfigs[busCount] = {{true, I2C_DEFAULT_BACKEND, LINUX_I2C_DEFAULT_DEVICE},
+                                         {false, linuxI2cDevBackend, LINUX_I2C_DEFAULT_DEVICE}};
+std::unique_ptr<I2Cdev> buses[busCount];
+std::mutex busesMutex;
+std::shared_ptr<TrafficRecorder> i2cRecorder;
+
+static std::unique_ptr<I2cBackend> CreateBackend(I2cBusId busId, I2cBackendType backendType, std::string device)
+{
+    if (backendType == linuxI2cDevBackend)
+    {
+        return std::unique_ptr<I2cBackend>(new LinuxI2cBackend(device));
+    }
+    if (backendType == replayBackend)
+    {
+        return std::unique_ptr<I2cBackend>(new ReplayI2cBackend(device, busId));
+    }
+#ifndef MOVIT_SIM
+    if (backendType == bcm2835Backend)
+    {
+        return std::unique_ptr<I2cBackend>(new Bcm2835I2cBackend(I2C_BAUDRATE));
+    }
+#endif
+    return std::unique_ptr<I2cBackend>(new SimI2cBackend());
+}
+
+// Buses that were not selected, or that use the same device as the sensor
+// bus, share the sensor bus instance. Replayed buses each follow their own
+// records, even when they come from the same capture.
+static I2cBusId ResolveBus(I2cBusId busId)
+{
+    const i2c_bus_config_t &config = busConfigs[busId];
+    const i2c_bus_config_t &sensorConfig = busConfigs[sensorBus];
+    if (busId != sensorBus && (!config.isSelected || (config.backendType != replayBackend && config.backendType == sensorConfig.backendType && config.device == sensorConfig.device)))
+    {
+        return sensorBus;
+    }
+    return busId;
+}
+
+I2Cdev::I2Cdev(I2cBusId busId, I2cBackendType backendType, std::string device) : _busId(busId), _backendType(backendType), _device(device)
+{
+    // The muxes may have kept a channel connected since the previous run
+    for (uint8_t mux = 0; mux < TCA9548A_COUNT; mux++)
+    {
+        _muxSelections[mux] = TCA9548A_ALL_CHANNELS;
+    }
+}
+
+I2Cdev::I2Cdev(I2Cdev *parent, uint8_t muxAddress, uint8_t muxChannel) : I2Cdev(parent->_busId, parent->_backendType, parent->_device)
+{
+    _parent = parent;
+    _muxAddress = muxAddress;
+    _muxChannel = muxChannel;
+}
+
+I2Cdev::~I2Cdev()
+{
+    _scheduler.Stop();
+}
+
+/** Choose the backend of a bus. Must be called before the devices are created
+ * and before Initialize() to have any effect.
+ * Only the sensor bus can use the bcm2835 library, which drives a single BSC,
+ * and the simulated devices, which the other buses reach through aliasing.
+ * @param busId Bus to configure
+ * @param backendType bcm2835Backend (default, simBackend in the simulation
+ * build), linuxI2cDevBackend, replayBackend or simBackend
+ * @param device i2c-dev character device, or capture file for replayBackend
+ */
+void I2Cdev::SelectBackend(I2cBusId busId, I2cBackendType backendType, std::string device)
+{
+    std::lock_guard<std::mutex> lock(busesMutex);
+
+    if (busId != sensorBus && backendType == bcm2835Backend)
+    {
+        printf("Error: Only the sensor bus can use the bcm2835 backend\n");
+        return;
+    }
+    if (busId != sensorBus && backendType == simBackend)
+    {
+        printf("Error: Only the sensor bus can use the simulated devices\n");
+        return;
+    }
+#ifdef MOVIT_SIM
+    if (backendType == bcm2835Backend)
+    {
+        printf("Error: The bcm2835 backend is not available in the simulation build\n");
+        return;
+    }
+#endif
+    busConfigs[busId] = {true, backendType, device};
+}
+
+/** Get the instance handling a bus, creating it on first use.
+ * @param busId Bus used by the device
+ * @return Bus instance, shared by every device on the same bus
+ */
+I2Cdev *I2Cdev::GetBus(I2cBusId busId)
+{
+    std::lock_guard<std::mutex> lock(busesMutex);
+
+    busId = ResolveBus(busId);
+    if (!buses[busId])
+    {
+        buses[busId].reset(new I2Cdev(busId, busConfigs[busId].backendType, busConfigs[busId].device));
+    }
+    return buses[busId].get();
+}
+
+/** Log the traffic of every bus to a capture. Must be called before
+ * Initialize() to have any effect.
+ * @param recorder Capture shared by all the buses and the SPI bus
+ */
+void I2Cdev::SetRecorder(std::shared_ptr<TrafficRecorder> recorder)
+{
+    std::lock_guard<std::mutex> lock(busesMutex);
+    i2cRecorder = recorder;
+}
 
 void I2Cdev::Initialize()
 {
+#ifndef MOVIT_SIM
+    // The bcm2835 library is still needed by the SPI and GPIO users
     bcm2835_init();
-    bcm2835_i2c_set_baudrate(I2C_BAUDRATE);
+#endif
+
+    OpenBuses();
+}
+
+/** Open the buses that are not open yet, the failed ones are retried.
+ * @return Status of the operation (true = every bus is open)
+ */
+bool I2Cdev::OpenBuses()
+{
+    bool isOpen = true;
+    for (uint8_t busId = 0; busId < busCount; busId++)
+    {
+        isOpen = GetBus(static_cast<I2cBusId>(busId))->Open() && isOpen;
+    }
+    return isOpen;
+}
+
+/** Open the bus backend and start the bus thread. Does nothing if the bus is
+ * already open. On failure, the bus is left closed and its transfers fail.
+ * @return Status of the operation (true = success)
+ */
+bool I2Cdev::Open()
+{
+    if (_parent != nullptr)
+    {
+        return _parent->Open();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        if (_backend)
+        {
+            return true;
+        }
+
+        _backend = CreateBackend(_busId, _backendType, _device);
+
+        std::shared_ptr<TrafficRecorder> recorder;
+        {
+            std::lock_guard<std::mutex> busesLock(busesMutex);
+            recorder = i2cRecorder;
+        }
+        if (recorder)
+        {
+            _backend.reset(new RecordingI2cBackend(std::move(_backend), recorder, _busId));
+        }
+
+        if (!_backend->Open())
+        {
+            printf("Error: Unable to open the I2C bus %s\n", _device.c_str());
+            // The next Open() creates the backend again
+            _backend.reset();
+            return false;
+        }
+    }
+
+    _scheduler.Start();
+    return true;
+}
+
+/** Get the instance accessing the devices behind a channel of a TCA9548A on
+ * this bus, creating it on first use. Devices are then addressed by their
+ * channel and their own address, so several devices can share an address.
+ * @param channel Channel of the mux (0-7)
+ * @param muxAddress Address of the mux (0x70-0x77)
+ * @return Channel instance, shared by every device on the channel, or nullptr
+ * if the channel does not exist
+ */
+I2Cdev *I2Cdev::GetMuxChannel(uint8_t channel, uint8_t muxAddress)
+{
+    if (_parent != nullptr)
+    {
+        return _parent->GetMuxChannel(channel, muxAddress);
+    }
+
+    if (muxAddress < TCA9548A_BASE_ADDRESS || muxAddress >= TCA9548A_BASE_ADDRESS + TCA9548A_COUNT || channel >= TCA9548A_CHANNEL_COUNT)
+    {
+        printf("Error: Invalid I2C mux channel %i at address 0x%02X\n", channel, muxAddress);
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock(busesMutex);
+
+    std::unique_ptr<I2Cdev> &muxChannel = _muxChannels[muxAddress - TCA9548A_BASE_ADDRESS][channel];
+    if (!muxChannel)
+    {
+        muxChannel.reset(new I2Cdev(this, muxAddress, channel));
+    }
+    return muxChannel.get();
 }
 
 /** Enable or disable I2C,
@@ -46,6 +282,7 @@ void I2Cdev::Initialize()
  */
 void I2Cdev::Enable(bool isEnabled)
 {
+#ifndef MOVIT_SIM
     if (SET_I2C_PINS)
     {
         if (isEnabled)
@@ -58,10 +295,380 @@ void I2Cdev::Enable(bool isEnabled)
             bcm2835_i2c_begin();
         }
     }
+#endif
+}
+
+// Runs a bus operation on the thread of this bus, at the priority of the
+// calling thread, and waits for its result. The operation runs in place when
+// called from the bus thread itself or before the bus is opened.
+template <typename Operation>
+bool I2Cdev::RunOnBus(Operation operation)
+{
+    if (_parent != nullptr)
+    {
+        return _parent->RunOnBus(operation);
+    }
+
+    if (_scheduler.IsRunning() && !_scheduler.IsBusThread())
+    {
+        std::future<bool> result = _scheduler.Submit(I2cScheduler::GetThreadPriority(), [&] {
+            std::lock_guard<std::mutex> lock(_mutex);
+            return operation();
+        });
+        return result.get();
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    return operation();
+}
+
+bool I2Cdev::TransferLocked(i2c_segment_t *segments, uint8_t count)
+{
+    if (_parent != nullptr)
+    {
+        return _parent->SelectMuxChannelLocked(_muxAddress, _muxChannel, segments, count) && _parent->TransferBackendLocked(segments, count);
+    }
+    return DeselectConflictingMuxesLocked(TCA9548A_COUNT, segments, count) && TransferBackendLocked(segments, count);
+}
+
+// Connects the channel of a device behind a mux, unless it is already the
+// only connected channel. Called on the bus instance, with its lock held.
+bool I2Cdev::SelectMuxChannelLocked(uint8_t muxAddress, uint8_t muxChannel, i2c_segment_t *segments, uint8_t count)
+{
+    const uint8_t mux = muxAddress - TCA9548A_BASE_ADDRESS;
+    for (uint8_t i = 0; i < count; i++)
+    {
+        _muxDevices[mux][muxChannel].set(segments[i].devAddr % I2C_DEVICE_COUNT);
+    }
+
+    if (!DeselectConflictingMuxesLocked(mux, segments, count))
+    {
+        return false;
+    }
+
+    uint8_t selection = 1 << muxChannel;
+    if (_muxSelections[mux] == selection)
+    {
+        _savedMuxSwitches++;
+        return true;
+    }
+
+    i2c_segment_t segment = {muxAddress, false, &selection, 1};
+    bool response = TransferBackendLocked(&segment, 1);
+    _muxSelections[mux] = response ? selection : TCA9548A_ALL_CHANNELS;
+    _muxSwitches++;
+    return response;
+}
+
+// Disconnects the muxes whose connected channels have a device at the address
+// of a transaction that is not meant for them. Called on the bus instance.
+bool I2Cdev::DeselectConflictingMuxesLocked(uint8_t excludedMux, i2c_segment_t *segments, uint8_t count)
+{
+    for (uint8_t mux = 0; mux < TCA9548A_COUNT; mux++)
+    {
+        if (mux == excludedMux || _muxSelections[mux] == TCA9548A_NO_CHANNEL)
+        {
+            continue;
+        }
+
+        bool isConflicting = false;
+        for (uint8_t channel = 0; channel < TCA9548A_CHANNEL_COUNT && !isConflicting; channel++)
+        {
+            if (!(_muxSelections[mux] & (1 << channel)))
+            {
+                continue;
+            }
+            for (uint8_t i = 0; i < count && !isConflicting; i++)
+            {
+                isConflicting = _muxDevices[mux][channel].test(segments[i].devAddr % I2C_DEVICE_COUNT);
+            }
+        }
+
+        if (isConflicting)
+        {
+            uint8_t selection = TCA9548A_NO_CHANNEL;
+            i2c_segment_t segment = {static_cast<uint8_t>(TCA9548A_BASE_ADDRESS + mux), false, &selection, 1};
+            bool response = TransferBackendLocked(&segment, 1);
+            _muxSelections[mux] = response ? TCA9548A_NO_CHANNEL : TCA9548A_ALL_CHANNELS;
+            _muxSwitches++;
+            if (!response)
+            {
+                return false;
+            }
+        }
+    }
+    return true;
 }
 
-char sendBuf[256];
-char recvBuf[256];
+bool I2Cdev::TransferBackendLocked(i2c_segment_t *segments, uint8_t count)
+{
+    if (!_backend)
+    {
+        return false;
+    }
+    _busOperations++;
+
+    BusOperation operation = busWrite;
+    for (uint8_t i = 0; i < count; i++)
+    {
+        if (segments[i].isRead)
+        {
+            operation = busRead;
+        }
+    }
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    bool response = _backend->Transfer(segments, count);
+    uint32_t elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+    BusStatistics::GetInstance()->Record(_busId, segments[0].devAddr, operation, elapsed, response);
+    return response;
+}
+
+bool I2Cdev::WriteLocked(uint8_t devAddr, uint16_t length)
+{
+    i2c_segment_t segment = {devAddr, false, _sendBuf, length};
+    return TransferLocked(&segment, 1);
+}
+
+bool I2Cdev::ReadRegisterLocked(uint8_t devAddr, uint8_t regAddr, uint16_t length)
+{
+    _sendBuf[0] = regAddr;
+    i2c_segment_t segments[2] = {{devAddr, false, _sendBuf, 1},
+                                 {devAddr, true, _recvBuf, length}};
+    return TransferLocked(segments, 2);
+}
+
+// Reads registers into _recvBuf, from the register cache when all of them are
+// cached. Bus reads refresh the cache, failed ones drop the whole device.
+bool I2Cdev::ReadRegisterCachedLocked(uint8_t devAddr, uint8_t regAddr, uint16_t length)
+{
+    if (_cache.Read(devAddr, regAddr, length, _recvBuf))
+    {
+        Root()->_savedOperations++;
+        return true;
+    }
+
+    bool response = ReadRegisterLocked(devAddr, regAddr, length);
+    if (response)
+    {
+        _cache.Update(devAddr, regAddr, length, _recvBuf);
+    }
+    else
+    {
+        _cache.Invalidate(devAddr);
+    }
+    return response;
+}
+
+// Writes _sendBuf (register address followed by the data) and keeps the
+// register cache in sync with what the device holds.
+bool I2Cdev::WriteRegisterLocked(uint8_t devAddr, uint16_t length)
+{
+    bool response = WriteLocked(devAddr, length);
+    if (response)
+    {
+        _cache.Update(devAddr, _sendBuf[0], length - 1, &_sendBuf[1]);
+    }
+    else
+    {
+        _cache.Invalidate(devAddr);
+    }
+    return response;
+}
+
+/** Declare registers whose value only changes when the host writes them.
+ * Reads of those registers are then served from a shadow copy, and bit
+ * writes to them cost a single bus write.
+ * @param devAddr I2C slave device address
+ * @param regAddr First register of the range
+ * @param count Number of registers in the range
+ */
+void I2Cdev::SetCacheable(uint8_t devAddr, uint8_t regAddr, uint16_t count)
+{
+    std::lock_guard<std::mutex> lock(Root()->_mutex);
+    _cache.SetCacheable(devAddr, regAddr, count, true);
+}
+
+/** Forget the cached registers of a device, for instance after a reset or
+ * before a connection test that must reach the device.
+ * @param devAddr I2C slave device address
+ */
+void I2Cdev::InvalidateCache(uint8_t devAddr)
+{
+    std::lock_guard<std::mutex> lock(Root()->_mutex);
+    _cache.Invalidate(devAddr);
+}
+
+/** Bus operations done and avoided by the register cache since the previous
+ * call. Meant to be called periodically from a single thread.
+ * @return Rates in operations per second
+ */
+i2c_cache_statistics_t I2Cdev::GetCacheStatistics()
+{
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    float elapsed = std::chrono::duration<float>(now - _statisticsStart).count();
+    _statisticsStart = now;
+
+    i2c_cache_statistics_t statistics = {0, 0, 0, 0};
+    if (elapsed > 0)
+    {
+        statistics.busOperationsPerSecond = _busOperations.exchange(0) / elapsed;
+        statistics.savedOperationsPerSecond = _savedOperations.exchange(0) / elapsed;
+        statistics.muxSwitchesPerSecond = _muxSwitches.exchange(0) / elapsed;
+        statistics.savedMuxSwitchesPerSecond = _savedMuxSwitches.exchange(0) / elapsed;
+    }
+    return statistics;
+}
+
+/** Run several write/read segments as one combined transaction.
+ * On the i2c-dev backend the whole transaction is a single kernel call.
+ * @param segments Segments to run in order, separated by repeated starts
+ * @param count Number of segments (not more than I2C_MAX_SEGMENTS)
+ * @return Status of the transaction (true = success)
+ */
+bool I2Cdev::Transfer(i2c_segment_t *segments, uint8_t count)
+{
+    return RunOnBus([&] {
+        // The register layout of raw transfers is unknown
+        for (uint8_t i = 0; i < count; i++)
+        {
+            _cache.Invalidate(segments[i].devAddr);
+        }
+        return TransferLocked(segments, count);
+    });
+}
+
+/** Run a batch of register reads and writes with a single bus lock.
+ * Consecutive operations on the same device are sent as one combined
+ * transaction. If such a transaction fails, its reads are retried one by one
+ * so that the status of each read is known, and its writes are reported failed
+ * without being replayed. Operations behind a mux
+ * are grouped by channel, so that each channel is selected once.
+ * @param batch Operations to run, their status is updated in place
+ * @return True if every operation of the batch succeeded
+ */
+bool I2Cdev::Submit(I2cBatch &batch)
+{
+    return RunOnBus([&] {
+        const uint8_t count = batch.GetCount();
+
+        // Direct operations first, then one channel after the other, each
+        // in the order of the batch
+        auto channelKey = [&](uint8_t index) {
+            const I2cBatch::i2c_operation_t &operation = batch._operations[index];
+            return static_cast<uint16_t>(operation.muxAddress << 8 | operation.muxChannel);
+        };
+        std::vector<uint8_t> order(count);
+        for (uint8_t i = 0; i < count; i++)
+        {
+            order[i] = i;
+        }
+        std::stable_sort(order.begin(), order.end(), [&](uint8_t a, uint8_t b) { return channelKey(a) < channelKey(b); });
+
+        uint8_t first = 0;
+        while (first < count)
+        {
+            const I2cBatch::i2c_operation_t &firstOperation = batch._operations[order[first]];
+            uint8_t groupCount = 0;
+            uint8_t segmentCount = 0;
+
+            while (first + groupCount < count)
+            {
+                const I2cBatch::i2c_operation_t &operation = batch._operations[order[first + groupCount]];
+                if (operation.devAddr != firstOperation.devAddr || channelKey(order[first + groupCount]) != channelKey(order[first]))
+                {
+                    break;
+                }
+
+                uint8_t operationSegments = operation.isRead ? 2 : 1;
+                if (segmentCount + operationSegments > I2C_MAX_SEGMENTS)
+                {
+                    break;
+                }
+                segmentCount += operationSegments;
+                groupCount++;
+            }
+
+            I2Cdev *target = firstOperation.muxAddress == 0 ? this : GetMuxChannel(firstOperation.muxChannel, firstOperation.muxAddress);
+            // The writes of a failed group may have been acknowledged and
+            // applied before the failure, only the reads are sent again
+            if (target != nullptr && !target->TransferOperationsLocked(batch, &order[first], groupCount) && groupCount > 1)
+            {
+                for (uint8_t i = first; i < first + groupCount; i++)
+                {
+                    if (batch._operations[order[i]].isRead)
+                    {
+                        target->TransferOperationsLocked(batch, &order[i], 1);
+                    }
+                }
+            }
+            first += groupCount;
+        }
+
+        return batch.IsSuccessful();
+    });
+}
+
+/** Queue a batch on the bus thread without waiting for it.
+ * @param batch Operations to run, kept alive until the batch is done
+ * @param priority Scheduling priority of the batch
+ * @return Future set to true if every operation of the batch succeeded
+ */
+std::future<bool> I2Cdev::SubmitAsync(std::shared_ptr<I2cBatch> batch, I2cPriority priority)
+{
+    return Root()->_scheduler.Submit(priority, [this, batch] { return Submit(*batch); });
+}
+
+/** Queue a batch on the bus thread and call back when it is done.
+ * The callback runs on the bus thread and must not wait on the bus.
+ * @param batch Operations to run, kept alive until the batch is done
+ * @param priority Scheduling priority of the batch
+ * @param callback Called with true if every operation of the batch succeeded
+ */
+void I2Cdev::SubmitAsync(std::shared_ptr<I2cBatch> batch, I2cPriority priority, std::function<void(bool)> callback)
+{
+    Root()->_scheduler.Submit(priority, [this, batch] { return Submit(*batch); }, callback);
+}
+
+bool I2Cdev::TransferOperationsLocked(I2cBatch &batch, const uint8_t *indices, uint8_t count)
+{
+    i2c_segment_t segments[I2C_MAX_SEGMENTS];
+    uint8_t segmentCount = 0;
+
+    for (uint8_t i = 0; i < count; i++)
+    {
+        I2cBatch::i2c_operation_t &operation = batch._operations[indices[i]];
+        segments[segmentCount++] = {operation.devAddr, false, &batch._sendBuffer[operation.sendOffset], operation.sendLength};
+        if (operation.isRead)
+        {
+            segments[segmentCount++] = {operation.devAddr, true, operation.recvData, operation.recvLength};
+        }
+    }
+
+    bool response = TransferLocked(segments, segmentCount);
+
+    for (uint8_t i = 0; i < count; i++)
+    {
+        I2cBatch::i2c_operation_t &operation = batch._operations[indices[i]];
+        operation.status = response;
+
+        const uint8_t *sendData = &batch._sendBuffer[operation.sendOffset];
+        if (!response)
+        {
+            _cache.Invalidate(operation.devAddr);
+        }
+        else if (operation.isRead)
+        {
+            _cache.Update(operation.devAddr, sendData[0], operation.recvLength, operation.recvData);
+        }
+        else
+        {
+            _cache.Update(operation.devAddr, sendData[0], operation.sendLength - 1, &sendData[1]);
+        }
+    }
+    return response;
+}
 
 /** Read a single bit from an 8-bit device register.
  * @param devAddr I2C slave device address
@@ -72,13 +679,11 @@ char recvBuf[256];
  */
 bool I2Cdev::ReadBit(uint8_t devAddr, uint8_t regAddr, uint8_t bitNum, uint8_t *data)
 {
-    std::lock_guard<std::mutex> lock(mutex);
-
-    bcm2835_i2c_setSlaveAddress(devAddr);
-    sendBuf[0] = regAddr;
-    uint8_t response = bcm2835_i2c_write_read_rs(sendBuf, 1, recvBuf, 1);
-    *data = recvBuf[1] & (1 << bitNum);
-    return response == BCM2835_I2C_REASON_OK;
+    return RunOnBus([&] {
+        bool response = ReadRegisterCachedLocked(devAddr, regAddr, 1);
+        *data = _recvBuf[0] & (1 << bitNum);
+        return response;
+    });
 }
 
 /** Read multiple bits from an 8-bit device register.
@@ -91,25 +696,23 @@ bool I2Cdev::ReadBit(uint8_t devAddr, uint8_t regAddr, uint8_t bitNum, uint8_t *
  */
 bool I2Cdev::ReadBits(uint8_t devAddr, uint8_t regAddr, uint8_t bitStart, uint8_t length, uint8_t *data)
 {
-    std::lock_guard<std::mutex> lock(mutex);
-
-    // 01101001 read byte
-    // 76543210 bit numbers
-    //    xxx   args: bitStart=4, length=3
-    //    010   masked
-    //   -> 010 shifted
-    bcm2835_i2c_setSlaveAddress(devAddr);
-    sendBuf[0] = regAddr;
-    uint8_t response = bcm2835_i2c_write_read_rs(sendBuf, 1, recvBuf, 1);
-    uint8_t b = (uint8_t)recvBuf[0];
-    if (response == BCM2835_I2C_REASON_OK)
-    {
-        uint8_t mask = ((1 << length) - 1) << (bitStart - length + 1);
-        b &= mask;
-        b >>= (bitStart - length + 1);
-        *data = b;
-    }
-    return response == BCM2835_I2C_REASON_OK;
+    return RunOnBus([&] {
+        // 01101001 read byte
+        // 76543210 bit numbers
+        //    xxx   args: bitStart=4, length=3
+        //    010   masked
+        //   -> 010 shifted
+        bool response = ReadRegisterCachedLocked(devAddr, regAddr, 1);
+        uint8_t b = _recvBuf[0];
+        if (response)
+        {
+            uint8_t mask = ((1 << length) - 1) << (bitStart - length + 1);
+            b &= mask;
+            b >>= (bitStart - length + 1);
+            *data = b;
+        }
+        return response;
+    });
 }
 
 /** Read single byte from an 8-bit device register.
@@ -120,13 +723,11 @@ bool I2Cdev::ReadBits(uint8_t devAddr, uint8_t regAddr, uint8_t bitStart, uint8_
  */
 bool I2Cdev::ReadByte(uint8_t devAddr, uint8_t regAddr, uint8_t *data)
 {
-    std::lock_guard<std::mutex> lock(mutex);
-
-    bcm2835_i2c_setSlaveAddress(devAddr);
-    sendBuf[0] = regAddr;
-    uint8_t response = bcm2835_i2c_write_read_rs(sendBuf, 1, recvBuf, 1);
-    data[0] = (uint8_t)recvBuf[0];
-    return response == BCM2835_I2C_REASON_OK;
+    return RunOnBus([&] {
+        bool response = ReadRegisterCachedLocked(devAddr, regAddr, 1);
+        data[0] = _recvBuf[0];
+        return response;
+    });
 }
 
 /** Read multiple bytes from an 8-bit device register.
@@ -138,32 +739,29 @@ bool I2Cdev::ReadByte(uint8_t devAddr, uint8_t regAddr, uint8_t *data)
  */
 bool I2Cdev::ReadBytes(uint8_t devAddr, uint8_t regAddr, uint8_t length, uint8_t *data)
 {
-    std::lock_guard<std::mutex> lock(mutex);
-
-    bcm2835_i2c_setSlaveAddress(devAddr);
-    sendBuf[0] = regAddr;
-    uint8_t response = bcm2835_i2c_write_read_rs(sendBuf, 1, recvBuf, length);
+    return RunOnBus([&] {
+        bool response = ReadRegisterCachedLocked(devAddr, regAddr, length);
 
-    for (uint8_t i = 0; i < length; i++)
-    {
-        data[i] = (uint8_t)recvBuf[i];
-    }
-    return response == BCM2835_I2C_REASON_OK;
+        for (uint8_t i = 0; i < length; i++)
+        {
+            data[i] = _recvBuf[i];
+        }
+        return response;
+    });
 }
 
 bool I2Cdev::ReadBytes(uint8_t devAddr, uint8_t length, uint8_t *data)
 {
-    std::lock_guard<std::mutex> lock(mutex);
-
-    bcm2835_i2c_setSlaveAddress(devAddr);
-    // sendBuf[0] = regAddr;
-    uint8_t response = bcm2835_i2c_read(recvBuf, length);
+    return RunOnBus([&] {
+        i2c_segment_t segment = {devAddr, true, _recvBuf, length};
+        bool response = TransferLocked(&segment, 1);
 
-    for (uint8_t i = 0; i < length; i++)
-    {
-        data[i] = (uint8_t)recvBuf[i];
-    }
-    return response == BCM2835_I2C_REASON_OK;
+        for (uint8_t i = 0; i < length; i++)
+        {
+            data[i] = _recvBuf[i];
+        }
+        return response;
+    });
 }
 
 /** write a single bit in an 8-bit device register.
@@ -175,20 +773,18 @@ bool I2Cdev::ReadBytes(uint8_t devAddr, uint8_t length, uint8_t *data)
  */
 bool I2Cdev::WriteBit(uint8_t devAddr, uint8_t regAddr, uint8_t bitNum, uint8_t data)
 {
-    std::lock_guard<std::mutex> lock(mutex);
-
-    bcm2835_i2c_setSlaveAddress(devAddr);
-    //first reading registery value
-    sendBuf[0] = regAddr;
-    uint8_t response = bcm2835_i2c_write_read_rs(sendBuf, 1, recvBuf, 1);
-    if (response == BCM2835_I2C_REASON_OK)
-    {
-        uint8_t b = recvBuf[0];
-        b = (data != 0) ? (b | (1 << bitNum)) : (b & ~(1 << bitNum));
-        sendBuf[1] = b;
-        response = bcm2835_i2c_write(sendBuf, 2);
-    }
-    return response == BCM2835_I2C_REASON_OK;
+    return RunOnBus([&] {
+        //first reading registery value
+        bool response = ReadRegisterCachedLocked(devAddr, regAddr, 1);
+        if (response)
+        {
+            uint8_t b = _recvBuf[0];
+            b = (data != 0) ? (b | (1 << bitNum)) : (b & ~(1 << bitNum));
+            _sendBuf[1] = b;
+            response = WriteRegisterLocked(devAddr, 2);
+        }
+        return response;
+    });
 }
 
 /** Write multiple bits in an 8-bit device register.
@@ -201,31 +797,29 @@ bool I2Cdev::WriteBit(uint8_t devAddr, uint8_t regAddr, uint8_t bitNum, uint8_t
  */
 bool I2Cdev::WriteBits(uint8_t devAddr, uint8_t regAddr, uint8_t bitStart, uint8_t length, uint8_t data)
 {
-    std::lock_guard<std::mutex> lock(mutex);
-
-    // 010 value to write
-    // 76543210 bit numbers
-    // xxx args: bitStart=4, length=3
-    // 00011100 mask byte
-    // 10101111 original value (sample)
-    // 10100011 original & ~mask
-    // 10101011 masked | value
-    bcm2835_i2c_setSlaveAddress(devAddr);
-    //first reading registery value
-    sendBuf[0] = regAddr;
-    uint8_t response = bcm2835_i2c_write_read_rs(sendBuf, 1, recvBuf, 1);
-    if (response == BCM2835_I2C_REASON_OK)
-    {
-        uint8_t b = recvBuf[0];
-        uint8_t mask = ((1 << length) - 1) << (bitStart - length + 1);
-        data <<= (bitStart - length + 1); // shift data into correct position
-        data &= mask;                     // zero all non-important bits in data
-        b &= ~(mask);                     // zero all important bits in existing byte
-        b |= data;                        // combine data with existing byte
-        sendBuf[1] = b;
-        response = bcm2835_i2c_write(sendBuf, 2);
-    }
-    return response == BCM2835_I2C_REASON_OK;
+    return RunOnBus([&] {
+        // 010 value to write
+        // 76543210 bit numbers
+        // xxx args: bitStart=4, length=3
+        // 00011100 mask byte
+        // 10101111 original value (sample)
+        // 10100011 original & ~mask
+        // 10101011 masked | value
+        //first reading registery value
+        bool response = ReadRegisterCachedLocked(devAddr, regAddr, 1);
+        if (response)
+        {
+            uint8_t b = _recvBuf[0];
+            uint8_t mask = ((1 << length) - 1) << (bitStart - length + 1);
+            data <<= (bitStart - length + 1); // shift data into correct position
+            data &= mask;                     // zero all non-important bits in data
+            b &= ~(mask);                     // zero all important bits in existing byte
+            b |= data;                        // combine data with existing byte
+            _sendBuf[1] = b;
+            response = WriteRegisterLocked(devAddr, 2);
+        }
+        return response;
+    });
 }
 
 /** Write single byte to an 8-bit device register.
@@ -236,13 +830,11 @@ bool I2Cdev::WriteBits(uint8_t devAddr, uint8_t regAddr, uint8_t bitStart, uint8
  */
 bool I2Cdev::WriteByte(uint8_t devAddr, uint8_t regAddr, uint8_t data)
 {
-    std::lock_guard<std::mutex> lock(mutex);
-
-    bcm2835_i2c_setSlaveAddress(devAddr);
-    sendBuf[0] = regAddr;
-    sendBuf[1] = data;
-    uint8_t response = bcm2835_i2c_write(sendBuf, 2);
-    return response == BCM2835_I2C_REASON_OK;
+    return RunOnBus([&] {
+        _sendBuf[0] = regAddr;
+        _sendBuf[1] = data;
+        return WriteRegisterLocked(devAddr, 2);
+    });
 }
 
 /** Read single word from a 16-bit device register.
@@ -253,13 +845,11 @@ bool I2Cdev::WriteByte(uint8_t devAddr, uint8_t regAddr, uint8_t data)
  */
 bool I2Cdev::ReadWord(uint8_t devAddr, uint8_t regAddr, uint16_t *data)
 {
-    std::lock_guard<std::mutex> lock(mutex);
-
-    bcm2835_i2c_setSlaveAddress(devAddr);
-    sendBuf[0] = regAddr;
-    uint8_t response = bcm2835_i2c_write_read_rs(sendBuf, 1, recvBuf, 2);
-    data[0] = (recvBuf[0] << 8) | recvBuf[1];
-    return response == BCM2835_I2C_REASON_OK;
+    return RunOnBus([&] {
+        bool response = ReadRegisterCachedLocked(devAddr, regAddr, 2);
+        data[0] = (_recvBuf[0] << 8) | _recvBuf[1];
+        return response;
+    });
 }
 
 /** Read multiple words from a 16-bit device register.
@@ -271,69 +861,122 @@ bool I2Cdev::ReadWord(uint8_t devAddr, uint8_t regAddr, uint16_t *data)
  */
 bool I2Cdev::ReadWords(uint8_t devAddr, uint8_t regAddr, uint8_t length, uint16_t *data)
 {
-    std::lock_guard<std::mutex> lock(mutex);
+    return RunOnBus([&] {
+        bool response = ReadRegisterCachedLocked(devAddr, regAddr, length * 2);
 
-    bcm2835_i2c_setSlaveAddress(devAddr);
-    sendBuf[0] = regAddr;
-    uint8_t response = bcm2835_i2c_write_read_rs(sendBuf, 1, recvBuf, length * 2);
-
-    for (uint8_t i = 0; i < length; i++)
-    {
-        data[i] = (recvBuf[i * 2] << 8) | recvBuf[i * 2 + 1];
-    }
-    return response == BCM2835_I2C_REASON_OK;
+        for (uint8_t i = 0; i < length; i++)
+        {
+            data[i] = (_recvBuf[i * 2] << 8) | _recvBuf[i * 2 + 1];
+        }
+        return response;
+    });
 }
 
 bool I2Cdev::WriteWord(uint8_t devAddr, uint8_t regAddr, uint16_t data)
 {
-    std::lock_guard<std::mutex> lock(mutex);
-
-    bcm2835_i2c_setSlaveAddress(devAddr);
-    sendBuf[0] = regAddr;
-    sendBuf[1] = (uint8_t)(data >> 8); //MSByte
-    sendBuf[2] = (uint8_t)(data >> 0); //LSByte
-    uint8_t response = bcm2835_i2c_write(sendBuf, 3);
-    return response == BCM2835_I2C_REASON_OK;
+    return RunOnBus([&] {
+        _sendBuf[0] = regAddr;
+        _sendBuf[1] = (uint8_t)(data >> 8); //MSByte
+        _sendBuf[2] = (uint8_t)(data >> 0); //LSByte
+        return WriteRegisterLocked(devAddr, 3);
+    });
 }
 
 bool I2Cdev::WriteBytes(uint8_t devAddr, uint8_t regAddr, uint8_t length, uint8_t *data)
 {
-    std::lock_guard<std::mutex> lock(mutex);
+    return RunOnBus([&] {
+        _sendBuf[0] = regAddr;
 
-    bcm2835_i2c_setSlaveAddress(devAddr);
-    sendBuf[0] = regAddr;
-
-    for (uint8_t i = 0; i < length; i++)
-    {
-        sendBuf[i + 1] = data[i];
-    }
-    uint8_t response = bcm2835_i2c_write(sendBuf, 1 + length);
-    return response == BCM2835_I2C_REASON_OK;
+        for (uint8_t i = 0; i < length; i++)
+        {
+            _sendBuf[i + 1] = data[i];
+        }
+        return WriteRegisterLocked(devAddr, 1 + length);
+    });
 }
 
 bool I2Cdev::WriteByte(uint8_t devAddr, uint8_t data)
 {
-    std::lock_guard<std::mutex> lock(mutex);
-
-    bcm2835_i2c_setSlaveAddress(devAddr);
-    // sendBuf[0] = regAddr;
-    sendBuf[0] = data;
-    uint8_t response = bcm2835_i2c_write(sendBuf, 1);
-    return response == BCM2835_I2C_REASON_OK;
+    return RunOnBus([&] {
+        // Without a register address, the effect on the registers is unknown
+        _cache.Invalidate(devAddr);
+        _sendBuf[0] = data;
+        return WriteLocked(devAddr, 1);
+    });
 }
 
 bool I2Cdev::WriteWords(uint8_t devAddr, uint8_t regAddr, uint8_t length, uint16_t *data)
 {
-    std::lock_guard<std::mutex> lock(mutex);
+    return RunOnBus([&] {
+        _sendBuf[0] = regAddr;
 
-    bcm2835_i2c_setSlaveAddress(devAddr);
-    sendBuf[0] = regAddr;
+        for (uint8_t i = 0; i < length; i++)
+        {
+            _sendBuf[1 + 2 * i] = (uint8_t)(data[i] >> 8); //MSByte
+            _sendBuf[2 + 2 * i] = (uint8_t)(data[i] >> 0); //LSByte
+        }
+        return WriteRegisterLocked(devAddr, 1 + 2 * length);
+    });
+}
 
-    for (uint8_t i = 0; i < length; i++)
+namespace
+{
+// Transactions per second of a register read, the segments of I2Cdev::ReadBytes()
+void BenchmarkI2cBackend(const char *name, I2cBackend &backend, uint8_t regAddr, uint8_t length)
+{
+    uint8_t data[I2C_BENCHMARK_BURST_LENGTH];
+    i2c_segment_t segments[2] = {{MPU6050_DEFAULT_ADDRESS, false, &regAddr, 1}, {MPU6050_DEFAULT_ADDRESS, true, data, length}};
+
+    uint32_t failures = 0;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (uint16_t i = 0; i < I2C_BENCHMARK_TRANSACTION_COUNT; i++)
+    {
+        failures += backend.Transfer(segments, 2) ? 0 : 1;
+    }
+    const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    printf("  %-12s %2i byte read: %8.0f transactions/s, %u failed\n", name, length, I2C_BENCHMARK_TRANSACTION_COUNT / elapsed, failures);
+}
+
+void BenchmarkI2cBackend(const char *name, I2cBackend &backend)
+{
+    if (!backend.Open())
     {
-        sendBuf[1 + 2 * i] = (uint8_t)(data[i] >> 8); //MSByte
-        sendBuf[2 + 2 * i] = (uint8_t)(data[i] >> 0); //LSByte
+        printf("  %-12s unable to open the backend\n", name);
+        return;
     }
-    uint8_t response = bcm2835_i2c_write(sendBuf, 1 + 2 * length);
-    return response == BCM2835_I2C_REASON_OK;
+    BenchmarkI2cBackend(name, backend, MPU6050_RA_WHO_AM_I, 1);
+    BenchmarkI2cBackend(name, backend, MPU6050_RA_ACCEL_XOUT_H, I2C_BENCHMARK_BURST_LENGTH);
+    backend.Close();
+}
+} // namespace
+
+/** Measure the transactions per second of the sensor bus backend against
+ * the bcm2835 library, reading the fixed IMU directly on the backends.
+ * The kernel driver is measured when bcm2835 is the selected backend. A
+ * replayed capture cannot answer other transactions than its own.
+ */
+void BenchmarkI2cBackends()
+{
+    const i2c_bus_config_t &config = busConfigs[sensorBus];
+    printf("I2C backends, %i transactions at 0x%02X:\n", I2C_BENCHMARK_TRANSACTION_COUNT, MPU6050_DEFAULT_ADDRESS);
+    if (config.backendType == replayBackend)
+    {
+        printf("  A replayed capture cannot be benchmarked\n");
+        return;
+    }
+
+#ifdef MOVIT_SIM
+    std::unique_ptr<I2cBackend> backend = CreateBackend(sensorBus, config.backendType, config.device);
+    BenchmarkI2cBackend(config.backendType == linuxI2cDevBackend ? "i2c-dev" : "simulated", *backend);
+    printf("  bcm2835 is not part of the simulation build\n");
+#else
+    // Same setup as Initialize(), the pins stay on the I2C function
+    bcm2835_init();
+    const std::string device = config.backendType == linuxI2cDevBackend ? config.device : LINUX_I2C_DEFAULT_DEVICE;
+    LinuxI2cBackend linuxBackend(device);
+    BenchmarkI2cBackend("i2c-dev", linuxBackend);
+    Bcm2835I2cBackend bcm2835Backend(I2C_BAUDRATE);
+    BenchmarkI2cBackend("bcm2835", bcm2835Backend);
+#endif
 }
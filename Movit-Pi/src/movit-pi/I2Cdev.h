@@ -31,8 +31,19 @@ THE SOFTWARE.
 #define I2CDEV_H
 
 #include "bcm2835.h"
+#include "I2cBackend.h"
+#include "I2cBatch.h"
+#include "I2cRegisterCache.h"
+#include "I2cScheduler.h"
+#include "TCA9548A.h"
+#include "TrafficRecorder.h"
+#include <atomic>
+#include <bitset>
+#include <chrono>
 #include <math.h>
 #include <stdlib.h>
+#include <memory>
+#include <mutex>
 #include <string>
 
 #define SET_I2C_PINS false
@@ -41,29 +52,116 @@ THE SOFTWARE.
 
 #define I2C_BAUDRATE 400000
 
+enum I2cBusId
+{
+    sensorBus = 0, // IMUs, ADC and range sensor
+    peripheralBus, // RTC and alarm I/O expander, shares the sensor bus unless selected
+    busCount
+};
+
+struct i2c_cache_statistics_t
+{
+    float busOperationsPerSecond;
+    float savedOperationsPerSecond;     // served by the register cache
+    float muxSwitchesPerSecond;         // channel selections written to a TCA9548A
+    float savedMuxSwitchesPerSecond;    // accesses to the channel already selected
+};
+
+// One instance per physical bus, each with its own backend, buffers, lock and
+// bus thread. Devices on different buses can be accessed concurrently.
+// Devices behind a TCA9548A are accessed through a mux channel instance, which
+// has its own buffers and register cache but runs on the thread, lock and
+// backend of its bus.
 class I2Cdev
 {
   public:
-    I2Cdev();
+    I2Cdev(I2cBusId busId, I2cBackendType backendType, std::string device);
+    ~I2Cdev();
 
+    static void SelectBackend(I2cBusId busId, I2cBackendType backendType, std::string device);
+    static I2Cdev *GetBus(I2cBusId busId);
+    static void SetRecorder(std::shared_ptr<TrafficRecorder> recorder);
     static void Initialize();
+    static bool OpenBuses();
     static void Enable(bool isEnabled);
 
-    static bool ReadBit(uint8_t devAddr, uint8_t regAddr, uint8_t bitNum, uint8_t *data);
-    static bool ReadBits(uint8_t devAddr, uint8_t regAddr, uint8_t bitStart, uint8_t length, uint8_t *data);
-    static bool ReadByte(uint8_t devAddr, uint8_t regAddr, uint8_t *data);
-    static bool ReadWord(uint8_t devAddr, uint8_t regAddr, uint16_t *data);
-    static bool ReadBytes(uint8_t devAddr, uint8_t length, uint8_t *data);
-    static bool ReadBytes(uint8_t devAddr, uint8_t regAddr, uint8_t length, uint8_t *data);
-    static bool ReadWords(uint8_t devAddr, uint8_t regAddr, uint8_t length, uint16_t *data);
-
-    static bool WriteBit(uint8_t devAddr, uint8_t regAddr, uint8_t bitNum, uint8_t data);
-    static bool WriteBits(uint8_t devAddr, uint8_t regAddr, uint8_t bitStart, uint8_t length, uint8_t data);
-    static bool WriteByte(uint8_t devAddr, uint8_t data);
-    static bool WriteByte(uint8_t devAddr, uint8_t regAddr, uint8_t data);
-    static bool WriteWord(uint8_t devAddr, uint8_t regAddr, uint16_t data);
-    static bool WriteBytes(uint8_t devAddr, uint8_t regAddr, uint8_t length, uint8_t *data);
-    static bool WriteWords(uint8_t devAddr, uint8_t regAddr, uint8_t length, uint16_t *data);
+    bool Open();
+
+    I2Cdev *GetMuxChannel(uint8_t channel, uint8_t muxAddress = TCA9548A_DEFAULT_ADDRESS);
+
+    void SetCacheable(uint8_t devAddr, uint8_t regAddr, uint16_t count = 1);
+    void InvalidateCache(uint8_t devAddr);
+    i2c_cache_statistics_t GetCacheStatistics();
+
+    bool Transfer(i2c_segment_t *segments, uint8_t count);
+    bool Submit(I2cBatch &batch);
+    std::future<bool> SubmitAsync(std::shared_ptr<I2cBatch> batch, I2cPriority priority);
+    void SubmitAsync(std::shared_ptr<I2cBatch> batch, I2cPriority priority, std::function<void(bool)> callback);
+
+    bool ReadBit(uint8_t devAddr, uint8_t regAddr, uint8_t bitNum, uint8_t *data);
+    bool ReadBits(uint8_t devAddr, uint8_t regAddr, uint8_t bitStart, uint8_t length, uint8_t *data);
+    bool ReadByte(uint8_t devAddr, uint8_t regAddr, uint8_t *data);
+    bool ReadWord(uint8_t devAddr, uint8_t regAddr, uint16_t *data);
+    bool ReadBytes(uint8_t devAddr, uint8_t length, uint8_t *data);
+    bool ReadBytes(uint8_t devAddr, uint8_t regAddr, uint8_t length, uint8_t *data);
+    bool ReadWords(uint8_t devAddr, uint8_t regAddr, uint8_t length, uint16_t *data);
+
+    bool WriteBit(uint8_t devAddr, uint8_t regAddr, uint8_t bitNum, uint8_t data);
+    bool WriteBits(uint8_t devAddr, uint8_t regAddr, uint8_t bitStart, uint8_t length, uint8_t data);
+    bool WriteByte(uint8_t devAddr, uint8_t data);
+    bool WriteByte(uint8_t devAddr, uint8_t regAddr, uint8_t data);
+    bool WriteWord(uint8_t devAddr, uint8_t regAddr, uint16_t data);
+    bool WriteBytes(uint8_t devAddr, uint8_t regAddr, uint8_t length, uint8_t *data);
+    bool WriteWords(uint8_t devAddr, uint8_t regAddr, uint8_t length, uint16_t *data);
+
+  private:
+    I2Cdev(I2Cdev *parent, uint8_t muxAddress, uint8_t muxChannel);
+    I2Cdev(const I2Cdev &) = delete;
+    I2Cdev &operator=(const I2Cdev &) = delete;
+
+    I2Cdev *Root() { return _parent != nullptr ? _parent : this; }
+
+    template <typename Operation>
+    bool RunOnBus(Operation operation);
+
+    bool TransferLocked(i2c_segment_t *segments, uint8_t count);
+    bool TransferBackendLocked(i2c_segment_t *segments, uint8_t count);
+    bool SelectMuxChannelLocked(uint8_t muxAddress, uint8_t muxChannel, i2c_segment_t *segments, uint8_t count);
+    bool DeselectConflictingMuxesLocked(uint8_t excludedMux, i2c_segment_t *segments, uint8_t count);
+    bool WriteLocked(uint8_t devAddr, uint16_t length);
+    bool ReadRegisterLocked(uint8_t devAddr, uint8_t regAddr, uint16_t length);
+    bool ReadRegisterCachedLocked(uint8_t devAddr, uint8_t regAddr, uint16_t length);
+    bool WriteRegisterLocked(uint8_t devAddr, uint16_t length);
+    bool TransferOperationsLocked(I2cBatch &batch, const uint8_t *indices, uint8_t count);
+
+    I2cBusId _busId;
+    I2cBackendType _backendType;
+    std::string _device;
+    std::unique_ptr<I2cBackend> _backend;
+    std::mutex _mutex;
+    I2cScheduler _scheduler;
+    I2cRegisterCache _cache;
+
+    // Mux channel instances only
+    I2Cdev *_parent = nullptr;
+    uint8_t _muxAddress = 0;
+    uint8_t _muxChannel = 0;
+
+    // Bus instances only, the mux state is kept under the bus lock
+    std::unique_ptr<I2Cdev> _muxChannels[TCA9548A_COUNT][TCA9548A_CHANNEL_COUNT];
+    uint8_t _muxSelections[TCA9548A_COUNT];                                    // Control register, unknown = every channel
+    std::bitset<I2C_DEVICE_COUNT> _muxDevices[TCA9548A_COUNT][TCA9548A_CHANNEL_COUNT]; // Addresses seen behind each channel
+
+    std::atomic<uint32_t> _busOperations{0};
+    std::atomic<uint32_t> _savedOperations{0};
+    std::atomic<uint32_t> _muxSwitches{0};
+    std::atomic<uint32_t> _savedMuxSwitches{0};
+    std::chrono::steady_clock::time_point _statisticsStart = std::chrono::steady_clock::now();
+
+    uint8_t _sendBuf[256];
+    uint8_t _recvBuf[256];
 };
 
+void BenchmarkI2cBackends();
+
 #endif // I2CDEV_H
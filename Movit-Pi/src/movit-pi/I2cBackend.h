@@ -0,0 +1,39 @@
+#ifndef I2C_BACKEND_H
+#define I2C_BACKEND_H
+
+#include <stdint.h>
+
+#define I2C_MAX_SEGMENTS 42 // Same limit as I2C_RDWR_IOCTL_MAX_MSGS in the kernel
+
+// One segment of an I2C transaction. Consecutive segments of a transfer are
+// separated by a repeated start, and the transfer ends with a single stop.
+struct i2c_segment_t
+{
+    uint8_t devAddr;
+    bool isRead;
+    uint8_t *data;
+    uint16_t length;
+};
+
+enum I2cBackendType
+{
+    bcm2835Backend,
+    linuxI2cDevBackend,
+    replayBackend,
+    simBackend
+};
+
+class I2cBackend
+{
+  public:
+    virtual ~I2cBackend() = default;
+
+    virtual bool Open() = 0;
+    virtual void Close() = 0;
+
+    // Runs all the segments as one combined transaction.
+    // @return Status of the whole transaction (true = success)
+    virtual bool Transfer(i2c_segment_t *segments, uint8_t count) = 0;
+};
+
+#endif // I2C_BACKEND_H
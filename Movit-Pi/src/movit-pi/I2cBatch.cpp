@@ -0,0 +1,77 @@
+#include "I2cBatch.h"
+
+uint8_t I2cBatch::AddOperation(uint8_t devAddr, bool isRead, uint8_t regAddr, uint8_t length, const uint8_t *sendData, uint8_t *recvData)
+{
+    i2c_operation_t operation;
+    operation.muxAddress = _muxAddress;
+    operation.muxChannel = _muxChannel;
+    operation.devAddr = devAddr;
+    operation.isRead = isRead;
+    operation.sendOffset = static_cast<uint16_t>(_sendBuffer.size());
+    operation.sendLength = 1;
+    operation.recvData = recvData;
+    operation.recvLength = isRead ? length : 0;
+    operation.status = false;
+
+    _sendBuffer.push_back(regAddr);
+    if (!isRead)
+    {
+        _sendBuffer.insert(_sendBuffer.end(), sendData, sendData + length);
+        operation.sendLength += length;
+    }
+
+    _operations.push_back(operation);
+    return static_cast<uint8_t>(_operations.size() - 1);
+}
+
+uint8_t I2cBatch::WriteByte(uint8_t devAddr, uint8_t regAddr, uint8_t data)
+{
+    return AddOperation(devAddr, false, regAddr, 1, &data, nullptr);
+}
+
+uint8_t I2cBatch::WriteWord(uint8_t devAddr, uint8_t regAddr, uint16_t data)
+{
+    uint8_t bytes[2] = {static_cast<uint8_t>(data >> 8), static_cast<uint8_t>(data >> 0)}; // MSByte first
+    return AddOperation(devAddr, false, regAddr, 2, bytes, nullptr);
+}
+
+uint8_t I2cBatch::WriteBytes(uint8_t devAddr, uint8_t regAddr, uint8_t length, const uint8_t *data)
+{
+    return AddOperation(devAddr, false, regAddr, length, data, nullptr);
+}
+
+uint8_t I2cBatch::ReadBytes(uint8_t devAddr, uint8_t regAddr, uint8_t length, uint8_t *data)
+{
+    return AddOperation(devAddr, true, regAddr, length, nullptr, data);
+}
+
+void I2cBatch::SetMuxChannel(uint8_t channel, uint8_t muxAddress)
+{
+    _muxAddress = muxAddress;
+    _muxChannel = channel;
+}
+
+void I2cBatch::ClearMuxChannel()
+{
+    _muxAddress = 0;
+    _muxChannel = 0;
+}
+
+void I2cBatch::Clear()
+{
+    _operations.clear();
+    _sendBuffer.clear();
+    ClearMuxChannel();
+}
+
+bool I2cBatch::IsSuccessful()
+{
+    for (const i2c_operation_t &operation : _operations)
+    {
+        if (!operation.status)
+        {
+            return false;
+        }
+    }
+    return true;
+}
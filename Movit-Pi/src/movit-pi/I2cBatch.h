@@ -0,0 +1,63 @@
+#ifndef I2C_BATCH_H
+#define I2C_BATCH_H
+
+#include "TCA9548A.h"
+#include <stdint.h>
+#include <vector>
+
+// List of register reads and writes submitted to the bus as one unit with
+// I2Cdev::Submit(). The bus is locked once for the whole batch, and consecutive
+// operations on the same device are sent as a single combined transaction.
+// When a combined transaction fails, its reads are retried one by one so that
+// each reports its own status, and its writes are reported failed without
+// being sent again: the device may have applied some of them already. Reads
+// that pop a FIFO or clear a status should not be batched with other
+// operations on the same device.
+// Operations behind an I2C multiplexer are grouped by channel, so a batch
+// switches to each channel at most once; the order of the operations is only
+// kept within a channel.
+class I2cBatch
+{
+  public:
+    // Each function returns the index of the operation, to query its status
+    uint8_t WriteByte(uint8_t devAddr, uint8_t regAddr, uint8_t data);
+    uint8_t WriteWord(uint8_t devAddr, uint8_t regAddr, uint16_t data);
+    uint8_t WriteBytes(uint8_t devAddr, uint8_t regAddr, uint8_t length, const uint8_t *data);
+    uint8_t ReadBytes(uint8_t devAddr, uint8_t regAddr, uint8_t length, uint8_t *data);
+
+    // Operations added after this call target the devices behind a channel of
+    // a TCA9548A, until ClearMuxChannel()
+    void SetMuxChannel(uint8_t channel, uint8_t muxAddress = TCA9548A_DEFAULT_ADDRESS);
+    void ClearMuxChannel();
+
+    void Clear();
+
+    uint8_t GetCount() { return static_cast<uint8_t>(_operations.size()); }
+    bool IsSuccessful(uint8_t index) { return index < _operations.size() && _operations[index].status; }
+    bool IsSuccessful();
+
+  private:
+    friend class I2Cdev;
+
+    struct i2c_operation_t
+    {
+        uint8_t muxAddress; // 0 when the device is directly on the bus
+        uint8_t muxChannel;
+        uint8_t devAddr;
+        bool isRead;
+        uint16_t sendOffset; // register address, followed by the data for writes
+        uint16_t sendLength;
+        uint8_t *recvData;
+        uint8_t recvLength;
+        bool status;
+    };
+
+    uint8_t AddOperation(uint8_t devAddr, bool isRead, uint8_t regAddr, uint8_t length, const uint8_t *sendData, uint8_t *recvData);
+
+    std::vector<i2c_operation_t> _operations;
+    std::vector<uint8_t> _sendBuffer;
+    uint8_t _muxAddress = 0;
+    uint8_t _muxChannel = 0;
+};
+
+#endif // I2C_BATCH_H
@@ -0,0 +1,81 @@
+#include "I2cRegisterCache.h"
+
+I2cRegisterCache::device_shadow_t *I2cRegisterCache::GetDevice(uint8_t devAddr)
+{
+    if (devAddr >= I2C_DEVICE_COUNT)
+    {
+        return nullptr;
+    }
+    return _devices[devAddr].get();
+}
+
+void I2cRegisterCache::SetCacheable(uint8_t devAddr, uint8_t regAddr, uint16_t count, bool isCacheable)
+{
+    if (devAddr >= I2C_DEVICE_COUNT)
+    {
+        return;
+    }
+
+    if (!_devices[devAddr])
+    {
+        _devices[devAddr].reset(new device_shadow_t());
+    }
+
+    device_shadow_t *device = _devices[devAddr].get();
+    for (uint16_t reg = regAddr; reg < regAddr + count && reg < I2C_REGISTER_COUNT; reg++)
+    {
+        device->isCacheable[reg] = isCacheable;
+        device->isValid[reg] = false;
+    }
+}
+
+void I2cRegisterCache::Invalidate(uint8_t devAddr)
+{
+    device_shadow_t *device = GetDevice(devAddr);
+    if (device != nullptr)
+    {
+        device->isValid.reset();
+    }
+}
+
+bool I2cRegisterCache::Read(uint8_t devAddr, uint8_t regAddr, uint16_t length, uint8_t *data)
+{
+    device_shadow_t *device = GetDevice(devAddr);
+    if (device == nullptr || length == 0 || regAddr + length > I2C_REGISTER_COUNT)
+    {
+        return false;
+    }
+
+    for (uint16_t reg = regAddr; reg < regAddr + length; reg++)
+    {
+        if (!device->isValid[reg])
+        {
+            return false;
+        }
+    }
+
+    for (uint16_t i = 0; i < length; i++)
+    {
+        data[i] = device->values[regAddr + i];
+    }
+    return true;
+}
+
+void I2cRegisterCache::Update(uint8_t devAddr, uint8_t regAddr, uint16_t length, const uint8_t *data)
+{
+    device_shadow_t *device = GetDevice(devAddr);
+    if (device == nullptr)
+    {
+        return;
+    }
+
+    for (uint16_t i = 0; i < length && regAddr + i < I2C_REGISTER_COUNT; i++)
+    {
+        uint16_t reg = regAddr + i;
+        if (device->isCacheable[reg])
+        {
+            device->values[reg] = data[i];
+            device->isValid[reg] = true;
+        }
+    }
+}
@@ -0,0 +1,38 @@
+#ifndef I2C_REGISTER_CACHE_H
+#define I2C_REGISTER_CACHE_H
+
+#include <bitset>
+#include <memory>
+#include <stdint.h>
+
+#define I2C_REGISTER_COUNT 256
+#define I2C_DEVICE_COUNT 128
+
+// Shadow copy of the registers of the devices on a bus. Only the registers
+// declared cacheable (written by the host and never changed by the device)
+// are kept, every other register is read from the bus. Not thread safe, the
+// owning I2Cdev calls it with its bus lock held.
+class I2cRegisterCache
+{
+  public:
+    void SetCacheable(uint8_t devAddr, uint8_t regAddr, uint16_t count, bool isCacheable);
+    void Invalidate(uint8_t devAddr);
+
+    // Returns true if every register of the range was served from the cache
+    bool Read(uint8_t devAddr, uint8_t regAddr, uint16_t length, uint8_t *data);
+    void Update(uint8_t devAddr, uint8_t regAddr, uint16_t length, const uint8_t *data);
+
+  private:
+    struct device_shadow_t
+    {
+        std::bitset<I2C_REGISTER_COUNT> isCacheable;
+        std::bitset<I2C_REGISTER_COUNT> isValid;
+        uint8_t values[I2C_REGISTER_COUNT];
+    };
+
+    device_shadow_t *GetDevice(uint8_t devAddr);
+
+    std::unique_ptr<device_shadow_t> _devices[I2C_DEVICE_COUNT];
+};
+
+#endif // I2C_REGISTER_CACHE_H
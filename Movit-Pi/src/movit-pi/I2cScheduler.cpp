@@ -0,0 +1,117 @@
+#include "I2cScheduler.h"
+
+#include <memory>
+
+thread_local I2cPriority threadPriority = highPriority;
+
+I2cScheduler::~I2cScheduler()
+{
+    Stop();
+}
+
+void I2cScheduler::Start()
+{
+    // The new thread waits for the lock before serving its queue
+    std::lock_guard<std::mutex> lock(_queueMutex);
+    if (_isRunning)
+    {
+        return;
+    }
+
+    _thread = std::thread([=] {
+        _threadId = std::this_thread::get_id();
+        Run();
+    });
+    _isRunning = true;
+}
+
+void I2cScheduler::Stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(_queueMutex);
+        _isRunning = false;
+    }
+    _queueCondition.notify_all();
+
+    if (_thread.joinable() && !IsBusThread())
+    {
+        _thread.join();
+        _threadId = std::thread::id();
+    }
+}
+
+I2cPriority I2cScheduler::GetThreadPriority()
+{
+    return threadPriority;
+}
+
+void I2cScheduler::SetThreadPriority(I2cPriority priority)
+{
+    threadPriority = priority;
+}
+
+std::future<bool> I2cScheduler::Submit(I2cPriority priority, std::function<bool()> operation)
+{
+    std::shared_ptr<std::promise<bool>> promise = std::make_shared<std::promise<bool>>();
+    Submit(priority, operation, [promise](bool result) { promise->set_value(result); });
+    return promise->get_future();
+}
+
+void I2cScheduler::Submit(I2cPriority priority, std::function<bool()> operation, std::function<void(bool)> callback)
+{
+    std::unique_lock<std::mutex> lock(_queueMutex);
+
+    if (!_isRunning)
+    {
+        // Nobody owns the bus, run the request on the calling thread
+        lock.unlock();
+        bool result = operation();
+        if (callback)
+        {
+            callback(result);
+        }
+        return;
+    }
+
+    _queues[priority].push_back({operation, callback});
+    lock.unlock();
+    _queueCondition.notify_one();
+}
+
+bool I2cScheduler::PopRequest(i2c_request_t &request)
+{
+    std::unique_lock<std::mutex> lock(_queueMutex);
+
+    while (true)
+    {
+        for (uint8_t priority = 0; priority < priorityCount; priority++)
+        {
+            if (!_queues[priority].empty())
+            {
+                request = _queues[priority].front();
+                _queues[priority].pop_front();
+                return true;
+            }
+        }
+
+        // Requests still queued when stopping are served before leaving
+        if (!_isRunning)
+        {
+            return false;
+        }
+        _queueCondition.wait(lock);
+    }
+}
+
+void I2cScheduler::Run()
+{
+    i2c_request_t request;
+    while (PopRequest(request))
+    {
+        bool result = request.operation();
+        if (request.callback)
+        {
+            request.callback(result);
+        }
+    }
+}
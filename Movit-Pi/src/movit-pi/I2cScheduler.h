@@ -0,0 +1,78 @@
+#ifndef I2C_SCHEDULER_H
+#define I2C_SCHEDULER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+
+enum I2cPriority
+{
+    realTimePriority = 0, // Sensor sampling
+    highPriority,         // Actuators (LEDs, DC motor)
+    lowPriority,          // Diagnostics and connection probes
+    priorityCount
+};
+
+// Thread that owns the I2C bus. Other threads queue their bus operations and
+// the scheduler runs them one at a time, always serving the highest priority
+// queue first. Requests of the same priority are served in submission order.
+class I2cScheduler
+{
+  public:
+    ~I2cScheduler();
+
+    void Start();
+    void Stop();
+
+    bool IsRunning() { return _isRunning; }
+    bool IsBusThread() { return std::this_thread::get_id() == _threadId; }
+
+    std::future<bool> Submit(I2cPriority priority, std::function<bool()> operation);
+    void Submit(I2cPriority priority, std::function<bool()> operation, std::function<void(bool)> callback);
+
+    // Priority given to the bus operations of the calling thread
+    static I2cPriority GetThreadPriority();
+    static void SetThreadPriority(I2cPriority priority);
+
+  private:
+    struct i2c_request_t
+    {
+        std::function<bool()> operation;
+        std::function<void(bool)> callback;
+    };
+
+    void Run();
+    bool PopRequest(i2c_request_t &request);
+
+    std::deque<i2c_request_t> _queues[priorityCount];
+    std::mutex _queueMutex;
+    std::condition_variable _queueCondition;
+    std::thread _thread;
+    // Written by the bus thread itself, before it serves any request
+    std::atomic<std::thread::id> _threadId{std::thread::id()};
+    std::atomic<bool> _isRunning{false};
+};
+
+// Sets the I2C priority of the current thread until the end of the scope
+class I2cPriorityScope
+{
+  public:
+    I2cPriorityScope(I2cPriority priority) : _previousPriority(I2cScheduler::GetThreadPriority())
+    {
+        I2cScheduler::SetThreadPriority(priority);
+    }
+
+    ~I2cPriorityScope()
+    {
+        I2cScheduler::SetThreadPriority(_previousPriority);
+    }
+
+  private:
+    I2cPriority _previousPriority;
+};
+
+#endif // I2C_SCHEDULER_H
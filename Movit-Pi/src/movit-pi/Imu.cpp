@@ -1,17 +1,45 @@
 #include "Imu.h"
+#include "I2cScheduler.h"
 #include "Utils.h"
 #include "SysTime.h"
 
 #include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iterator>
 #include <math.h>
 #include <unistd.h>
 
+// With the low-pass filter enabled, the sample rate is divided from the 1 kHz
+// gyroscope output rate
+#define MPU6050_DLPF_OUTPUT_RATE 1000 // Hz
+
+namespace
+{
+uint64_t GetSteadyTime()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+} // namespace
+
+FusionAlgorithm Imu::_fusionAlgorithm = mahonyFusion;
+uint16_t Imu::_fifoSampleRate = IMU_FIFO_SAMPLE_RATE;
+bool Imu::_areInterruptsEnabled = false;
+
 Imu::Imu()
 {
 }
 
+Imu::~Imu()
+{
+    StopSampler();
+}
+
 bool Imu::Initialize()
 {
+    CancelCalibration();
+    StopSampler();
+
     printf("MPU6050 %s initializing ... ", _imuName.c_str());
     fflush(stdout);
 
@@ -23,12 +51,343 @@ bool Imu::Initialize()
 
     _imu.Initialize();
 
+    // The registers are still read one snapshot at a time if the FIFO can't be started
+    if (StartDmpAcquisition())
+    {
+        printf("(DMP) ");
+    }
+    else if (StartFifoAcquisition(_fifoSampleRate))
+    {
+        // The orientation is fused from the raw samples, the DMP computes its own
+        _orientationFilter = OrientationFilter::Create(_fusionAlgorithm);
+        printf("(%s fusion, %i Hz) ", OrientationFilter::GetAlgorithmName(_fusionAlgorithm), _sampleRate);
+    }
+    else
+    {
+        printf("(FIFO unavailable) ");
+    }
+
+    if (StartSampler() && _isInterruptDriven)
+    {
+        printf("(interrupts) ");
+    }
+
     printf("SUCCESS\n");
     return true;
 }
 
+bool Imu::StartSampler()
+{
+    if (_acquisitionMode == snapshotAcquisition)
+    {
+        return false;
+    }
+
+    _imu.SetIntEnabled(0);
+    if (_areInterruptsEnabled && _interruptLine >= 0)
+    {
+        // 50 us active high pulse for each sample, or each DMP packet
+        _imu.SetInterruptMode(false);
+        _imu.SetInterruptDrive(false);
+        _imu.SetInterruptLatch(false);
+        if (_acquisitionMode == dmpAcquisition)
+        {
+            _imu.SetIntDMPEnabled(true);
+        }
+        else
+        {
+            _imu.SetIntDataReadyEnabled(true);
+        }
+
+        // Without the GPIO, the FIFO is drained on a timer
+        _interruptEvents = GpioEventLine::Create(static_cast<unsigned>(_interruptLine));
+        if (!_interruptEvents->Open())
+        {
+            _interruptEvents.reset();
+            _imu.SetIntEnabled(0);
+        }
+    }
+
+    ResetFifo();
+    _isSampling = true;
+    _isInterruptDriven = _interruptEvents != nullptr;
+    _samplerThread = std::thread([=] { RunSampler(); });
+    return true;
+}
+
+void Imu::StopSampler()
+{
+    _isSampling = false;
+    if (_interruptEvents)
+    {
+        _interruptEvents->Interrupt();
+    }
+    if (_samplerThread.joinable())
+    {
+        _samplerThread.join();
+    }
+    _interruptEvents.reset();
+    _isInterruptDriven = false;
+}
+
+// Only writer of the sample ring. On interrupts, sleeps until the IMU signals
+// new samples, drains the FIFO every IMU_INTERRUPT_DRAIN_PERIOD and the timeout
+// only covers lost interrupts. Else, drains the FIFO every IMU_SAMPLER_PERIOD.
+void Imu::RunSampler()
+{
+    I2cPriorityScope priorityScope(realTimePriority);
+    std::vector<imu_sample_t> samples;
+    samples.reserve(IMU_FIFO_SIZE / IMU_FIFO_SAMPLE_SIZE);
+    const uint16_t watermark = std::max(1, _sampleRate * IMU_INTERRUPT_DRAIN_PERIOD / SECONDS_TO_MILLISECONDS);
+    uint16_t edges = 0;
+
+    while (_isSampling)
+    {
+        uint64_t edgeTime = 0;
+        GpioWaitResult result = gpioTimeout;
+        if (_isInterruptDriven)
+        {
+            result = _interruptEvents->Wait(IMU_INTERRUPT_TIMEOUT, edgeTime);
+            // Also returned when StopSampler() interrupts the wait
+            if (result == gpioError)
+            {
+                if (_isSampling)
+                {
+                    printf("Error: MPU6050 %s interrupts lost, back to polling the FIFO\n", _imuName.c_str());
+                    _isInterruptDriven = false;
+                }
+                continue;
+            }
+            if (result == gpioEdge && ++edges < watermark)
+            {
+                continue;
+            }
+            edges = 0;
+        }
+        else
+        {
+            sleep_for_milliseconds(IMU_SAMPLER_PERIOD);
+        }
+
+        // The newest sample was queued just before its interrupt, or less than
+        // one period before the read
+        samples.clear();
+        {
+            std::lock_guard<std::mutex> lock(_imuMutex);
+            if (!_isSampling || !ReadFifo(samples, result == gpioEdge ? edgeTime : GetSteadyTime()))
+            {
+                continue;
+            }
+        }
+
+        for (const imu_sample_t &sample : samples)
+        {
+            _sampleRing.Push(sample);
+        }
+    }
+}
+
+const std::vector<uint8_t> &Imu::GetDmpFirmware()
+{
+    // Loaded once, shared by both IMUs
+    static const std::vector<uint8_t> firmware = [] {
+        std::vector<uint8_t> image;
+        std::ifstream file(DMP_FIRMWARE_FILENAME, std::ios::binary);
+        if (!file.is_open())
+        {
+            return image;
+        }
+
+        image.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        if (image.empty() || image.size() > DMP_FIRMWARE_MAX_SIZE)
+        {
+            printf("Error: %s is not a DMP firmware image (%zu bytes)\n", DMP_FIRMWARE_FILENAME, image.size());
+            image.clear();
+        }
+        return image;
+    }();
+    return firmware;
+}
+
+bool Imu::StartDmpAcquisition()
+{
+    const std::vector<uint8_t> &firmware = GetDmpFirmware();
+    if (firmware.empty())
+    {
+        return false;
+    }
+
+    _acquisitionMode = snapshotAcquisition;
+    _samples.reserve(IMU_FIFO_SIZE / IMU_FIFO_SAMPLE_SIZE);
+
+    // Configuration expected by the MotionApps 6.12 firmware
+    _imu.SetIntEnabled(0);
+    _imu.SetFIFOEnabled(false);
+    _imu.SetAccelFIFOEnabled(false);
+    _imu.SetXGyroFIFOEnabled(false);
+    _imu.SetYGyroFIFOEnabled(false);
+    _imu.SetZGyroFIFOEnabled(false);
+    _imu.SetClockSource(MPU6050_CLOCK_PLL_XGYRO);
+    _imu.SetFullScaleAccelRange(MPU6050_ACCEL_FS_2);
+    _imu.SetRate(MPU6050_DLPF_OUTPUT_RATE / (2 * IMU_DMP_SAMPLE_RATE) - 1);
+    _imu.SetDLPFMode(MPU6050_DLPF_BW_188);
+
+    if (!_imu.WriteProgMemoryBlock(firmware.data(), static_cast<uint16_t>(firmware.size())))
+    {
+        printf("(DMP firmware upload failed) ");
+        _imu.SetClockSource(MPU6050_CLOCK_PLL_XGYRO);
+        return false;
+    }
+
+    _imu.SetDMPConfig1(DMP_PROGRAM_START_ADDRESS >> 8);
+    _imu.SetDMPConfig2(DMP_PROGRAM_START_ADDRESS & 0xFF);
+    _imu.SetFullScaleGyroRange(MPU6050_GYRO_FS_2000);
+    _imu.SetDMPEnabled(true);
+    ResetFifo();
+
+    if (!_imu.GetDMPEnabled() || !_imu.GetFIFOEnabled())
+    {
+        return false;
+    }
+
+    _sampleSize = IMU_DMP_PACKET_SIZE;
+    _sampleRate = IMU_DMP_SAMPLE_RATE;
+    _gyroscopeSensitivity = GYROSCOPE_SENSITIVITY_2000;
+    _acquisitionMode = dmpAcquisition;
+    return true;
+}
+
+bool Imu::StartFifoAcquisition(uint16_t sampleRate)
+{
+    _acquisitionMode = snapshotAcquisition;
+    _samples.reserve(IMU_FIFO_SIZE / IMU_FIFO_SAMPLE_SIZE);
+
+    // The rates not dividing 1 kHz are rounded up, the widest bandwidth below
+    // the Nyquist frequency keeps the vibrations without aliasing
+    const uint8_t divider = static_cast<uint8_t>(MPU6050_DLPF_OUTPUT_RATE / sampleRate);
+    sampleRate = MPU6050_DLPF_OUTPUT_RATE / divider;
+    uint8_t bandwidth = MPU6050_DLPF_BW_42;
+    if (sampleRate >= 400)
+    {
+        bandwidth = MPU6050_DLPF_BW_188;
+    }
+    else if (sampleRate >= 200)
+    {
+        bandwidth = MPU6050_DLPF_BW_98;
+    }
+
+    // Also undoes a failed DMP start
+    _imu.SetDMPEnabled(false);
+    _imu.SetFullScaleGyroRange(MPU6050_GYRO_FS_250);
+    _imu.SetDLPFMode(bandwidth);
+    _imu.SetRate(divider - 1);
+    _imu.SetAccelFIFOEnabled(true);
+    _imu.SetXGyroFIFOEnabled(true);
+    _imu.SetYGyroFIFOEnabled(true);
+    _imu.SetZGyroFIFOEnabled(true);
+    ResetFifo();
+
+    if (!_imu.GetFIFOEnabled() || !_imu.GetAccelFIFOEnabled())
+    {
+        return false;
+    }
+
+    _sampleSize = IMU_FIFO_SAMPLE_SIZE;
+    _sampleRate = sampleRate;
+    _gyroscopeSensitivity = GYROSCOPE_SENSITIVITY_250;
+    _acquisitionMode = fifoAcquisition;
+    return true;
+}
+
+void Imu::ResetFifo()
+{
+    _imu.SetFIFOEnabled(false);
+    _imu.ResetFIFO();
+    _imu.SetFIFOEnabled(true);
+}
+
+/** Drain the samples queued in the FIFO.
+ * @param samples Receives the samples, appended in the order they were taken
+ * @param newestTime Steady time of the newest queued sample, in microseconds
+ * @return false on an overflow or a bus error
+ */
+bool Imu::ReadFifo(std::vector<imu_sample_t> &samples, uint64_t newestTime)
+{
+    const ImuAcquisitionMode mode = _acquisitionMode;
+    if (mode == snapshotAcquisition)
+    {
+        return false;
+    }
+
+    const uint16_t count = _imu.GetFIFOCount();
+
+    // After an overflow, the oldest samples were partly overwritten and the
+    // FIFO no longer starts on a sample boundary
+    if (count % _sampleSize != 0 || count > IMU_FIFO_SIZE - _sampleSize)
+    {
+        printf("Warning: MPU6050 %s FIFO overflow, restarting the acquisition\n", _imuName.c_str());
+        ResetFifo();
+        return false;
+    }
+
+    const uint16_t queuedSamples = count / _sampleSize;
+    if (queuedSamples == 0)
+    {
+        return true;
+    }
+
+    // The FIFO is drained in bursts of whole samples: one burst per drain at
+    // 100 Hz in raw mode, two with the larger DMP packets or at 1 kHz
+    const uint8_t burstSamples = IMU_FIFO_BURST_SIZE / _sampleSize;
+    const uint64_t samplePeriod = SECONDS_TO_MICROSECONDS / _sampleRate;
+    uint8_t buffer[IMU_FIFO_BURST_SIZE];
+
+    // The DMP packets start with the quaternion, in Q30 format
+    const uint8_t motionOffset = mode == dmpAcquisition ? 16 : 0;
+
+    for (uint16_t i = 0; i < queuedSamples; i++)
+    {
+        const uint8_t burstIndex = i % burstSamples;
+        if (burstIndex == 0)
+        {
+            const uint16_t burstCount = std::min<uint16_t>(queuedSamples - i, burstSamples);
+            if (!_imu.GetFIFOBytes(buffer, burstCount * _sampleSize))
+            {
+                ResetFifo();
+                return false;
+            }
+        }
+
+        const uint8_t *data = buffer + burstIndex * _sampleSize;
+        imu_sample_t sample;
+        sample.timestamp = newestTime - (queuedSamples - 1 - i) * samplePeriod;
+        for (uint8_t axis = 0; axis < NUMBER_OF_AXIS; axis++)
+        {
+            const uint8_t *acceleration = data + motionOffset + 2 * axis;
+            const uint8_t *rotation = data + motionOffset + 6 + 2 * axis;
+            sample.accelerations[axis] = static_cast<int16_t>((acceleration[0] << 8) | acceleration[1]);
+            sample.rotations[axis] = static_cast<int16_t>((rotation[0] << 8) | rotation[1]);
+        }
+
+        sample.quaternion[0] = 1;
+        sample.quaternion[1] = sample.quaternion[2] = sample.quaternion[3] = 0;
+        if (mode == dmpAcquisition)
+        {
+            for (uint8_t j = 0; j < 4; j++)
+            {
+                const uint8_t *q = data + 4 * j;
+                int32_t value = static_cast<int32_t>((static_cast<uint32_t>(q[0]) << 24) | (q[1] << 16) | (q[2] << 8) | q[3]);
+                sample.quaternion[j] = value / 1073741824.0f;
+            }
+        }
+        samples.push_back(sample);
+    }
+    return true;
+}
+
 bool Imu::IsConnected()
 {
+    std::lock_guard<std::mutex> lock(_imuMutex);
     return _imu.TestConnection();
 }
 
@@ -40,24 +399,12 @@ bool Imu::IsImuOffsetValid(imu_offset_t offset)
 
 void Imu::SetOffset(imu_offset_t offsets)
 {
+    std::lock_guard<std::mutex> lock(_imuMutex);
     _offsets = offsets;
     ResetIMUOffsets(_imu);
     SetImuOffsets(_imu);
 }
 
-void Imu::CalibrateAndSetOffsets()
-{
-    ResetIMUOffsets(_imu);
-    Calibrate(_imu, _imuName);
-    SetImuOffsets(_imu);
-}
-
-void Imu::Calibrate(MPU6050 &mpu, std::string name)
-{
-    CalibrateAccelerometer(mpu);
-    CalibrateGyroscope(mpu);
-}
-
 void Imu::ResetIMUOffsets(MPU6050 &mpu)
 {
     ResetIMUAccelOffsets(mpu);
@@ -98,149 +445,350 @@ void Imu::SetImuGyroOffsets(MPU6050 &mpu)
     mpu.SetZGyroOffset(_offsets.gyroscopeOffsets[AXIS::z]);
 }
 
-void Imu::GetGyroscopeMeans(MPU6050 &mpu, int gyroscopeMeans[])
+void Imu::StartCalibration()
 {
-    const int numberOfDiscardedMeasures = 100;
-    const int timeBetweenMeasures = 2000;
+    if (IsCalibrating())
+    {
+        return;
+    }
 
-    uint16_t i = 0;
-    int16_t gx, gy, gz;
+    // The calibration reads the output registers while the FIFO overflows
+    StopSampler();
 
-    while (i < (BUFFER_SIZE + numberOfDiscardedMeasures))
-    {
-        mpu.GetRotation(&gx, &gy, &gz);
+    std::lock_guard<std::mutex> lock(_imuMutex);
+    _previousOffsets = _offsets;
 
-        if (i++ > numberOfDiscardedMeasures)
-        {
-            gyroscopeMeans[AXIS::x] += gx;
-            gyroscopeMeans[AXIS::y] += gy;
-            gyroscopeMeans[AXIS::z] += gz;
-        }
+    // The offsets are computed at the +/- 250 deg/s range (the DMP needs
+    // +/- 2000 deg/s), from distinct samples at 1 kHz
+    _previousGyroscopeRange = _imu.GetFullScaleGyroRange();
+    _previousRate = _imu.GetRate();
+    _imu.SetFullScaleGyroRange(MPU6050_GYRO_FS_250);
+    _imu.SetRate(0);
 
-        sleep_for_microseconds(timeBetweenMeasures);
+    _offsets = imu_offset_t();
+    for (uint8_t channel = 0; channel < 2 * NUMBER_OF_AXIS; channel++)
+    {
+        _calibrationSensitivities[channel] = channel < NUMBER_OF_AXIS ? ACCELEROMETER_OFFSET_SENSITIVITY : GYROSCOPE_OFFSET_SENSITIVITY;
     }
 
-    gyroscopeMeans[AXIS::x] /= BUFFER_SIZE;
-    gyroscopeMeans[AXIS::y] /= BUFFER_SIZE;
-    gyroscopeMeans[AXIS::z] /= BUFFER_SIZE;
+    _calibrationProgress = imu_calibration_progress_t();
+    _calibrationProgress.state = calibrationBias;
+    _calibrationProgress.maxPasses = IMU_CALIBRATION_MAX_PASSES;
+    _calibrationState = calibrationBias;
+    StartCalibrationPass();
 }
 
-void Imu::GetAccelerometerMeans(MPU6050 &mpu, int accelerationBuffer[])
+bool Imu::IsCalibrating()
 {
-    const int numberOfDiscardedMeasures = 100;
-    const int timeBetweenMeasures = 2000;
+    const ImuCalibrationState state = _calibrationState;
+    return state == calibrationBias || state == calibrationSensitivity || state == calibrationVerification;
+}
 
-    uint16_t i = 0;
-    int16_t ax, ay, az;
+/** Advance the calibration by at most IMU_CALIBRATION_SAMPLES_PER_TICK reads.
+ * @return State of the calibration after this step
+ */
+ImuCalibrationState Imu::UpdateCalibration()
+{
+    if (!IsCalibrating())
+    {
+        return _calibrationState;
+    }
 
-    while (i < (BUFFER_SIZE + numberOfDiscardedMeasures))
+    std::unique_lock<std::mutex> lock(_imuMutex);
+    if (!IsCalibrating())
     {
-        mpu.GetAcceleration(&ax, &ay, &az);
+        return _calibrationState;
+    }
 
-        if (i++ > numberOfDiscardedMeasures)
+    bool isPassDone = false;
+    for (uint8_t i = 0; i < IMU_CALIBRATION_SAMPLES_PER_TICK && !isPassDone; i++)
+    {
+        int16_t values[2 * NUMBER_OF_AXIS];
+        _imu.GetMotion6(&values[0], &values[1], &values[2], &values[3], &values[4], &values[5]);
+        sleep_for_microseconds(IMU_CALIBRATION_SAMPLE_PERIOD);
+
+        if (_calibrationSampleCount++ < IMU_CALIBRATION_DISCARDED_SAMPLES)
+        {
+            continue;
+        }
+        for (uint8_t channel = 0; channel < 2 * NUMBER_OF_AXIS; channel++)
         {
-            accelerationBuffer[AXIS::x] += ax;
-            accelerationBuffer[AXIS::y] += ay;
-            accelerationBuffer[AXIS::z] += az;
+            _calibrationStatistics[channel].AddSample(values[channel]);
         }
+        isPassDone = IsCalibrationPassPrecise();
+    }
+
+    const uint16_t passSamples = IMU_CALIBRATION_DISCARDED_SAMPLES + BUFFER_SIZE;
+    _calibrationProgress.passProgress = static_cast<uint8_t>(isPassDone ? 100 : _calibrationSampleCount * 100 / passSamples);
+    if (!isPassDone)
+    {
+        return _calibrationState;
+    }
 
-        sleep_for_microseconds(timeBetweenMeasures);
+    const bool isConverged = SolveCalibrationOffsets();
+    _calibrationProgress.pass++;
+
+    if (isConverged || _calibrationProgress.pass >= IMU_CALIBRATION_MAX_PASSES)
+    {
+        lock.unlock();
+        EndCalibration(isConverged);
+        return _calibrationState;
     }
 
-    accelerationBuffer[AXIS::x] /= BUFFER_SIZE;
-    accelerationBuffer[AXIS::y] /= BUFFER_SIZE;
-    accelerationBuffer[AXIS::z] /= BUFFER_SIZE;
+    _calibrationState = _calibrationProgress.pass == 1 ? calibrationSensitivity : calibrationVerification;
+    _calibrationProgress.state = _calibrationState;
+    StartCalibrationPass();
+    return _calibrationState;
 }
 
-void Imu::CalibrateAccelerometer(MPU6050 &mpu)
+void Imu::CancelCalibration()
 {
-    uint8_t ready = 0;
-    int accelerometerMeans[NUMBER_OF_AXIS] = {0, 0, 0};
-    GetAccelerometerMeans(mpu, accelerometerMeans);
+    if (IsCalibrating())
+    {
+        EndCalibration(false);
+    }
+}
 
-    _offsets.accelerometerOffsets[AXIS::x] = (_calibrationArray[AXIS::x] - accelerometerMeans[AXIS::x]) / 8;
-    _offsets.accelerometerOffsets[AXIS::y] = (_calibrationArray[AXIS::y] - accelerometerMeans[AXIS::y]) / 8;
-    _offsets.accelerometerOffsets[AXIS::z] = (_calibrationArray[AXIS::z] - accelerometerMeans[AXIS::z]) / 8;
+// Applies the offsets to verify, then measures again
+void Imu::StartCalibrationPass()
+{
+    SetImuOffsets(_imu);
 
-    while (ready < NUMBER_OF_AXIS)
+    _calibrationSampleCount = 0;
+    _calibrationProgress.passProgress = 0;
+    for (uint8_t channel = 0; channel < 2 * NUMBER_OF_AXIS; channel++)
     {
-        ready = 0;
-        SetImuAccelOffsets(mpu);
-        GetAccelerometerMeans(mpu, accelerometerMeans);
+        _calibrationStatistics[channel].Reset();
+    }
+}
 
-        for (uint8_t i = 0; i < NUMBER_OF_AXIS; i++)
-        {
-            printf("%i\n", abs(_calibrationArray[i] - accelerometerMeans[i]));
+// A pass ends when its means are known to a quarter of the deadzones, or
+// after BUFFER_SIZE samples with a noisy sensor
+bool Imu::IsCalibrationPassPrecise()
+{
+    const uint32_t count = _calibrationStatistics[0].GetCount();
+    if (count >= BUFFER_SIZE)
+    {
+        return true;
+    }
+    if (count < IMU_CALIBRATION_MIN_SAMPLES)
+    {
+        return false;
+    }
 
-            if (abs(_calibrationArray[i] - accelerometerMeans[i]) <= ACCELEROMETER_DEADZONE)
-            {
-                ready++;
-            }
-            else
-            {
-                _offsets.accelerometerOffsets[i] = _offsets.accelerometerOffsets[i] + (_calibrationArray[i] - accelerometerMeans[i]) / ACCELEROMETER_DEADZONE;
-            }
+    for (uint8_t channel = 0; channel < 2 * NUMBER_OF_AXIS; channel++)
+    {
+        const double deadzone = channel < NUMBER_OF_AXIS ? ACCELEROMETER_DEADZONE : GYROSCOPE_DEADZONE;
+        if (_calibrationStatistics[channel].GetStandardError() > deadzone / 4)
+        {
+            return false;
         }
     }
+    return true;
 }
 
-void Imu::CalibrateGyroscope(MPU6050 &mpu)
+int &Imu::GetCalibrationOffset(uint8_t channel)
 {
-    uint8_t ready = 0;
-    int gyroscopeMeans[NUMBER_OF_AXIS] = {0, 0, 0};
-    GetGyroscopeMeans(mpu, gyroscopeMeans);
-
-    _offsets.gyroscopeOffsets[AXIS::x] = -gyroscopeMeans[AXIS::x] / 4;
-    _offsets.gyroscopeOffsets[AXIS::y] = -gyroscopeMeans[AXIS::y] / 4;
-    _offsets.gyroscopeOffsets[AXIS::z] = -gyroscopeMeans[AXIS::z] / 4;
+    return channel < NUMBER_OF_AXIS ? _offsets.accelerometerOffsets[channel] : _offsets.gyroscopeOffsets[channel - NUMBER_OF_AXIS];
+}
 
-    while (ready < NUMBER_OF_AXIS)
+/** Solve the offsets from the means of the last pass. The sensitivity of each
+ * axis to its offset register is measured between the last two passes, the
+ * offset bringing the output on its target follows directly.
+ * @return true when every axis is on its target, within its deadzone or the
+ * resolution of its offset register
+ */
+bool Imu::SolveCalibrationOffsets()
+{
+    uint8_t ready = 0;
+    for (uint8_t channel = 0; channel < 2 * NUMBER_OF_AXIS; channel++)
     {
-        ready = 0;
-        SetImuGyroOffsets(mpu);
-        GetGyroscopeMeans(mpu, gyroscopeMeans);
+        const bool isAccelerometer = channel < NUMBER_OF_AXIS;
+        const uint8_t axis = channel % NUMBER_OF_AXIS;
+        const double nominalSensitivity = isAccelerometer ? ACCELEROMETER_OFFSET_SENSITIVITY : GYROSCOPE_OFFSET_SENSITIVITY;
+        const double target = isAccelerometer ? _calibrationArray[axis] : 0;
+        const double mean = _calibrationStatistics[channel].GetMean();
+        const double error = target - mean;
+        int &offset = GetCalibrationOffset(channel);
+
+        // A step too small for the noise keeps the previous sensitivity, an
+        // implausible one (saturated output, moved IMU) the nominal one
+        if (_calibrationProgress.pass > 0 && abs(offset - _previousCalibrationOffsets[channel]) >= 2)
+        {
+            const double sensitivity = (mean - _previousCalibrationMeans[channel]) / (offset - _previousCalibrationOffsets[channel]);
+            const bool isPlausible = sensitivity > nominalSensitivity / 2 && sensitivity < nominalSensitivity * 2;
+            _calibrationSensitivities[channel] = isPlausible ? sensitivity : nominalSensitivity;
+        }
+        _previousCalibrationMeans[channel] = mean;
+        _previousCalibrationOffsets[channel] = offset;
 
-        for (uint8_t i = 0; i < NUMBER_OF_AXIS; i++)
+        int *errors = isAccelerometer ? _calibrationProgress.accelerometerErrors : _calibrationProgress.gyroscopeErrors;
+        errors[axis] = static_cast<int>(lround(error));
+
+        const double sensitivity = _calibrationSensitivities[channel];
+        const double deadzone = isAccelerometer ? ACCELEROMETER_DEADZONE : GYROSCOPE_DEADZONE;
+        if (fabs(error) <= std::max(deadzone, sensitivity / 2))
         {
-            if (abs(gyroscopeMeans[i]) <= GYROSCOPE_DEADZONE)
-            {
-                ready++;
-            }
-            else
-            {
-                _offsets.gyroscopeOffsets[i] = _offsets.gyroscopeOffsets[i] - gyroscopeMeans[i] / (GYROSCOPE_DEADZONE + 1);
-            }
+            ready++;
+        }
+        else
+        {
+            offset += static_cast<int>(lround(error / sensitivity));
         }
     }
+    return ready == 2 * NUMBER_OF_AXIS;
 }
 
-void Imu::GetAccelerations(double *accelerations)
+void Imu::EndCalibration(bool isSuccessful)
 {
-    int16_t ax, ay, az;
+    {
+        std::lock_guard<std::mutex> lock(_imuMutex);
+        if (!isSuccessful)
+        {
+            _offsets = _previousOffsets;
+        }
+        SetImuOffsets(_imu);
+        _imu.SetFullScaleGyroRange(_previousGyroscopeRange);
+        _imu.SetRate(_previousRate);
+
+        _calibrationProgress.state = isSuccessful ? calibrationDone : calibrationFailed;
+        _calibrationState = _calibrationProgress.state;
+    }
 
-    _imu.GetAcceleration(&ax, &ay, &az);
+    // The orientation was estimated with the previous offsets
+    if (_orientationFilter)
+    {
+        _orientationFilter->Reset();
+    }
 
-    // TODO: Add low-pass filter
+    // Restarted on an empty FIFO, it overflowed during the calibration
+    StartSampler();
+}
 
-    accelerations[AXIS::x] = static_cast<double>(ax) * 2 / 32768.0f;
-    accelerations[AXIS::y] = static_cast<double>(ay) * 2 / 32768.0f;
-    accelerations[AXIS::z] = static_cast<double>(az) * 2 / 32768.0f;
+const char *Imu::GetCalibrationStateName(ImuCalibrationState state)
+{
+    switch (state)
+    {
+    case calibrationBias:
+        return "bias";
+    case calibrationSensitivity:
+        return "sensitivity";
+    case calibrationVerification:
+        return "verification";
+    case calibrationDone:
+        return "done";
+    case calibrationFailed:
+        return "failed";
+    case calibrationIdle:
+    default:
+        return "idle";
+    }
 }
 
-double Imu::GetPitch()
+ImuFrame Imu::Capture()
 {
+    // The offsets and the sample rate are changing
+    if (IsCalibrating())
+    {
+        return ImuFrame();
+    }
+
     double accelerations[NUMBER_OF_AXIS] = {0, 0, 0};
+    double rotations[NUMBER_OF_AXIS] = {0, 0, 0};
+    uint64_t timestamp = GetSteadyTime();
 
-    this->GetAccelerations(accelerations);
+    _samples.clear();
+    if (_isSampling)
+    {
+        _sampleRing.Read(_captureCursor, _samples);
+    }
 
-    return atan2(-1 * accelerations[AXIS::z], sqrt(accelerations[AXIS::x] * accelerations[AXIS::x] + accelerations[AXIS::y] * accelerations[AXIS::y])) * RADIANS_TO_DEGREES;
+    if (_samples.empty())
+    {
+        int16_t ax, ay, az, gx, gy, gz;
+        {
+            std::lock_guard<std::mutex> lock(_imuMutex);
+            _imu.GetMotion6(&ax, &ay, &az, &gx, &gy, &gz);
+        }
+        accelerations[AXIS::x] = ax / ACCELEROMETER_SENSITIVITY;
+        accelerations[AXIS::y] = ay / ACCELEROMETER_SENSITIVITY;
+        accelerations[AXIS::z] = az / ACCELEROMETER_SENSITIVITY;
+        rotations[AXIS::x] = gx / _gyroscopeSensitivity;
+        rotations[AXIS::y] = gy / _gyroscopeSensitivity;
+        rotations[AXIS::z] = gz / _gyroscopeSensitivity;
+        return ImuFrame(timestamp, accelerations, rotations);
+    }
+
+    // The raw counts are summed as integers and scaled once, only the fusion
+    // needs each sample in g and degrees per second
+    const bool isFused = _acquisitionMode == fifoAcquisition && _orientationFilter;
+    const float accelerationScale = static_cast<float>(1 / ACCELEROMETER_SENSITIVITY);
+    const float rotationScale = static_cast<float>(1 / _gyroscopeSensitivity);
+    int32_t accelerationSums[NUMBER_OF_AXIS] = {0, 0, 0};
+    int32_t rotationSums[NUMBER_OF_AXIS] = {0, 0, 0};
+    for (const imu_sample_t &sample : _samples)
+    {
+        for (uint8_t axis = 0; axis < NUMBER_OF_AXIS; axis++)
+        {
+            accelerationSums[axis] += sample.accelerations[axis];
+            rotationSums[axis] += sample.rotations[axis];
+        }
+
+        // The samples are queued at the exact sample rate, unlike the
+        // timestamps reconstructed at the read
+        if (isFused)
+        {
+            float sampleAccelerations[NUMBER_OF_AXIS];
+            float sampleRotations[NUMBER_OF_AXIS];
+            for (uint8_t axis = 0; axis < NUMBER_OF_AXIS; axis++)
+            {
+                sampleAccelerations[axis] = sample.accelerations[axis] * accelerationScale;
+                sampleRotations[axis] = sample.rotations[axis] * rotationScale;
+            }
+            _orientationFilter->Update(sampleAccelerations, sampleRotations, 1.0f / _sampleRate);
+        }
+    }
+    for (uint8_t axis = 0; axis < NUMBER_OF_AXIS; axis++)
+    {
+        accelerations[axis] = static_cast<double>(accelerationSums[axis]) / (_samples.size() * ACCELEROMETER_SENSITIVITY);
+        rotations[axis] = static_cast<double>(rotationSums[axis]) / (_samples.size() * _gyroscopeSensitivity);
+    }
+
+    // Means over the tick, orientation at the newest sample
+    double quaternion[4];
+    if (isFused)
+    {
+        float fusedQuaternion[4];
+        _orientationFilter->GetQuaternion(fusedQuaternion);
+        std::copy(fusedQuaternion, fusedQuaternion + 4, quaternion);
+    }
+    else if (_acquisitionMode == dmpAcquisition)
+    {
+        std::copy(_samples.back().quaternion, _samples.back().quaternion + 4, quaternion);
+    }
+    else
+    {
+        return ImuFrame(_samples.back().timestamp, accelerations, rotations);
+    }
+    return ImuFrame(_samples.back().timestamp, accelerations, rotations, quaternion);
 }
 
-double Imu::GetRoll()
+void Imu::SetFusionAlgorithm(FusionAlgorithm algorithm)
 {
-    double accelerations[NUMBER_OF_AXIS] = {0, 0, 0};
+    _fusionAlgorithm = algorithm;
+}
 
-    this->GetAccelerations(accelerations);
+bool Imu::SetSampleRate(int sampleRate)
+{
+    if (sampleRate < IMU_FIFO_MIN_SAMPLE_RATE || sampleRate > IMU_FIFO_MAX_SAMPLE_RATE)
+    {
+        return false;
+    }
+    _fifoSampleRate = static_cast<uint16_t>(sampleRate);
+    return true;
+}
 
-    return atan2(accelerations[AXIS::x], accelerations[AXIS::y]) * RADIANS_TO_DEGREES + 90;
+void Imu::SetInterruptsEnabled(bool isEnabled)
+{
+    _areInterruptsEnabled = isEnabled;
 }
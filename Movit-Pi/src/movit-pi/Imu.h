@@ -1,29 +1,120 @@
 #ifndef IMU_H
 #define IMU_H
 
+#include <atomic>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "MPU6050.h"
 #include "Utils.h"
 #include "DataType.h"
+#include "GpioEventLine.h"
+#include "ImuFrame.h"
+#include "OrientationFilter.h"
+#include "RunningStatistics.h"
+#include "SampleRing.h"
 #include "Sensor.h"
 
-#define ACCELEROMETER_DEADZONE 8 // Accelerometer error allowed, make it lower to get more precision, but sketch may not converge (default: 8)
-#define BUFFER_SIZE 1000         // Amount of readings used to average, make it higher to get more precision but sketch will be slower (default: 1000)
-#define GYROSCOPE_DEADZONE 1     // Gyroscope error allowed, make it lower to get more precision, but sketch may not converge (default: 1)
+#define ACCELEROMETER_DEADZONE 8 // Accelerometer error allowed, in LSB at +/- 2 g (default: 8)
+#define BUFFER_SIZE 1000         // Largest amount of readings averaged by a calibration pass (default: 1000)
+#define GYROSCOPE_DEADZONE 1     // Gyroscope error allowed, in LSB at +/- 250 deg/s (default: 1)
+#define IMU_CALIBRATION_DISCARDED_SAMPLES 20  // Read after each change of the offsets, while the low-pass filter settles
+#define IMU_CALIBRATION_MIN_SAMPLES 100       // Averaged by a pass, before its precision is considered
+#define IMU_CALIBRATION_SAMPLES_PER_TICK 40   // Bounds the time UpdateCalibration() takes (default: 40)
+#define IMU_CALIBRATION_SAMPLE_PERIOD 1000    // Microseconds between two reads, at the 1 kHz calibration rate
+#define IMU_CALIBRATION_MAX_PASSES 6          // Bias, sensitivity, then verifications
+#define ACCELEROMETER_OFFSET_SENSITIVITY 8.0  // Nominal LSB at +/- 2 g per unit of the offset registers
+#define GYROSCOPE_OFFSET_SENSITIVITY 4.0      // Nominal LSB at +/- 250 deg/s per unit of the offset registers
 #define GRAVITY 9.80665
 #define LSB_SENSITIVITY -16384
+#define ACCELEROMETER_SENSITIVITY 16384.0  // LSB per g at +/- 2 g
+#define GYROSCOPE_SENSITIVITY_250 131.0    // LSB per deg/s at +/- 250 deg/s
+#define GYROSCOPE_SENSITIVITY_2000 16.4    // LSB per deg/s at +/- 2000 deg/s
+
+#define IMU_FIFO_SAMPLE_RATE 100   // Hz, 10 samples per tick of the main loop (default: 100)
+#define IMU_FIFO_MIN_SAMPLE_RATE 100
+#define IMU_FIFO_MAX_SAMPLE_RATE 1000
+#define IMU_FIFO_SAMPLE_SIZE 12    // Accelerations then rotations, 2 bytes per axis
+#define IMU_FIFO_SIZE 1024         // Bytes
+#define IMU_FIFO_BURST_SIZE 255    // Largest read, in bytes
+
+// InvenSense MotionApps 6.12 firmware image, not distributed with MOvIT. The
+// raw FIFO acquisition is used when the file is missing.
+#define DMP_FIRMWARE_FILENAME "mpu6050-dmp612.bin"
+#define DMP_FIRMWARE_MAX_SIZE 4096
+#define DMP_PROGRAM_START_ADDRESS 0x0400
+#define IMU_DMP_SAMPLE_RATE 100    // Hz, the 200 Hz sample rate halved by the firmware
+#define IMU_DMP_PACKET_SIZE 28     // Quaternion (4 x 32 bits), accelerations, rotations
+
+// The sampler thread drains the FIFO about every IMU_SAMPLER_PERIOD, well
+// before it overflows at 1 kHz. The MPU6050 has no FIFO watermark interrupt,
+// on interrupts the sampler counts the data ready pulses instead and drains
+// every IMU_INTERRUPT_DRAIN_PERIOD: each sample at 100 Hz, every 5 at 1 kHz.
+// The samples are then 8 times fresher, for 8 times more FIFO reads.
+#define IMU_SAMPLER_PERIOD 40      // Milliseconds
+#define IMU_INTERRUPT_DRAIN_PERIOD 5  // Milliseconds, at most 200 FIFO reads per second
+#define IMU_INTERRUPT_TIMEOUT 60   // Milliseconds without interrupt before draining anyway
+#define IMU_SAMPLE_RING_SIZE 1024  // Samples kept for the readers, 1 s at 1 kHz
+
+enum ImuAcquisitionMode
+{
+    snapshotAcquisition, // One read of the output registers per capture
+    fifoAcquisition,     // Raw samples queued in the FIFO
+    dmpAcquisition       // Orientation computed by the on-chip DMP, queued in the FIFO
+};
+
+typedef SampleRing<imu_sample_t, IMU_SAMPLE_RING_SIZE> ImuSampleRing;
 
 class Imu : public Sensor
 {
   public:
     Imu();
+    ~Imu();
     bool Initialize();
     bool IsConnected();
-    void CalibrateAndSetOffsets();
-    void GetAccelerations(double *accelerations);
-    double GetPitch();
-    double GetRoll();
+    const std::string &GetName() { return _imuName; }
+
+    // The calibration is split in bounded steps, UpdateCalibration() must be
+    // called once per tick until it returns calibrationDone or
+    // calibrationFailed. The IMU must stay still meanwhile, and the captures
+    // return invalid frames. On failure, the previous offsets are restored.
+    // The offsets are solved from the response of the sensors to two sets of
+    // offsets, then verified once.
+    void StartCalibration();
+    ImuCalibrationState UpdateCalibration();
+    void CancelCalibration();
+    bool IsCalibrating();
+    imu_calibration_progress_t GetCalibrationProgress() { return _calibrationProgress; }
+    static const char *GetCalibrationStateName(ImuCalibrationState state);
+
+    // Must be called once per tick. Returns the mean of the samples acquired
+    // since the last call, without bus access: the sampler thread drains the
+    // FIFO. Without a FIFO, the output registers are read instead.
+    ImuFrame Capture();
+    // Samples of the last capture
+    const std::vector<imu_sample_t> &GetSamples() { return _samples; }
+    ImuAcquisitionMode GetAcquisitionMode() { return _acquisitionMode; }
+    uint16_t GetSampleRate() { return _sampleRate; }
+    bool IsInterruptDriven() { return _isInterruptDriven; }
+
+    // Any thread can follow the samples at its own pace, with its own cursor.
+    // A reader more than IMU_SAMPLE_RING_SIZE samples behind loses the oldest.
+    ImuSampleRing::Cursor GetSampleCursor() { return _sampleRing.GetNewestCursor(); }
+    // Appends the samples acquired since the cursor, returns the number lost
+    uint64_t ReadSamples(ImuSampleRing::Cursor &cursor, std::vector<imu_sample_t> &samples) { return _sampleRing.Read(cursor, samples); }
+
+    // Fusion of the raw samples, used when the DMP is not. Applies to the IMUs
+    // initialized afterwards.
+    static void SetFusionAlgorithm(FusionAlgorithm algorithm);
+    // Rate of the raw samples, from IMU_FIFO_MIN_SAMPLE_RATE to
+    // IMU_FIFO_MAX_SAMPLE_RATE. Applies to the IMUs initialized afterwards.
+    static bool SetSampleRate(int sampleRate);
+    // Wakes the sampler thread on the INT pin of the IMUs initialized
+    // afterwards, instead of a timer
+    static void SetInterruptsEnabled(bool isEnabled);
 
     static bool IsImuOffsetValid(imu_offset_t offset);
 
@@ -37,9 +128,55 @@ class Imu : public Sensor
 
     imu_offset_t _offsets;
 
-    void Calibrate(MPU6050 &mpu, std::string name);
-    void CalibrateAccelerometer(MPU6050 &mpu);
-    void CalibrateGyroscope(MPU6050 &mpu);
+    std::atomic<ImuAcquisitionMode> _acquisitionMode{snapshotAcquisition};
+    std::vector<imu_sample_t> _samples;
+    uint8_t _sampleSize = IMU_FIFO_SAMPLE_SIZE;
+    uint16_t _sampleRate = IMU_FIFO_SAMPLE_RATE;
+    double _gyroscopeSensitivity = GYROSCOPE_SENSITIVITY_250;
+    std::unique_ptr<OrientationFilter> _orientationFilter;
+
+    int _interruptLine = -1; // GPIO wired to the INT pin, -1 when not wired
+    std::unique_ptr<GpioEventLine> _interruptEvents;
+    std::thread _samplerThread;
+    std::atomic<bool> _isSampling{false};
+    std::atomic<bool> _isInterruptDriven{false};
+    std::mutex _imuMutex; // The driver is shared with the sampler thread
+    ImuSampleRing _sampleRing;
+    ImuSampleRing::Cursor _captureCursor = 0;
+
+    std::atomic<ImuCalibrationState> _calibrationState{calibrationIdle};
+    imu_calibration_progress_t _calibrationProgress;
+    imu_offset_t _previousOffsets;
+    uint8_t _previousGyroscopeRange = MPU6050_GYRO_FS_250;
+    uint8_t _previousRate = 0;
+    uint16_t _calibrationSampleCount = 0;
+
+    // Accelerometer axes, then gyroscope axes
+    RunningStatistics _calibrationStatistics[2 * NUMBER_OF_AXIS];
+    double _calibrationSensitivities[2 * NUMBER_OF_AXIS];
+    double _previousCalibrationMeans[2 * NUMBER_OF_AXIS];
+    int _previousCalibrationOffsets[2 * NUMBER_OF_AXIS];
+
+    static FusionAlgorithm _fusionAlgorithm;
+    static uint16_t _fifoSampleRate;
+    static bool _areInterruptsEnabled;
+
+    bool StartFifoAcquisition(uint16_t sampleRate);
+    bool StartDmpAcquisition();
+    void ResetFifo();
+    bool ReadFifo(std::vector<imu_sample_t> &samples, uint64_t newestTime);
+
+    bool StartSampler();
+    void StopSampler();
+    void RunSampler();
+
+    static const std::vector<uint8_t> &GetDmpFirmware();
+
+    void StartCalibrationPass();
+    bool IsCalibrationPassPrecise();
+    bool SolveCalibrationOffsets();
+    int &GetCalibrationOffset(uint8_t channel);
+    void EndCalibration(bool isSuccessful);
 
     void SetImuOffsets(MPU6050 &mpu);
     void SetImuAccelOffsets(MPU6050 &mpu);
@@ -47,9 +184,6 @@ class Imu : public Sensor
     void ResetIMUOffsets(MPU6050 &mpu);
     void ResetIMUAccelOffsets(MPU6050 &mpu);
     void ResetIMUGyroOffsets(MPU6050 &mpu);
-
-    void GetAccelerometerMeans(MPU6050 &mpu, int accbuff[]);
-    void GetGyroscopeMeans(MPU6050 &mpu, int gyrobuff[]);
 };
 
 #endif // IMU_H
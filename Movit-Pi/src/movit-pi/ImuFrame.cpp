@@ -0,0 +1,84 @@
+#include "ImuFrame.h"
+
+#include "FastMath.h"
+
+ImuFrame::ImuFrame()
+{
+}
+
+ImuFrame::ImuFrame(uint64_t timestamp, const double *accelerations, const double *rotations) : _isValid(true), _timestamp(timestamp)
+{
+    for (uint8_t axis = 0; axis < NUMBER_OF_AXIS; axis++)
+    {
+        _accelerations[axis] = accelerations[axis];
+        _rotations[axis] = rotations[axis];
+    }
+}
+
+ImuFrame::ImuFrame(uint64_t timestamp, const double *accelerations, const double *rotations, const double *quaternion) : ImuFrame(timestamp, accelerations, rotations)
+{
+    _hasOrientation = true;
+    for (uint8_t i = 0; i < 4; i++)
+    {
+        _quaternion[i] = quaternion[i];
+    }
+}
+
+double ImuFrame::GetAcceleration(AXIS axis)
+{
+    return _accelerations[axis];
+}
+
+double ImuFrame::GetRotation(AXIS axis)
+{
+    return _rotations[axis];
+}
+
+void ImuFrame::GetQuaternion(double *quaternion)
+{
+    for (uint8_t i = 0; i < 4; i++)
+    {
+        quaternion[i] = _quaternion[i];
+    }
+}
+
+double ImuFrame::GetPitch()
+{
+    ComputeAngles();
+    return _pitch;
+}
+
+double ImuFrame::GetRoll()
+{
+    ComputeAngles();
+    return _roll;
+}
+
+void ImuFrame::ComputeAngles()
+{
+    if (_areAnglesComputed)
+    {
+        return;
+    }
+
+    // Direction of gravity in the IMU axes. The one given by the DMP is
+    // stabilised by the gyroscope, unlike the measured accelerations.
+    double gravity[NUMBER_OF_AXIS];
+    if (_hasOrientation)
+    {
+        const double *q = _quaternion;
+        gravity[AXIS::x] = 2 * (q[1] * q[3] - q[0] * q[2]);
+        gravity[AXIS::y] = 2 * (q[0] * q[1] + q[2] * q[3]);
+        gravity[AXIS::z] = q[0] * q[0] - q[1] * q[1] - q[2] * q[2] + q[3] * q[3];
+    }
+    else
+    {
+        for (uint8_t axis = 0; axis < NUMBER_OF_AXIS; axis++)
+        {
+            gravity[axis] = _accelerations[axis];
+        }
+    }
+
+    ComputeTiltAngles(gravity, _pitch, _roll);
+    _areAnglesComputed = true;
+}
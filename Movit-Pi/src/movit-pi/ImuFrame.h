@@ -0,0 +1,47 @@
+#ifndef IMU_FRAME_H
+#define IMU_FRAME_H
+
+#include "DataType.h"
+#include "Utils.h"
+
+#include <stdint.h>
+
+// Accelerations and rotations of an IMU captured once per tick, shared by all
+// the consumers of the tick so that they see the same instant. The angles are
+// computed on first access, from the orientation computed by the DMP when
+// there is one, else from the accelerations.
+class ImuFrame
+{
+  public:
+    ImuFrame();
+    // Accelerations in g, rotations in degrees per second
+    ImuFrame(uint64_t timestamp, const double *accelerations, const double *rotations);
+    // With the orientation of the IMU, as a unit quaternion (w, x, y, z)
+    ImuFrame(uint64_t timestamp, const double *accelerations, const double *rotations, const double *quaternion);
+
+    bool IsValid() { return _isValid; }
+    uint64_t GetTimestamp() { return _timestamp; }
+
+    double GetAcceleration(AXIS axis); // In g
+    double GetRotation(AXIS axis);     // In degrees per second
+    bool HasOrientation() { return _hasOrientation; }
+    void GetQuaternion(double *quaternion);
+    double GetPitch();
+    double GetRoll();
+
+  private:
+    void ComputeAngles();
+
+    bool _isValid = false;
+    uint64_t _timestamp = 0; // Steady clock, in microseconds
+    double _accelerations[NUMBER_OF_AXIS] = {0, 0, 0};
+    double _rotations[NUMBER_OF_AXIS] = {0, 0, 0};
+    bool _hasOrientation = false;
+    double _quaternion[4] = {1, 0, 0, 0};
+
+    bool _areAnglesComputed = false;
+    double _pitch = 0;
+    double _roll = 0;
+};
+
+#endif // IMU_FRAME_H
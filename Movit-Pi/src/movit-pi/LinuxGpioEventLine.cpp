@@ -0,0 +1,113 @@
+#include "LinuxGpioEventLine.h"
+
+#include <chrono>
+#include <fcntl.h>
+#include <linux/gpio.h>
+#include <poll.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/eventfd.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+LinuxGpioEventLine::LinuxGpioEventLine(std::string chip, unsigned line) : _chip(chip), _line(line)
+{
+}
+
+LinuxGpioEventLine::~LinuxGpioEventLine()
+{
+    Close();
+}
+
+bool LinuxGpioEventLine::Open()
+{
+    Close();
+
+    int chipFd = open(_chip.c_str(), O_RDONLY);
+    if (chipFd < 0)
+    {
+        printf("Error: Unable to open %s\n", _chip.c_str());
+        return false;
+    }
+
+    struct gpioevent_request request;
+    memset(&request, 0, sizeof(request));
+    request.lineoffset = _line;
+    request.handleflags = GPIOHANDLE_REQUEST_INPUT;
+    request.eventflags = GPIOEVENT_REQUEST_RISING_EDGE;
+    strncpy(request.consumer_label, "movit-pi", sizeof(request.consumer_label) - 1);
+
+    int status = ioctl(chipFd, GPIO_GET_LINEEVENT_IOCTL, &request);
+    close(chipFd);
+    if (status < 0)
+    {
+        printf("Error: Unable to request the edges of GPIO %u on %s\n", _line, _chip.c_str());
+        return false;
+    }
+
+    _eventFd = request.fd;
+    _wakeFd = eventfd(0, EFD_NONBLOCK);
+    return _wakeFd >= 0;
+}
+
+void LinuxGpioEventLine::Close()
+{
+    if (_eventFd >= 0)
+    {
+        close(_eventFd);
+        _eventFd = -1;
+    }
+    if (_wakeFd >= 0)
+    {
+        close(_wakeFd);
+        _wakeFd = -1;
+    }
+}
+
+GpioWaitResult LinuxGpioEventLine::Wait(int timeoutMs, uint64_t &timestamp)
+{
+    if (_eventFd < 0)
+    {
+        return gpioError;
+    }
+
+    struct pollfd fds[2] = {{_eventFd, POLLIN, 0}, {_wakeFd, POLLIN, 0}};
+    int count = PollWithoutInterruption(fds, 2, timeoutMs);
+    if (count < 0 || (fds[1].revents & POLLIN))
+    {
+        return gpioError;
+    }
+    if (count == 0)
+    {
+        return gpioTimeout;
+    }
+
+    // The event timestamps are not on the steady clock with every kernel
+    timestamp = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+
+    // Empty the queue, the edges are coalesced
+    struct gpioevent_data events[16];
+    ssize_t length = read(_eventFd, events, sizeof(events));
+    while (length == sizeof(events))
+    {
+        struct pollfd pending = {_eventFd, POLLIN, 0};
+        if (poll(&pending, 1, 0) <= 0)
+        {
+            break;
+        }
+        length = read(_eventFd, events, sizeof(events));
+    }
+    return length > 0 ? gpioEdge : gpioError;
+}
+
+void LinuxGpioEventLine::Interrupt()
+{
+    if (_wakeFd >= 0)
+    {
+        uint64_t value = 1;
+        if (write(_wakeFd, &value, sizeof(value)) < 0)
+        {
+            printf("Error: Unable to wake the GPIO %u waiter\n", _line);
+        }
+    }
+}
@@ -0,0 +1,26 @@
+#ifndef LINUX_GPIO_EVENT_LINE_H
+#define LINUX_GPIO_EVENT_LINE_H
+
+#include "GpioEventLine.h"
+
+// GPIO edges through the gpiochip character device. The kernel timestamps and
+// queues the edges, the waiting thread sleeps in poll().
+class LinuxGpioEventLine : public GpioEventLine
+{
+  public:
+    LinuxGpioEventLine(std::string chip, unsigned line);
+    ~LinuxGpioEventLine();
+
+    bool Open();
+    void Close();
+    GpioWaitResult Wait(int timeoutMs, uint64_t &timestamp);
+    void Interrupt();
+
+  private:
+    std::string _chip;
+    unsigned _line;
+    int _eventFd = -1;
+    int _wakeFd = -1;
+};
+
+#endif // LINUX_GPIO_EVENT_LINE_H
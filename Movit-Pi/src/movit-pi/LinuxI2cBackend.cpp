@@ -0,0 +1,62 @@
+#include "LinuxI2cBackend.h"
+
+#include <fcntl.h>
+#include <linux/i2c.h>
+#include <linux/i2c-dev.h>
+#include <stdio.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+LinuxI2cBackend::LinuxI2cBackend(std::string device) : _device(device)
+{
+}
+
+LinuxI2cBackend::~LinuxI2cBackend()
+{
+    Close();
+}
+
+bool LinuxI2cBackend::Open()
+{
+    Close();
+
+    _fd = open(_device.c_str(), O_RDWR);
+    if (_fd < 0)
+    {
+        printf("Error: Unable to open %s\n", _device.c_str());
+        return false;
+    }
+    return true;
+}
+
+void LinuxI2cBackend::Close()
+{
+    if (_fd >= 0)
+    {
+        close(_fd);
+        _fd = -1;
+    }
+}
+
+bool LinuxI2cBackend::Transfer(i2c_segment_t *segments, uint8_t count)
+{
+    if (_fd < 0 || count == 0 || count > I2C_MAX_SEGMENTS)
+    {
+        return false;
+    }
+
+    struct i2c_msg messages[I2C_MAX_SEGMENTS];
+    for (uint8_t i = 0; i < count; i++)
+    {
+        messages[i].addr = segments[i].devAddr;
+        messages[i].flags = segments[i].isRead ? I2C_M_RD : 0;
+        messages[i].len = segments[i].length;
+        messages[i].buf = segments[i].data;
+    }
+
+    struct i2c_rdwr_ioctl_data transaction;
+    transaction.msgs = messages;
+    transaction.nmsgs = count;
+
+    return ioctl(_fd, I2C_RDWR, &transaction) == count;
+}
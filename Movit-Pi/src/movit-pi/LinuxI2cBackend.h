@@ -0,0 +1,27 @@
+#ifndef LINUX_I2C_BACKEND_H
+#define LINUX_I2C_BACKEND_H
+
+#include "I2cBackend.h"
+#include <string>
+
+#define LINUX_I2C_DEFAULT_DEVICE "/dev/i2c-1"
+
+// I2C through the kernel i2c-dev driver. A whole transfer is handed to the
+// kernel in a single ioctl(I2C_RDWR), so a register read (pointer write,
+// repeated start, read) costs one system call whatever its length.
+class LinuxI2cBackend : public I2cBackend
+{
+  public:
+    LinuxI2cBackend(std::string device);
+    ~LinuxI2cBackend();
+
+    bool Open();
+    void Close();
+    bool Transfer(i2c_segment_t *segments, uint8_t count);
+
+  private:
+    std::string _device;
+    int _fd = -1;
+};
+
+#endif // LINUX_I2C_BACKEND_H
@@ -15,16 +15,30 @@ DATASHEET: https://datasheets.maximintegrated.com/en/ds/MAX11606-MAX11611.pdf
 MAX11611::MAX11611()
 {
     _devAddr = MAX11611_DEFAULT_ADDRESS;
+    _bus = I2Cdev::GetBus(sensorBus);
 }
 
 // Specific address constructor.
-MAX11611::MAX11611(uint8_t address)
+MAX11611::MAX11611(uint8_t address, I2cBusId busId)
 {
     _devAddr = address;
+    _bus = I2Cdev::GetBus(busId);
 }
 
-bool MAX11611::Initialize()
+// Constructor for an ADC behind an I2C mux, or on any given bus instance.
+MAX11611::MAX11611(uint8_t address, I2Cdev *bus)
 {
+    _devAddr = address;
+    _bus = bus;
+}
+
+bool MAX11611::Initialize(uint8_t channelCount)
+{
+    if (channelCount == 0 || channelCount > MAX11611_CHANNEL_COUNT)
+    {
+        return false;
+    }
+
     //Setup Byte Format (Datasheet p.13)
     /*
 	bit7 = 1; //Setup
@@ -39,7 +53,7 @@ bool MAX11611::Initialize()
     uint8_t dataToSend;
 
     dataToSend = 0x8A; //10001010
-    if (!I2Cdev::WriteByte(_devAddr, dataToSend))
+    if (!_bus->WriteByte(_devAddr, dataToSend))
     {
         return false;
     }
@@ -55,8 +69,9 @@ bool MAX11611::Initialize()
 	bit1 = 0; //CS0
 	bit0 = 1; //Single-ended
 	*/
-    dataToSend = 0x11; //0b00010001
-    if (!I2Cdev::WriteByte(_devAddr, dataToSend))
+    // CS3-CS0: last channel of the scan, 0x11 for the 9 channels of the 3x3 mat
+    dataToSend = static_cast<uint8_t>(((channelCount - 1) << 1) | 0x01);
+    if (!_bus->WriteByte(_devAddr, dataToSend))
     {
         return false;
     }
@@ -88,7 +103,7 @@ void MAX11611::GetData(uint8_t nbOfAnalogDevices, uint16_t *realData)
     //ReadBytes(2 * nbOfAnalogDevices, rawData); //2 bytes par capteur (car valeur sur 10 bits (fig.11 datasheet p.16))
     //Nouveau call à implémenter
     //mise en commentaire des 4 printfs, decommenter pour debug
-    I2Cdev::ReadBytes(MAX11611_DEFAULT_ADDRESS, 2 * nbOfAnalogDevices, rawData);
+    _bus->ReadBytes(_devAddr, 2 * nbOfAnalogDevices, rawData);
 
     for (int i = 0; i < (2 * nbOfAnalogDevices); i++)
     {
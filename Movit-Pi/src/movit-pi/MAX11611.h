@@ -13,18 +13,22 @@ DATASHEET: https://datasheets.maximintegrated.com/en/ds/MAX11606-MAX11611.pdf
 #include "I2Cdev.h"
 
 #define MAX11611_DEFAULT_ADDRESS 0x35 //0b00110101
+#define MAX11611_CHANNEL_COUNT 12
 #define BUFFER_LENGTH 32
 
 class MAX11611
 {
   public:
     MAX11611();
-    MAX11611(uint8_t address);
+    MAX11611(uint8_t address, I2cBusId busId = sensorBus);
+    MAX11611(uint8_t address, I2Cdev *bus);
 
-    bool Initialize();
+    // Scans AIN0 to AIN(channelCount - 1)
+    bool Initialize(uint8_t channelCount = 9);
     void GetData(uint8_t nbOfAnalogDevices, uint16_t *realData);
 
   private:
+    I2Cdev *_bus;
     uint8_t _devAddr;
 };
 
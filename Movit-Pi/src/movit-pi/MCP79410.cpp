@@ -24,41 +24,48 @@
 MCP79410::MCP79410()
 {
     _devAddr = ADDR_MCP79410;
+    _bus = I2Cdev::GetBus(peripheralBus);
 }
 
 void MCP79410::SetDefaultDateTime()
 {
-    I2Cdev::WriteByte(_devAddr, ADDR_SEC, DISABLE_OSCILLATOR);
+    _bus->WriteByte(_devAddr, ADDR_SEC, DISABLE_OSCILLATOR);
     sleep_for_microseconds(STOP_RTC_SLEEP_TIME);
-    I2Cdev::WriteByte(_devAddr, ADDR_SEC, DEFAULT_SEC);
-    I2Cdev::WriteByte(_devAddr, ADDR_MIN, DEFAULT_MIN);
-    I2Cdev::WriteByte(_devAddr, ADDR_HOUR, DEFAULT_HOUR);
-    I2Cdev::WriteByte(_devAddr, ADDR_DAY, DEFAULT_DAY);
-    I2Cdev::WriteByte(_devAddr, ADDR_DATE, DEFAULT_DATE);
-    I2Cdev::WriteByte(_devAddr, ADDR_MNTH, DEFAULT_MNTH);
-    I2Cdev::WriteByte(_devAddr, ADDR_YEAR, DEFAULT_YEAR);
-    I2Cdev::WriteByte(_devAddr, ADDR_SEC, ENABLE_OSCILLATOR);
+
+    I2cBatch batch;
+    batch.WriteByte(_devAddr, ADDR_SEC, DEFAULT_SEC);
+    batch.WriteByte(_devAddr, ADDR_MIN, DEFAULT_MIN);
+    batch.WriteByte(_devAddr, ADDR_HOUR, DEFAULT_HOUR);
+    batch.WriteByte(_devAddr, ADDR_DAY, DEFAULT_DAY);
+    batch.WriteByte(_devAddr, ADDR_DATE, DEFAULT_DATE);
+    batch.WriteByte(_devAddr, ADDR_MNTH, DEFAULT_MNTH);
+    batch.WriteByte(_devAddr, ADDR_YEAR, DEFAULT_YEAR);
+    batch.WriteByte(_devAddr, ADDR_SEC, ENABLE_OSCILLATOR);
+    _bus->Submit(batch);
 }
 
 void MCP79410::SetDateTime(uint8_t dt[])
 {
     SetLeapYearBit(dt);
-    I2Cdev::WriteByte(_devAddr, ADDR_SEC, DISABLE_OSCILLATOR);        //STOP MCP79410
+    _bus->WriteByte(_devAddr, ADDR_SEC, DISABLE_OSCILLATOR);       //STOP MCP79410
     sleep_for_microseconds(STOP_RTC_SLEEP_TIME);
-    I2Cdev::WriteByte(_devAddr, ADDR_SEC, DISABLE_OSCILLATOR);        //STOP MCP79410
-    I2Cdev::WriteByte(_devAddr, ADDR_MIN, dt[1]);                     //MINUTE=20
-    I2Cdev::WriteByte(_devAddr, ADDR_HOUR, dt[2] & 0x3f);             //HOUR=dt[2], forcing 24h format
-    I2Cdev::WriteByte(_devAddr, ADDR_DAY, dt[3] | 0x0F);              //DAY=dt[3] AND VBAT=1
-    I2Cdev::WriteByte(_devAddr, ADDR_DATE, dt[4]);                    //DATE=dt[4]
-    I2Cdev::WriteByte(_devAddr, ADDR_MNTH, dt[5]);                    //MONTH=dt[5]
-    I2Cdev::WriteByte(_devAddr, ADDR_YEAR, dt[6]);                    //YEAR=dt[6]
-    I2Cdev::WriteByte(_devAddr, ADDR_SEC, ENABLE_OSCILLATOR | dt[0]); //START  MCP79410, SECOND=dt[0];
+
+    I2cBatch batch;
+    batch.WriteByte(_devAddr, ADDR_SEC, DISABLE_OSCILLATOR);        //STOP MCP79410
+    batch.WriteByte(_devAddr, ADDR_MIN, dt[1]);                     //MINUTE=20
+    batch.WriteByte(_devAddr, ADDR_HOUR, dt[2] & 0x3f);             //HOUR=dt[2], forcing 24h format
+    batch.WriteByte(_devAddr, ADDR_DAY, dt[3] | 0x0F);              //DAY=dt[3] AND VBAT=1
+    batch.WriteByte(_devAddr, ADDR_DATE, dt[4]);                    //DATE=dt[4]
+    batch.WriteByte(_devAddr, ADDR_MNTH, dt[5]);                    //MONTH=dt[5]
+    batch.WriteByte(_devAddr, ADDR_YEAR, dt[6]);                    //YEAR=dt[6]
+    batch.WriteByte(_devAddr, ADDR_SEC, ENABLE_OSCILLATOR | dt[0]); //START  MCP79410, SECOND=dt[0];
+    _bus->Submit(batch);
 }
 
 void MCP79410::GetDateTime(uint8_t dt[])
 {
     uint8_t buffer[DATE_TIME_SIZE];
-    I2Cdev::ReadBytes(_devAddr, ADDR_SEC, DATE_TIME_SIZE, buffer);
+    _bus->ReadBytes(_devAddr, ADDR_SEC, DATE_TIME_SIZE, buffer);
     for (uint8_t i = 0; i < DATE_TIME_SIZE; i++)
     {
         dt[i] = buffer[i] & 0xFF >> (8 - _validBits[i]);
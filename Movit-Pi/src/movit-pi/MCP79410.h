@@ -63,6 +63,7 @@ class MCP79410
     void GetDateTime(uint8_t dt[]);
 
   private:
+    I2Cdev *_bus;
     uint8_t _devAddr;
     bool IsALeapYear(uint16_t year);
     void SetLeapYearBit(uint8_t dt[]);
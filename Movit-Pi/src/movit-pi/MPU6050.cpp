@@ -36,12 +36,16 @@ THE SOFTWARE.
 
 #include "MPU6050.h"
 
+#include <string.h>
+
 /** Default constructor, uses default I2C address.
  * @see MPU6050_DEFAULT_ADDRESS
  */
 MPU6050::MPU6050()
 {
     _devAddr = MPU6050_DEFAULT_ADDRESS;
+    _bus = I2Cdev::GetBus(sensorBus);
+    SetCacheableRegisters();
 }
 
 /** Specific address constructor.
@@ -50,9 +54,37 @@ MPU6050::MPU6050()
  * @see MPU6050_ADDRESS_AD0_LOW
  * @see MPU6050_ADDRESS_AD0_HIGH
  */
-MPU6050::MPU6050(uint8_t address)
+MPU6050::MPU6050(uint8_t address, I2cBusId busId)
+{
+    _devAddr = address;
+    _bus = I2Cdev::GetBus(busId);
+    SetCacheableRegisters();
+}
+
+/** Constructor for an IMU behind an I2C mux, or on any given bus instance.
+ * @param address I2C address
+ * @param bus Bus instance, for instance from I2Cdev::GetMuxChannel()
+ */
+MPU6050::MPU6050(uint8_t address, I2Cdev *bus)
 {
     _devAddr = address;
+    _bus = bus;
+    SetCacheableRegisters();
+}
+
+/** Declare the registers only written by the host, so that the read-modify-write
+ * of their bit fields is served from the bus register cache. Status, data, FIFO,
+ * DMP memory and self-clearing reset registers are always read from the device.
+ */
+void MPU6050::SetCacheableRegisters()
+{
+    _bus->SetCacheable(_devAddr, MPU6050_RA_XA_OFFS_H, 6);
+    _bus->SetCacheable(_devAddr, MPU6050_RA_XG_OFFS_USRH, 6);
+    _bus->SetCacheable(_devAddr, MPU6050_RA_SMPLRT_DIV, MPU6050_RA_I2C_SLV4_CTRL - MPU6050_RA_SMPLRT_DIV + 1);
+    _bus->SetCacheable(_devAddr, MPU6050_RA_INT_PIN_CFG, 2);
+    _bus->SetCacheable(_devAddr, MPU6050_RA_I2C_SLV0_DO, MPU6050_RA_I2C_MST_DELAY_CTRL - MPU6050_RA_I2C_SLV0_DO + 1);
+    _bus->SetCacheable(_devAddr, MPU6050_RA_MOT_DETECT_CTRL);
+    _bus->SetCacheable(_devAddr, MPU6050_RA_PWR_MGMT_1, 2);
 }
 
 /** Power on and prepare for general usage.
@@ -89,7 +121,7 @@ bool MPU6050::TestConnection()
  */
 uint8_t MPU6050::GetAuxVDDIOLevel()
 {
-    I2Cdev::ReadBit(_devAddr, MPU6050_RA_YG_OFFS_TC, MPU6050_TC_PWR_MODE_BIT, _buffer);
+    _bus->ReadBit(_devAddr, MPU6050_RA_YG_OFFS_TC, MPU6050_TC_PWR_MODE_BIT, _buffer);
     return _buffer[0];
 }
 /** Set the auxiliary I2C supply voltage level.
@@ -100,7 +132,7 @@ uint8_t MPU6050::GetAuxVDDIOLevel()
  */
 void MPU6050::SetAuxVDDIOLevel(uint8_t level)
 {
-    I2Cdev::WriteBit(_devAddr, MPU6050_RA_YG_OFFS_TC, MPU6050_TC_PWR_MODE_BIT, level);
+    _bus->WriteBit(_devAddr, MPU6050_RA_YG_OFFS_TC, MPU6050_TC_PWR_MODE_BIT, level);
 }
 
 // SMPLRT_DIV register
@@ -128,7 +160,7 @@ void MPU6050::SetAuxVDDIOLevel(uint8_t level)
  */
 uint8_t MPU6050::GetRate()
 {
-    I2Cdev::ReadByte(_devAddr, MPU6050_RA_SMPLRT_DIV, _buffer);
+    _bus->ReadByte(_devAddr, MPU6050_RA_SMPLRT_DIV, _buffer);
     return _buffer[0];
 }
 /** Set gyroscope sample rate divider.
@@ -138,7 +170,7 @@ uint8_t MPU6050::GetRate()
  */
 void MPU6050::SetRate(uint8_t rate)
 {
-    I2Cdev::WriteByte(_devAddr, MPU6050_RA_SMPLRT_DIV, rate);
+    _bus->WriteByte(_devAddr, MPU6050_RA_SMPLRT_DIV, rate);
 }
 
 // CONFIG register
@@ -172,7 +204,7 @@ void MPU6050::SetRate(uint8_t rate)
  */
 uint8_t MPU6050::GetExternalFrameSync()
 {
-    I2Cdev::ReadBits(_devAddr, MPU6050_RA_CONFIG, MPU6050_CFG_EXT_SYNC_SET_BIT, MPU6050_CFG_EXT_SYNC_SET_LENGTH, _buffer);
+    _bus->ReadBits(_devAddr, MPU6050_RA_CONFIG, MPU6050_CFG_EXT_SYNC_SET_BIT, MPU6050_CFG_EXT_SYNC_SET_LENGTH, _buffer);
     return _buffer[0];
 }
 /** Set external FSYNC configuration.
@@ -182,7 +214,7 @@ uint8_t MPU6050::GetExternalFrameSync()
  */
 void MPU6050::SetExternalFrameSync(uint8_t sync)
 {
-    I2Cdev::WriteBits(_devAddr, MPU6050_RA_CONFIG, MPU6050_CFG_EXT_SYNC_SET_BIT, MPU6050_CFG_EXT_SYNC_SET_LENGTH, sync);
+    _bus->WriteBits(_devAddr, MPU6050_RA_CONFIG, MPU6050_CFG_EXT_SYNC_SET_BIT, MPU6050_CFG_EXT_SYNC_SET_LENGTH, sync);
 }
 /** Get digital low-pass filter configuration.
  * The DLPF_CFG parameter sets the digital low pass filter configuration. It
@@ -214,7 +246,7 @@ void MPU6050::SetExternalFrameSync(uint8_t sync)
  */
 uint8_t MPU6050::GetDLPFMode()
 {
-    I2Cdev::ReadBits(_devAddr, MPU6050_RA_CONFIG, MPU6050_CFG_DLPF_CFG_BIT, MPU6050_CFG_DLPF_CFG_LENGTH, _buffer);
+    _bus->ReadBits(_devAddr, MPU6050_RA_CONFIG, MPU6050_CFG_DLPF_CFG_BIT, MPU6050_CFG_DLPF_CFG_LENGTH, _buffer);
     return _buffer[0];
 }
 /** Set digital low-pass filter configuration.
@@ -227,7 +259,7 @@ uint8_t MPU6050::GetDLPFMode()
  */
 void MPU6050::SetDLPFMode(uint8_t mode)
 {
-    I2Cdev::WriteBits(_devAddr, MPU6050_RA_CONFIG, MPU6050_CFG_DLPF_CFG_BIT, MPU6050_CFG_DLPF_CFG_LENGTH, mode);
+    _bus->WriteBits(_devAddr, MPU6050_RA_CONFIG, MPU6050_CFG_DLPF_CFG_BIT, MPU6050_CFG_DLPF_CFG_LENGTH, mode);
 }
 
 // GYRO_CONFIG register
@@ -251,7 +283,7 @@ void MPU6050::SetDLPFMode(uint8_t mode)
  */
 uint8_t MPU6050::GetFullScaleGyroRange()
 {
-    I2Cdev::ReadBits(_devAddr, MPU6050_RA_GYRO_CONFIG, MPU6050_GCONFIG_FS_SEL_BIT, MPU6050_GCONFIG_FS_SEL_LENGTH, _buffer);
+    _bus->ReadBits(_devAddr, MPU6050_RA_GYRO_CONFIG, MPU6050_GCONFIG_FS_SEL_BIT, MPU6050_GCONFIG_FS_SEL_LENGTH, _buffer);
     return _buffer[0];
 }
 /** Set full-scale gyroscope range.
@@ -264,7 +296,7 @@ uint8_t MPU6050::GetFullScaleGyroRange()
  */
 void MPU6050::SetFullScaleGyroRange(uint8_t range)
 {
-    I2Cdev::WriteBits(_devAddr, MPU6050_RA_GYRO_CONFIG, MPU6050_GCONFIG_FS_SEL_BIT, MPU6050_GCONFIG_FS_SEL_LENGTH, range);
+    _bus->WriteBits(_devAddr, MPU6050_RA_GYRO_CONFIG, MPU6050_GCONFIG_FS_SEL_BIT, MPU6050_GCONFIG_FS_SEL_LENGTH, range);
 }
 
 // ACCEL_CONFIG register
@@ -275,7 +307,7 @@ void MPU6050::SetFullScaleGyroRange(uint8_t range)
  */
 bool MPU6050::GetAccelXSelfTest()
 {
-    I2Cdev::ReadBit(_devAddr, MPU6050_RA_ACCEL_CONFIG, MPU6050_ACONFIG_XA_ST_BIT, _buffer);
+    _bus->ReadBit(_devAddr, MPU6050_RA_ACCEL_CONFIG, MPU6050_ACONFIG_XA_ST_BIT, _buffer);
     return _buffer[0];
 }
 /** Get self-test enabled setting for accelerometer X axis.
@@ -284,7 +316,7 @@ bool MPU6050::GetAccelXSelfTest()
  */
 void MPU6050::SetAccelXSelfTest(bool enabled)
 {
-    I2Cdev::WriteBit(_devAddr, MPU6050_RA_ACCEL_CONFIG, MPU6050_ACONFIG_XA_ST_BIT, enabled);
+    _bus->WriteBit(_devAddr, MPU6050_RA_ACCEL_CONFIG, MPU6050_ACONFIG_XA_ST_BIT, enabled);
 }
 /** Get self-test enabled value for accelerometer Y axis.
  * @return Self-test enabled value
@@ -292,7 +324,7 @@ void MPU6050::SetAccelXSelfTest(bool enabled)
  */
 bool MPU6050::GetAccelYSelfTest()
 {
-    I2Cdev::ReadBit(_devAddr, MPU6050_RA_ACCEL_CONFIG, MPU6050_ACONFIG_YA_ST_BIT, _buffer);
+    _bus->ReadBit(_devAddr, MPU6050_RA_ACCEL_CONFIG, MPU6050_ACONFIG_YA_ST_BIT, _buffer);
     return _buffer[0];
 }
 /** Get self-test enabled value for accelerometer Y axis.
@@ -301,7 +333,7 @@ bool MPU6050::GetAccelYSelfTest()
  */
 void MPU6050::SetAccelYSelfTest(bool enabled)
 {
-    I2Cdev::WriteBit(_devAddr, MPU6050_RA_ACCEL_CONFIG, MPU6050_ACONFIG_YA_ST_BIT, enabled);
+    _bus->WriteBit(_devAddr, MPU6050_RA_ACCEL_CONFIG, MPU6050_ACONFIG_YA_ST_BIT, enabled);
 }
 /** Get self-test enabled value for accelerometer Z axis.
  * @return Self-test enabled value
@@ -309,7 +341,7 @@ void MPU6050::SetAccelYSelfTest(bool enabled)
  */
 bool MPU6050::GetAccelZSelfTest()
 {
-    I2Cdev::ReadBit(_devAddr, MPU6050_RA_ACCEL_CONFIG, MPU6050_ACONFIG_ZA_ST_BIT, _buffer);
+    _bus->ReadBit(_devAddr, MPU6050_RA_ACCEL_CONFIG, MPU6050_ACONFIG_ZA_ST_BIT, _buffer);
     return _buffer[0];
 }
 /** Set self-test enabled value for accelerometer Z axis.
@@ -318,7 +350,7 @@ bool MPU6050::GetAccelZSelfTest()
  */
 void MPU6050::SetAccelZSelfTest(bool enabled)
 {
-    I2Cdev::WriteBit(_devAddr, MPU6050_RA_ACCEL_CONFIG, MPU6050_ACONFIG_ZA_ST_BIT, enabled);
+    _bus->WriteBit(_devAddr, MPU6050_RA_ACCEL_CONFIG, MPU6050_ACONFIG_ZA_ST_BIT, enabled);
 }
 /** Get full-scale accelerometer range.
  * The FS_SEL parameter allows setting the full-scale range of the accelerometer
@@ -339,7 +371,7 @@ void MPU6050::SetAccelZSelfTest(bool enabled)
  */
 uint8_t MPU6050::GetFullScaleAccelRange()
 {
-    I2Cdev::ReadBits(_devAddr, MPU6050_RA_ACCEL_CONFIG, MPU6050_ACONFIG_AFS_SEL_BIT, MPU6050_ACONFIG_AFS_SEL_LENGTH, _buffer);
+    _bus->ReadBits(_devAddr, MPU6050_RA_ACCEL_CONFIG, MPU6050_ACONFIG_AFS_SEL_BIT, MPU6050_ACONFIG_AFS_SEL_LENGTH, _buffer);
     return _buffer[0];
 }
 /** Set full-scale accelerometer range.
@@ -348,7 +380,7 @@ uint8_t MPU6050::GetFullScaleAccelRange()
  */
 void MPU6050::SetFullScaleAccelRange(uint8_t range)
 {
-    I2Cdev::WriteBits(_devAddr, MPU6050_RA_ACCEL_CONFIG, MPU6050_ACONFIG_AFS_SEL_BIT, MPU6050_ACONFIG_AFS_SEL_LENGTH, range);
+    _bus->WriteBits(_devAddr, MPU6050_RA_ACCEL_CONFIG, MPU6050_ACONFIG_AFS_SEL_BIT, MPU6050_ACONFIG_AFS_SEL_LENGTH, range);
 }
 /** Get the high-pass filter configuration.
  * The DHPF is a filter module in the path leading to motion detectors (Free
@@ -387,7 +419,7 @@ void MPU6050::SetFullScaleAccelRange(uint8_t range)
  */
 uint8_t MPU6050::GetDHPFMode()
 {
-    I2Cdev::ReadBits(_devAddr, MPU6050_RA_ACCEL_CONFIG, MPU6050_ACONFIG_ACCEL_HPF_BIT, MPU6050_ACONFIG_ACCEL_HPF_LENGTH, _buffer);
+    _bus->ReadBits(_devAddr, MPU6050_RA_ACCEL_CONFIG, MPU6050_ACONFIG_ACCEL_HPF_BIT, MPU6050_ACONFIG_ACCEL_HPF_LENGTH, _buffer);
     return _buffer[0];
 }
 /** Set the high-pass filter configuration.
@@ -398,7 +430,7 @@ uint8_t MPU6050::GetDHPFMode()
  */
 void MPU6050::SetDHPFMode(uint8_t bandwidth)
 {
-    I2Cdev::WriteBits(_devAddr, MPU6050_RA_ACCEL_CONFIG, MPU6050_ACONFIG_ACCEL_HPF_BIT, MPU6050_ACONFIG_ACCEL_HPF_LENGTH, bandwidth);
+    _bus->WriteBits(_devAddr, MPU6050_RA_ACCEL_CONFIG, MPU6050_ACONFIG_ACCEL_HPF_BIT, MPU6050_ACONFIG_ACCEL_HPF_LENGTH, bandwidth);
 }
 
 // FF_THR register
@@ -420,7 +452,7 @@ void MPU6050::SetDHPFMode(uint8_t bandwidth)
  */
 uint8_t MPU6050::GetFreefallDetectionThreshold()
 {
-    I2Cdev::ReadByte(_devAddr, MPU6050_RA_FF_THR, _buffer);
+    _bus->ReadByte(_devAddr, MPU6050_RA_FF_THR, _buffer);
     return _buffer[0];
 }
 /** Get free-fall event acceleration threshold.
@@ -430,7 +462,7 @@ uint8_t MPU6050::GetFreefallDetectionThreshold()
  */
 void MPU6050::SetFreefallDetectionThreshold(uint8_t threshold)
 {
-    I2Cdev::WriteByte(_devAddr, MPU6050_RA_FF_THR, threshold);
+    _bus->WriteByte(_devAddr, MPU6050_RA_FF_THR, threshold);
 }
 
 // FF_DUR register
@@ -454,7 +486,7 @@ void MPU6050::SetFreefallDetectionThreshold(uint8_t threshold)
  */
 uint8_t MPU6050::GetFreefallDetectionDuration()
 {
-    I2Cdev::ReadByte(_devAddr, MPU6050_RA_FF_DUR, _buffer);
+    _bus->ReadByte(_devAddr, MPU6050_RA_FF_DUR, _buffer);
     return _buffer[0];
 }
 /** Get free-fall event duration threshold.
@@ -464,7 +496,7 @@ uint8_t MPU6050::GetFreefallDetectionDuration()
  */
 void MPU6050::SetFreefallDetectionDuration(uint8_t duration)
 {
-    I2Cdev::WriteByte(_devAddr, MPU6050_RA_FF_DUR, duration);
+    _bus->WriteByte(_devAddr, MPU6050_RA_FF_DUR, duration);
 }
 
 // MOT_THR register
@@ -490,7 +522,7 @@ void MPU6050::SetFreefallDetectionDuration(uint8_t duration)
  */
 uint8_t MPU6050::GetMotionDetectionThreshold()
 {
-    I2Cdev::ReadByte(_devAddr, MPU6050_RA_MOT_THR, _buffer);
+    _bus->ReadByte(_devAddr, MPU6050_RA_MOT_THR, _buffer);
     return _buffer[0];
 }
 /** Set free-fall event acceleration threshold.
@@ -500,7 +532,7 @@ uint8_t MPU6050::GetMotionDetectionThreshold()
  */
 void MPU6050::SetMotionDetectionThreshold(uint8_t threshold)
 {
-    I2Cdev::WriteByte(_devAddr, MPU6050_RA_MOT_THR, threshold);
+    _bus->WriteByte(_devAddr, MPU6050_RA_MOT_THR, threshold);
 }
 
 // MOT_DUR register
@@ -522,7 +554,7 @@ void MPU6050::SetMotionDetectionThreshold(uint8_t threshold)
  */
 uint8_t MPU6050::GetMotionDetectionDuration()
 {
-    I2Cdev::ReadByte(_devAddr, MPU6050_RA_MOT_DUR, _buffer);
+    _bus->ReadByte(_devAddr, MPU6050_RA_MOT_DUR, _buffer);
     return _buffer[0];
 }
 /** Set motion detection event duration threshold.
@@ -532,7 +564,7 @@ uint8_t MPU6050::GetMotionDetectionDuration()
  */
 void MPU6050::SetMotionDetectionDuration(uint8_t duration)
 {
-    I2Cdev::WriteByte(_devAddr, MPU6050_RA_MOT_DUR, duration);
+    _bus->WriteByte(_devAddr, MPU6050_RA_MOT_DUR, duration);
 }
 
 // ZRMOT_THR register
@@ -564,7 +596,7 @@ void MPU6050::SetMotionDetectionDuration(uint8_t duration)
  */
 uint8_t MPU6050::GetZeroMotionDetectionThreshold()
 {
-    I2Cdev::ReadByte(_devAddr, MPU6050_RA_ZRMOT_THR, _buffer);
+    _bus->ReadByte(_devAddr, MPU6050_RA_ZRMOT_THR, _buffer);
     return _buffer[0];
 }
 /** Set zero motion detection event acceleration threshold.
@@ -574,7 +606,7 @@ uint8_t MPU6050::GetZeroMotionDetectionThreshold()
  */
 void MPU6050::SetZeroMotionDetectionThreshold(uint8_t threshold)
 {
-    I2Cdev::WriteByte(_devAddr, MPU6050_RA_ZRMOT_THR, threshold);
+    _bus->WriteByte(_devAddr, MPU6050_RA_ZRMOT_THR, threshold);
 }
 
 // ZRMOT_DUR register
@@ -597,7 +629,7 @@ void MPU6050::SetZeroMotionDetectionThreshold(uint8_t threshold)
  */
 uint8_t MPU6050::GetZeroMotionDetectionDuration()
 {
-    I2Cdev::ReadByte(_devAddr, MPU6050_RA_ZRMOT_DUR, _buffer);
+    _bus->ReadByte(_devAddr, MPU6050_RA_ZRMOT_DUR, _buffer);
     return _buffer[0];
 }
 /** Set zero motion detection event duration threshold.
@@ -607,7 +639,7 @@ uint8_t MPU6050::GetZeroMotionDetectionDuration()
  */
 void MPU6050::SetZeroMotionDetectionDuration(uint8_t duration)
 {
-    I2Cdev::WriteByte(_devAddr, MPU6050_RA_ZRMOT_DUR, duration);
+    _bus->WriteByte(_devAddr, MPU6050_RA_ZRMOT_DUR, duration);
 }
 
 // FIFO_EN register
@@ -620,7 +652,7 @@ void MPU6050::SetZeroMotionDetectionDuration(uint8_t duration)
  */
 bool MPU6050::GetTempFIFOEnabled()
 {
-    I2Cdev::ReadBit(_devAddr, MPU6050_RA_FIFO_EN, MPU6050_TEMP_FIFO_EN_BIT, _buffer);
+    _bus->ReadBit(_devAddr, MPU6050_RA_FIFO_EN, MPU6050_TEMP_FIFO_EN_BIT, _buffer);
     return _buffer[0];
 }
 /** Set temperature FIFO enabled value.
@@ -630,7 +662,7 @@ bool MPU6050::GetTempFIFOEnabled()
  */
 void MPU6050::SetTempFIFOEnabled(bool enabled)
 {
-    I2Cdev::WriteBit(_devAddr, MPU6050_RA_FIFO_EN, MPU6050_TEMP_FIFO_EN_BIT, enabled);
+    _bus->WriteBit(_devAddr, MPU6050_RA_FIFO_EN, MPU6050_TEMP_FIFO_EN_BIT, enabled);
 }
 /** Get gyroscope X-axis FIFO enabled value.
  * When set to 1, this bit enables GYRO_XOUT_H and GYRO_XOUT_L (Registers 67 and
@@ -640,7 +672,7 @@ void MPU6050::SetTempFIFOEnabled(bool enabled)
  */
 bool MPU6050::GetXGyroFIFOEnabled()
 {
-    I2Cdev::ReadBit(_devAddr, MPU6050_RA_FIFO_EN, MPU6050_XG_FIFO_EN_BIT, _buffer);
+    _bus->ReadBit(_devAddr, MPU6050_RA_FIFO_EN, MPU6050_XG_FIFO_EN_BIT, _buffer);
     return _buffer[0];
 }
 /** Set gyroscope X-axis FIFO enabled value.
@@ -650,7 +682,7 @@ bool MPU6050::GetXGyroFIFOEnabled()
  */
 void MPU6050::SetXGyroFIFOEnabled(bool enabled)
 {
-    I2Cdev::WriteBit(_devAddr, MPU6050_RA_FIFO_EN, MPU6050_XG_FIFO_EN_BIT, enabled);
+    _bus->WriteBit(_devAddr, MPU6050_RA_FIFO_EN, MPU6050_XG_FIFO_EN_BIT, enabled);
 }
 /** Get gyroscope Y-axis FIFO enabled value.
  * When set to 1, this bit enables GYRO_YOUT_H and GYRO_YOUT_L (Registers 69 and
@@ -660,7 +692,7 @@ void MPU6050::SetXGyroFIFOEnabled(bool enabled)
  */
 bool MPU6050::GetYGyroFIFOEnabled()
 {
-    I2Cdev::ReadBit(_devAddr, MPU6050_RA_FIFO_EN, MPU6050_YG_FIFO_EN_BIT, _buffer);
+    _bus->ReadBit(_devAddr, MPU6050_RA_FIFO_EN, MPU6050_YG_FIFO_EN_BIT, _buffer);
     return _buffer[0];
 }
 /** Set gyroscope Y-axis FIFO enabled value.
@@ -670,7 +702,7 @@ bool MPU6050::GetYGyroFIFOEnabled()
  */
 void MPU6050::SetYGyroFIFOEnabled(bool enabled)
 {
-    I2Cdev::WriteBit(_devAddr, MPU6050_RA_FIFO_EN, MPU6050_YG_FIFO_EN_BIT, enabled);
+    _bus->WriteBit(_devAddr, MPU6050_RA_FIFO_EN, MPU6050_YG_FIFO_EN_BIT, enabled);
 }
 /** Get gyroscope Z-axis FIFO enabled value.
  * When set to 1, this bit enables GYRO_ZOUT_H and GYRO_ZOUT_L (Registers 71 and
@@ -680,7 +712,7 @@ void MPU6050::SetYGyroFIFOEnabled(bool enabled)
  */
 bool MPU6050::GetZGyroFIFOEnabled()
 {
-    I2Cdev::ReadBit(_devAddr, MPU6050_RA_FIFO_EN, MPU6050_ZG_FIFO_EN_BIT, _buffer);
+    _bus->ReadBit(_devAddr, MPU6050_RA_FIFO_EN, MPU6050_ZG_FIFO_EN_BIT, _buffer);
     return _buffer[0];
 }
 /** Set gyroscope Z-axis FIFO enabled value.
@@ -690,7 +722,7 @@ bool MPU6050::GetZGyroFIFOEnabled()
  */
 void MPU6050::SetZGyroFIFOEnabled(bool enabled)
 {
-    I2Cdev::WriteBit(_devAddr, MPU6050_RA_FIFO_EN, MPU6050_ZG_FIFO_EN_BIT, enabled);
+    _bus->WriteBit(_devAddr, MPU6050_RA_FIFO_EN, MPU6050_ZG_FIFO_EN_BIT, enabled);
 }
 /** Get accelerometer FIFO enabled value.
  * When set to 1, this bit enables ACCEL_XOUT_H, ACCEL_XOUT_L, ACCEL_YOUT_H,
@@ -701,7 +733,7 @@ void MPU6050::SetZGyroFIFOEnabled(bool enabled)
  */
 bool MPU6050::GetAccelFIFOEnabled()
 {
-    I2Cdev::ReadBit(_devAddr, MPU6050_RA_FIFO_EN, MPU6050_ACCEL_FIFO_EN_BIT, _buffer);
+    _bus->ReadBit(_devAddr, MPU6050_RA_FIFO_EN, MPU6050_ACCEL_FIFO_EN_BIT, _buffer);
     return _buffer[0];
 }
 /** Set accelerometer FIFO enabled value.
@@ -711,7 +743,7 @@ bool MPU6050::GetAccelFIFOEnabled()
  */
 void MPU6050::SetAccelFIFOEnabled(bool enabled)
 {
-    I2Cdev::WriteBit(_devAddr, MPU6050_RA_FIFO_EN, MPU6050_ACCEL_FIFO_EN_BIT, enabled);
+    _bus->WriteBit(_devAddr, MPU6050_RA_FIFO_EN, MPU6050_ACCEL_FIFO_EN_BIT, enabled);
 }
 /** Get Slave 2 FIFO enabled value.
  * When set to 1, this bit enables EXT_SENS_DATA registers (Registers 73 to 96)
@@ -721,7 +753,7 @@ void MPU6050::SetAccelFIFOEnabled(bool enabled)
  */
 bool MPU6050::GetSlave2FIFOEnabled()
 {
-    I2Cdev::ReadBit(_devAddr, MPU6050_RA_FIFO_EN, MPU6050_SLV2_FIFO_EN_BIT, _buffer);
+    _bus->ReadBit(_devAddr, MPU6050_RA_FIFO_EN, MPU6050_SLV2_FIFO_EN_BIT, _buffer);
     return _buffer[0];
 }
 /** Set Slave 2 FIFO enabled value.
@@ -731,7 +763,7 @@ bool MPU6050::GetSlave2FIFOEnabled()
  */
 void MPU6050::SetSlave2FIFOEnabled(bool enabled)
 {
-    I2Cdev::WriteBit(_devAddr, MPU6050_RA_FIFO_EN, MPU6050_SLV2_FIFO_EN_BIT, enabled);
+    _bus->WriteBit(_devAddr, MPU6050_RA_FIFO_EN, MPU6050_SLV2_FIFO_EN_BIT, enabled);
 }
 /** Get Slave 1 FIFO enabled value.
  * When set to 1, this bit enables EXT_SENS_DATA registers (Registers 73 to 96)
@@ -741,7 +773,7 @@ void MPU6050::SetSlave2FIFOEnabled(bool enabled)
  */
 bool MPU6050::GetSlave1FIFOEnabled()
 {
-    I2Cdev::ReadBit(_devAddr, MPU6050_RA_FIFO_EN, MPU6050_SLV1_FIFO_EN_BIT, _buffer);
+    _bus->ReadBit(_devAddr, MPU6050_RA_FIFO_EN, MPU6050_SLV1_FIFO_EN_BIT, _buffer);
     return _buffer[0];
 }
 /** Set Slave 1 FIFO enabled value.
@@ -751,7 +783,7 @@ bool MPU6050::GetSlave1FIFOEnabled()
  */
 void MPU6050::SetSlave1FIFOEnabled(bool enabled)
 {
-    I2Cdev::WriteBit(_devAddr, MPU6050_RA_FIFO_EN, MPU6050_SLV1_FIFO_EN_BIT, enabled);
+    _bus->WriteBit(_devAddr, MPU6050_RA_FIFO_EN, MPU6050_SLV1_FIFO_EN_BIT, enabled);
 }
 /** Get Slave 0 FIFO enabled value.
  * When set to 1, this bit enables EXT_SENS_DATA registers (Registers 73 to 96)
@@ -761,7 +793,7 @@ void MPU6050::SetSlave1FIFOEnabled(bool enabled)
  */
 bool MPU6050::GetSlave0FIFOEnabled()
 {
-    I2Cdev::ReadBit(_devAddr, MPU6050_RA_FIFO_EN, MPU6050_SLV0_FIFO_EN_BIT, _buffer);
+    _bus->ReadBit(_devAddr, MPU6050_RA_FIFO_EN, MPU6050_SLV0_FIFO_EN_BIT, _buffer);
     return _buffer[0];
 }
 /** Set Slave 0 FIFO enabled value.
@@ -771,7 +803,7 @@ bool MPU6050::GetSlave0FIFOEnabled()
  */
 void MPU6050::SetSlave0FIFOEnabled(bool enabled)
 {
-    I2Cdev::WriteBit(_devAddr, MPU6050_RA_FIFO_EN, MPU6050_SLV0_FIFO_EN_BIT, enabled);
+    _bus->WriteBit(_devAddr, MPU6050_RA_FIFO_EN, MPU6050_SLV0_FIFO_EN_BIT, enabled);
 }
 
 // I2C_MST_CTRL register
@@ -793,7 +825,7 @@ void MPU6050::SetSlave0FIFOEnabled(bool enabled)
  */
 bool MPU6050::GetMultiMasterEnabled()
 {
-    I2Cdev::ReadBit(_devAddr, MPU6050_RA_I2C_MST_CTRL, MPU6050_MULT_MST_EN_BIT, _buffer);
+    _bus->ReadBit(_devAddr, MPU6050_RA_I2C_MST_CTRL, MPU6050_MULT_MST_EN_BIT, _buffer);
     return _buffer[0];
 }
 /** Set multi-master enabled value.
@@ -803,7 +835,7 @@ bool MPU6050::GetMultiMasterEnabled()
  */
 void MPU6050::SetMultiMasterEnabled(bool enabled)
 {
-    I2Cdev::WriteBit(_devAddr, MPU6050_RA_I2C_MST_CTRL, MPU6050_MULT_MST_EN_BIT, enabled);
+    _bus->WriteBit(_devAddr, MPU6050_RA_I2C_MST_CTRL, MPU6050_MULT_MST_EN_BIT, enabled);
 }
 /** Get wait-for-external-sensor-data enabled value.
  * When the WAIT_FOR_ES bit is set to 1, the Data Ready interrupt will be
@@ -818,7 +850,7 @@ void MPU6050::SetMultiMasterEnabled(bool enabled)
  */
 bool MPU6050::GetWaitForExternalSensorEnabled()
 {
-    I2Cdev::ReadBit(_devAddr, MPU6050_RA_I2C_MST_CTRL, MPU6050_WAIT_FOR_ES_BIT, _buffer);
+    _bus->ReadBit(_devAddr, MPU6050_RA_I2C_MST_CTRL, MPU6050_WAIT_FOR_ES_BIT, _buffer);
     return _buffer[0];
 }
 /** Set wait-for-external-sensor-data enabled value.
@@ -828,7 +860,7 @@ bool MPU6050::GetWaitForExternalSensorEnabled()
  */
 void MPU6050::SetWaitForExternalSensorEnabled(bool enabled)
 {
-    I2Cdev::WriteBit(_devAddr, MPU6050_RA_I2C_MST_CTRL, MPU6050_WAIT_FOR_ES_BIT, enabled);
+    _bus->WriteBit(_devAddr, MPU6050_RA_I2C_MST_CTRL, MPU6050_WAIT_FOR_ES_BIT, enabled);
 }
 /** Get Slave 3 FIFO enabled value.
  * When set to 1, this bit enables EXT_SENS_DATA registers (Registers 73 to 96)
@@ -838,7 +870,7 @@ void MPU6050::SetWaitForExternalSensorEnabled(bool enabled)
  */
 bool MPU6050::GetSlave3FIFOEnabled()
 {
-    I2Cdev::ReadBit(_devAddr, MPU6050_RA_I2C_MST_CTRL, MPU6050_SLV_3_FIFO_EN_BIT, _buffer);
+    _bus->ReadBit(_devAddr, MPU6050_RA_I2C_MST_CTRL, MPU6050_SLV_3_FIFO_EN_BIT, _buffer);
     return _buffer[0];
 }
 /** Set Slave 3 FIFO enabled value.
@@ -848,7 +880,7 @@ bool MPU6050::GetSlave3FIFOEnabled()
  */
 void MPU6050::SetSlave3FIFOEnabled(bool enabled)
 {
-    I2Cdev::WriteBit(_devAddr, MPU6050_RA_I2C_MST_CTRL, MPU6050_SLV_3_FIFO_EN_BIT, enabled);
+    _bus->WriteBit(_devAddr, MPU6050_RA_I2C_MST_CTRL, MPU6050_SLV_3_FIFO_EN_BIT, enabled);
 }
 /** Get slave read/write transition enabled value.
  * The I2C_MST_P_NSR bit configures the I2C Master's transition from one slave
@@ -862,7 +894,7 @@ void MPU6050::SetSlave3FIFOEnabled(bool enabled)
  */
 bool MPU6050::GetSlaveReadWriteTransitionEnabled()
 {
-    I2Cdev::ReadBit(_devAddr, MPU6050_RA_I2C_MST_CTRL, MPU6050_I2C_MST_P_NSR_BIT, _buffer);
+    _bus->ReadBit(_devAddr, MPU6050_RA_I2C_MST_CTRL, MPU6050_I2C_MST_P_NSR_BIT, _buffer);
     return _buffer[0];
 }
 /** Set slave read/write transition enabled value.
@@ -872,7 +904,7 @@ bool MPU6050::GetSlaveReadWriteTransitionEnabled()
  */
 void MPU6050::SetSlaveReadWriteTransitionEnabled(bool enabled)
 {
-    I2Cdev::WriteBit(_devAddr, MPU6050_RA_I2C_MST_CTRL, MPU6050_I2C_MST_P_NSR_BIT, enabled);
+    _bus->WriteBit(_devAddr, MPU6050_RA_I2C_MST_CTRL, MPU6050_I2C_MST_P_NSR_BIT, enabled);
 }
 /** Get I2C master clock speed.
  * I2C_MST_CLK is a 4 bit unsigned value which configures a divider on the
@@ -905,7 +937,7 @@ void MPU6050::SetSlaveReadWriteTransitionEnabled(bool enabled)
  */
 uint8_t MPU6050::GetMasterClockSpeed()
 {
-    I2Cdev::ReadBits(_devAddr, MPU6050_RA_I2C_MST_CTRL, MPU6050_I2C_MST_CLK_BIT, MPU6050_I2C_MST_CLK_LENGTH, _buffer);
+    _bus->ReadBits(_devAddr, MPU6050_RA_I2C_MST_CTRL, MPU6050_I2C_MST_CLK_BIT, MPU6050_I2C_MST_CLK_LENGTH, _buffer);
     return _buffer[0];
 }
 /** Set I2C master clock speed.
@@ -914,7 +946,7 @@ uint8_t MPU6050::GetMasterClockSpeed()
  */
 void MPU6050::SetMasterClockSpeed(uint8_t speed)
 {
-    I2Cdev::WriteBits(_devAddr, MPU6050_RA_I2C_MST_CTRL, MPU6050_I2C_MST_CLK_BIT, MPU6050_I2C_MST_CLK_LENGTH, speed);
+    _bus->WriteBits(_devAddr, MPU6050_RA_I2C_MST_CTRL, MPU6050_I2C_MST_CLK_BIT, MPU6050_I2C_MST_CLK_LENGTH, speed);
 }
 
 // I2C_SLV* registers (Slave 0-3)
@@ -966,7 +998,7 @@ uint8_t MPU6050::GetSlaveAddress(uint8_t num)
     {
         return 0;
     }
-    I2Cdev::ReadByte(_devAddr, MPU6050_RA_I2C_SLV0_ADDR + num * 3, _buffer);
+    _bus->ReadByte(_devAddr, MPU6050_RA_I2C_SLV0_ADDR + num * 3, _buffer);
     return _buffer[0];
 }
 /** Set the I2C address of the specified slave (0-3).
@@ -981,7 +1013,7 @@ void MPU6050::SetSlaveAddress(uint8_t num, uint8_t address)
     {
         return;
     }
-    I2Cdev::WriteByte(_devAddr, MPU6050_RA_I2C_SLV0_ADDR + num * 3, address);
+    _bus->WriteByte(_devAddr, MPU6050_RA_I2C_SLV0_ADDR + num * 3, address);
 }
 /** Get the active internal register for the specified slave (0-3).
  * Read/write operations for this slave will be done to whatever internal
@@ -1000,7 +1032,7 @@ uint8_t MPU6050::GetSlaveRegister(uint8_t num)
     {
         return 0;
     }
-    I2Cdev::ReadByte(_devAddr, MPU6050_RA_I2C_SLV0_REG + num * 3, _buffer);
+    _bus->ReadByte(_devAddr, MPU6050_RA_I2C_SLV0_REG + num * 3, _buffer);
     return _buffer[0];
 }
 /** Set the active internal register for the specified slave (0-3).
@@ -1015,7 +1047,7 @@ void MPU6050::SetSlaveRegister(uint8_t num, uint8_t reg)
     {
         return;
     }
-    I2Cdev::WriteByte(_devAddr, MPU6050_RA_I2C_SLV0_REG + num * 3, reg);
+    _bus->WriteByte(_devAddr, MPU6050_RA_I2C_SLV0_REG + num * 3, reg);
 }
 /** Get the enabled value for the specified slave (0-3).
  * When set to 1, this bit enables Slave 0 for data transfer operations. When
@@ -1030,7 +1062,7 @@ bool MPU6050::GetSlaveEnabled(uint8_t num)
     {
         return 0;
     }
-    I2Cdev::ReadBit(_devAddr, MPU6050_RA_I2C_SLV0_CTRL + num * 3, MPU6050_I2C_SLV_EN_BIT, _buffer);
+    _bus->ReadBit(_devAddr, MPU6050_RA_I2C_SLV0_CTRL + num * 3, MPU6050_I2C_SLV_EN_BIT, _buffer);
     return _buffer[0];
 }
 /** Set the enabled value for the specified slave (0-3).
@@ -1045,7 +1077,7 @@ void MPU6050::SetSlaveEnabled(uint8_t num, bool enabled)
     {
         return;
     }
-    I2Cdev::WriteBit(_devAddr, MPU6050_RA_I2C_SLV0_CTRL + num * 3, MPU6050_I2C_SLV_EN_BIT, enabled);
+    _bus->WriteBit(_devAddr, MPU6050_RA_I2C_SLV0_CTRL + num * 3, MPU6050_I2C_SLV_EN_BIT, enabled);
 }
 /** Get word pair byte-swapping enabled for the specified slave (0-3).
  * When set to 1, this bit enables byte swapping. When byte swapping is enabled,
@@ -1064,7 +1096,7 @@ bool MPU6050::GetSlaveWordByteSwap(uint8_t num)
     {
         return 0;
     }
-    I2Cdev::ReadBit(_devAddr, MPU6050_RA_I2C_SLV0_CTRL + num * 3, MPU6050_I2C_SLV_BYTE_SW_BIT, _buffer);
+    _bus->ReadBit(_devAddr, MPU6050_RA_I2C_SLV0_CTRL + num * 3, MPU6050_I2C_SLV_BYTE_SW_BIT, _buffer);
     return _buffer[0];
 }
 /** Set word pair byte-swapping enabled for the specified slave (0-3).
@@ -1079,7 +1111,7 @@ void MPU6050::SetSlaveWordByteSwap(uint8_t num, bool enabled)
     {
         return;
     }
-    I2Cdev::WriteBit(_devAddr, MPU6050_RA_I2C_SLV0_CTRL + num * 3, MPU6050_I2C_SLV_BYTE_SW_BIT, enabled);
+    _bus->WriteBit(_devAddr, MPU6050_RA_I2C_SLV0_CTRL + num * 3, MPU6050_I2C_SLV_BYTE_SW_BIT, enabled);
 }
 /** Get write mode for the specified slave (0-3).
  * When set to 1, the transaction will read or write data only. When cleared to
@@ -1097,7 +1129,7 @@ bool MPU6050::GetSlaveWriteMode(uint8_t num)
     {
         return 0;
     }
-    I2Cdev::ReadBit(_devAddr, MPU6050_RA_I2C_SLV0_CTRL + num * 3, MPU6050_I2C_SLV_REG_DIS_BIT, _buffer);
+    _bus->ReadBit(_devAddr, MPU6050_RA_I2C_SLV0_CTRL + num * 3, MPU6050_I2C_SLV_REG_DIS_BIT, _buffer);
     return _buffer[0];
 }
 /** Set write mode for the specified slave (0-3).
@@ -1112,7 +1144,7 @@ void MPU6050::SetSlaveWriteMode(uint8_t num, bool mode)
     {
         return;
     }
-    I2Cdev::WriteBit(_devAddr, MPU6050_RA_I2C_SLV0_CTRL + num * 3, MPU6050_I2C_SLV_REG_DIS_BIT, mode);
+    _bus->WriteBit(_devAddr, MPU6050_RA_I2C_SLV0_CTRL + num * 3, MPU6050_I2C_SLV_REG_DIS_BIT, mode);
 }
 /** Get word pair grouping order offset for the specified slave (0-3).
  * This sets specifies the grouping order of word pairs received from registers.
@@ -1131,7 +1163,7 @@ bool MPU6050::GetSlaveWordGroupOffset(uint8_t num)
     {
         return 0;
     }
-    I2Cdev::ReadBit(_devAddr, MPU6050_RA_I2C_SLV0_CTRL + num * 3, MPU6050_I2C_SLV_GRP_BIT, _buffer);
+    _bus->ReadBit(_devAddr, MPU6050_RA_I2C_SLV0_CTRL + num * 3, MPU6050_I2C_SLV_GRP_BIT, _buffer);
     return _buffer[0];
 }
 /** Set word pair grouping order offset for the specified slave (0-3).
@@ -1146,7 +1178,7 @@ void MPU6050::SetSlaveWordGroupOffset(uint8_t num, bool enabled)
     {
         return;
     }
-    I2Cdev::WriteBit(_devAddr, MPU6050_RA_I2C_SLV0_CTRL + num * 3, MPU6050_I2C_SLV_GRP_BIT, enabled);
+    _bus->WriteBit(_devAddr, MPU6050_RA_I2C_SLV0_CTRL + num * 3, MPU6050_I2C_SLV_GRP_BIT, enabled);
 }
 /** Get number of bytes to read for the specified slave (0-3).
  * Specifies the number of bytes transferred to and from Slave 0. Clearing this
@@ -1161,7 +1193,7 @@ uint8_t MPU6050::GetSlaveDataLength(uint8_t num)
     {
         return 0;
     }
-    I2Cdev::ReadBits(_devAddr, MPU6050_RA_I2C_SLV0_CTRL + num * 3, MPU6050_I2C_SLV_LEN_BIT, MPU6050_I2C_SLV_LEN_LENGTH, _buffer);
+    _bus->ReadBits(_devAddr, MPU6050_RA_I2C_SLV0_CTRL + num * 3, MPU6050_I2C_SLV_LEN_BIT, MPU6050_I2C_SLV_LEN_LENGTH, _buffer);
     return _buffer[0];
 }
 /** Set number of bytes to read for the specified slave (0-3).
@@ -1176,7 +1208,7 @@ void MPU6050::SetSlaveDataLength(uint8_t num, uint8_t length)
     {
         return;
     }
-    I2Cdev::WriteBits(_devAddr, MPU6050_RA_I2C_SLV0_CTRL + num * 3, MPU6050_I2C_SLV_LEN_BIT, MPU6050_I2C_SLV_LEN_LENGTH, length);
+    _bus->WriteBits(_devAddr, MPU6050_RA_I2C_SLV0_CTRL + num * 3, MPU6050_I2C_SLV_LEN_BIT, MPU6050_I2C_SLV_LEN_LENGTH, length);
 }
 
 // I2C_SLV* registers (Slave 4)
@@ -1192,7 +1224,7 @@ void MPU6050::SetSlaveDataLength(uint8_t num, uint8_t length)
  */
 uint8_t MPU6050::GetSlave4Address()
 {
-    I2Cdev::ReadByte(_devAddr, MPU6050_RA_I2C_SLV4_ADDR, _buffer);
+    _bus->ReadByte(_devAddr, MPU6050_RA_I2C_SLV4_ADDR, _buffer);
     return _buffer[0];
 }
 /** Set the I2C address of Slave 4.
@@ -1202,7 +1234,7 @@ uint8_t MPU6050::GetSlave4Address()
  */
 void MPU6050::SetSlave4Address(uint8_t address)
 {
-    I2Cdev::WriteByte(_devAddr, MPU6050_RA_I2C_SLV4_ADDR, address);
+    _bus->WriteByte(_devAddr, MPU6050_RA_I2C_SLV4_ADDR, address);
 }
 /** Get the active internal register for the Slave 4.
  * Read/write operations for this slave will be done to whatever internal
@@ -1213,7 +1245,7 @@ void MPU6050::SetSlave4Address(uint8_t address)
  */
 uint8_t MPU6050::GetSlave4Register()
 {
-    I2Cdev::ReadByte(_devAddr, MPU6050_RA_I2C_SLV4_REG, _buffer);
+    _bus->ReadByte(_devAddr, MPU6050_RA_I2C_SLV4_REG, _buffer);
     return _buffer[0];
 }
 /** Set the active internal register for Slave 4.
@@ -1223,7 +1255,7 @@ uint8_t MPU6050::GetSlave4Register()
  */
 void MPU6050::SetSlave4Register(uint8_t reg)
 {
-    I2Cdev::WriteByte(_devAddr, MPU6050_RA_I2C_SLV4_REG, reg);
+    _bus->WriteByte(_devAddr, MPU6050_RA_I2C_SLV4_REG, reg);
 }
 /** Set new byte to write to Slave 4.
  * This register stores the data to be written into the Slave 4. If I2C_SLV4_RW
@@ -1233,7 +1265,7 @@ void MPU6050::SetSlave4Register(uint8_t reg)
  */
 void MPU6050::SetSlave4OutputByte(uint8_t data)
 {
-    I2Cdev::WriteByte(_devAddr, MPU6050_RA_I2C_SLV4_DO, data);
+    _bus->WriteByte(_devAddr, MPU6050_RA_I2C_SLV4_DO, data);
 }
 /** Get the enabled value for the Slave 4.
  * When set to 1, this bit enables Slave 4 for data transfer operations. When
@@ -1243,7 +1275,7 @@ void MPU6050::SetSlave4OutputByte(uint8_t data)
  */
 bool MPU6050::GetSlave4Enabled()
 {
-    I2Cdev::ReadBit(_devAddr, MPU6050_RA_I2C_SLV4_CTRL, MPU6050_I2C_SLV4_EN_BIT, _buffer);
+    _bus->ReadBit(_devAddr, MPU6050_RA_I2C_SLV4_CTRL, MPU6050_I2C_SLV4_EN_BIT, _buffer);
     return _buffer[0];
 }
 /** Set the enabled value for Slave 4.
@@ -1253,7 +1285,7 @@ bool MPU6050::GetSlave4Enabled()
  */
 void MPU6050::SetSlave4Enabled(bool enabled)
 {
-    I2Cdev::WriteBit(_devAddr, MPU6050_RA_I2C_SLV4_CTRL, MPU6050_I2C_SLV4_EN_BIT, enabled);
+    _bus->WriteBit(_devAddr, MPU6050_RA_I2C_SLV4_CTRL, MPU6050_I2C_SLV4_EN_BIT, enabled);
 }
 /** Get the enabled value for Slave 4 transaction interrupts.
  * When set to 1, this bit enables the generation of an interrupt signal upon
@@ -1266,7 +1298,7 @@ void MPU6050::SetSlave4Enabled(bool enabled)
  */
 bool MPU6050::GetSlave4InterruptEnabled()
 {
-    I2Cdev::ReadBit(_devAddr, MPU6050_RA_I2C_SLV4_CTRL, MPU6050_I2C_SLV4_INT_EN_BIT, _buffer);
+    _bus->ReadBit(_devAddr, MPU6050_RA_I2C_SLV4_CTRL, MPU6050_I2C_SLV4_INT_EN_BIT, _buffer);
     return _buffer[0];
 }
 /** Set the enabled value for Slave 4 transaction interrupts.
@@ -1276,7 +1308,7 @@ bool MPU6050::GetSlave4InterruptEnabled()
  */
 void MPU6050::SetSlave4InterruptEnabled(bool enabled)
 {
-    I2Cdev::WriteBit(_devAddr, MPU6050_RA_I2C_SLV4_CTRL, MPU6050_I2C_SLV4_INT_EN_BIT, enabled);
+    _bus->WriteBit(_devAddr, MPU6050_RA_I2C_SLV4_CTRL, MPU6050_I2C_SLV4_INT_EN_BIT, enabled);
 }
 /** Get write mode for Slave 4.
  * When set to 1, the transaction will read or write data only. When cleared to
@@ -1289,7 +1321,7 @@ void MPU6050::SetSlave4InterruptEnabled(bool enabled)
  */
 bool MPU6050::GetSlave4WriteMode()
 {
-    I2Cdev::ReadBit(_devAddr, MPU6050_RA_I2C_SLV4_CTRL, MPU6050_I2C_SLV4_REG_DIS_BIT, _buffer);
+    _bus->ReadBit(_devAddr, MPU6050_RA_I2C_SLV4_CTRL, MPU6050_I2C_SLV4_REG_DIS_BIT, _buffer);
     return _buffer[0];
 }
 /** Set write mode for the Slave 4.
@@ -1299,7 +1331,7 @@ bool MPU6050::GetSlave4WriteMode()
  */
 void MPU6050::SetSlave4WriteMode(bool mode)
 {
-    I2Cdev::WriteBit(_devAddr, MPU6050_RA_I2C_SLV4_CTRL, MPU6050_I2C_SLV4_REG_DIS_BIT, mode);
+    _bus->WriteBit(_devAddr, MPU6050_RA_I2C_SLV4_CTRL, MPU6050_I2C_SLV4_REG_DIS_BIT, mode);
 }
 /** Get Slave 4 master delay value.
  * This configures the reduced access rate of I2C slaves relative to the Sample
@@ -1318,7 +1350,7 @@ void MPU6050::SetSlave4WriteMode(bool mode)
  */
 uint8_t MPU6050::GetSlave4MasterDelay()
 {
-    I2Cdev::ReadBits(_devAddr, MPU6050_RA_I2C_SLV4_CTRL, MPU6050_I2C_SLV4_MST_DLY_BIT, MPU6050_I2C_SLV4_MST_DLY_LENGTH, _buffer);
+    _bus->ReadBits(_devAddr, MPU6050_RA_I2C_SLV4_CTRL, MPU6050_I2C_SLV4_MST_DLY_BIT, MPU6050_I2C_SLV4_MST_DLY_LENGTH, _buffer);
     return _buffer[0];
 }
 /** Set Slave 4 master delay value.
@@ -1328,7 +1360,7 @@ uint8_t MPU6050::GetSlave4MasterDelay()
  */
 void MPU6050::SetSlave4MasterDelay(uint8_t delay)
 {
-    I2Cdev::WriteBits(_devAddr, MPU6050_RA_I2C_SLV4_CTRL, MPU6050_I2C_SLV4_MST_DLY_BIT, MPU6050_I2C_SLV4_MST_DLY_LENGTH, delay);
+    _bus->WriteBits(_devAddr, MPU6050_RA_I2C_SLV4_CTRL, MPU6050_I2C_SLV4_MST_DLY_BIT, MPU6050_I2C_SLV4_MST_DLY_LENGTH, delay);
 }
 /** Get last available byte read from Slave 4.
  * This register stores the data read from Slave 4. This field is populated
@@ -1338,7 +1370,7 @@ void MPU6050::SetSlave4MasterDelay(uint8_t delay)
  */
 uint8_t MPU6050::GetSlate4InputByte()
 {
-    I2Cdev::ReadByte(_devAddr, MPU6050_RA_I2C_SLV4_DI, _buffer);
+    _bus->ReadByte(_devAddr, MPU6050_RA_I2C_SLV4_DI, _buffer);
     return _buffer[0];
 }
 
@@ -1355,7 +1387,7 @@ uint8_t MPU6050::GetSlate4InputByte()
  */
 bool MPU6050::GetPassthroughStatus()
 {
-    I2Cdev::ReadBit(_devAddr, MPU6050_RA_I2C_MST_STATUS, MPU6050_MST_PASS_THROUGH_BIT, _buffer);
+    _bus->ReadBit(_devAddr, MPU6050_RA_I2C_MST_STATUS, MPU6050_MST_PASS_THROUGH_BIT, _buffer);
     return _buffer[0];
 }
 /** Get Slave 4 transaction done status.
@@ -1368,7 +1400,7 @@ bool MPU6050::GetPassthroughStatus()
  */
 bool MPU6050::GetSlave4IsDone()
 {
-    I2Cdev::ReadBit(_devAddr, MPU6050_RA_I2C_MST_STATUS, MPU6050_MST_I2C_SLV4_DONE_BIT, _buffer);
+    _bus->ReadBit(_devAddr, MPU6050_RA_I2C_MST_STATUS, MPU6050_MST_I2C_SLV4_DONE_BIT, _buffer);
     return _buffer[0];
 }
 /** Get master arbitration lost status.
@@ -1380,7 +1412,7 @@ bool MPU6050::GetSlave4IsDone()
  */
 bool MPU6050::GetLostArbitration()
 {
-    I2Cdev::ReadBit(_devAddr, MPU6050_RA_I2C_MST_STATUS, MPU6050_MST_I2C_LOST_ARB_BIT, _buffer);
+    _bus->ReadBit(_devAddr, MPU6050_RA_I2C_MST_STATUS, MPU6050_MST_I2C_LOST_ARB_BIT, _buffer);
     return _buffer[0];
 }
 /** Get Slave 4 NACK status.
@@ -1392,7 +1424,7 @@ bool MPU6050::GetLostArbitration()
  */
 bool MPU6050::GetSlave4Nack()
 {
-    I2Cdev::ReadBit(_devAddr, MPU6050_RA_I2C_MST_STATUS, MPU6050_MST_I2C_SLV4_NACK_BIT, _buffer);
+    _bus->ReadBit(_devAddr, MPU6050_RA_I2C_MST_STATUS, MPU6050_MST_I2C_SLV4_NACK_BIT, _buffer);
     return _buffer[0];
 }
 /** Get Slave 3 NACK status.
@@ -1404,7 +1436,7 @@ bool MPU6050::GetSlave4Nack()
  */
 bool MPU6050::GetSlave3Nack()
 {
-    I2Cdev::ReadBit(_devAddr, MPU6050_RA_I2C_MST_STATUS, MPU6050_MST_I2C_SLV3_NACK_BIT, _buffer);
+    _bus->ReadBit(_devAddr, MPU6050_RA_I2C_MST_STATUS, MPU6050_MST_I2C_SLV3_NACK_BIT, _buffer);
     return _buffer[0];
 }
 /** Get Slave 2 NACK status.
@@ -1416,7 +1448,7 @@ bool MPU6050::GetSlave3Nack()
  */
 bool MPU6050::GetSlave2Nack()
 {
-    I2Cdev::ReadBit(_devAddr, MPU6050_RA_I2C_MST_STATUS, MPU6050_MST_I2C_SLV2_NACK_BIT, _buffer);
+    _bus->ReadBit(_devAddr, MPU6050_RA_I2C_MST_STATUS, MPU6050_MST_I2C_SLV2_NACK_BIT, _buffer);
     return _buffer[0];
 }
 /** Get Slave 1 NACK status.
@@ -1428,7 +1460,7 @@ bool MPU6050::GetSlave2Nack()
  */
 bool MPU6050::GetSlave1Nack()
 {
-    I2Cdev::ReadBit(_devAddr, MPU6050_RA_I2C_MST_STATUS, MPU6050_MST_I2C_SLV1_NACK_BIT, _buffer);
+    _bus->ReadBit(_devAddr, MPU6050_RA_I2C_MST_STATUS, MPU6050_MST_I2C_SLV1_NACK_BIT, _buffer);
     return _buffer[0];
 }
 /** Get Slave 0 NACK status.
@@ -1440,7 +1472,7 @@ bool MPU6050::GetSlave1Nack()
  */
 bool MPU6050::GetSlave0Nack()
 {
-    I2Cdev::ReadBit(_devAddr, MPU6050_RA_I2C_MST_STATUS, MPU6050_MST_I2C_SLV0_NACK_BIT, _buffer);
+    _bus->ReadBit(_devAddr, MPU6050_RA_I2C_MST_STATUS, MPU6050_MST_I2C_SLV0_NACK_BIT, _buffer);
     return _buffer[0];
 }
 
@@ -1454,7 +1486,7 @@ bool MPU6050::GetSlave0Nack()
  */
 bool MPU6050::GetInterruptMode()
 {
-    I2Cdev::ReadBit(_devAddr, MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_INT_LEVEL_BIT, _buffer);
+    _bus->ReadBit(_devAddr, MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_INT_LEVEL_BIT, _buffer);
     return _buffer[0];
 }
 /** Set interrupt logic level mode.
@@ -1465,7 +1497,7 @@ bool MPU6050::GetInterruptMode()
  */
 void MPU6050::SetInterruptMode(bool mode)
 {
-    I2Cdev::WriteBit(_devAddr, MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_INT_LEVEL_BIT, mode);
+    _bus->WriteBit(_devAddr, MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_INT_LEVEL_BIT, mode);
 }
 /** Get interrupt drive mode.
  * Will be set 0 for push-pull, 1 for open-drain.
@@ -1475,7 +1507,7 @@ void MPU6050::SetInterruptMode(bool mode)
  */
 bool MPU6050::GetInterruptDrive()
 {
-    I2Cdev::ReadBit(_devAddr, MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_INT_OPEN_BIT, _buffer);
+    _bus->ReadBit(_devAddr, MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_INT_OPEN_BIT, _buffer);
     return _buffer[0];
 }
 /** Set interrupt drive mode.
@@ -1486,7 +1518,7 @@ bool MPU6050::GetInterruptDrive()
  */
 void MPU6050::SetInterruptDrive(bool drive)
 {
-    I2Cdev::WriteBit(_devAddr, MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_INT_OPEN_BIT, drive);
+    _bus->WriteBit(_devAddr, MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_INT_OPEN_BIT, drive);
 }
 /** Get interrupt latch mode.
  * Will be set 0 for 50us-pulse, 1 for latch-until-int-cleared.
@@ -1496,7 +1528,7 @@ void MPU6050::SetInterruptDrive(bool drive)
  */
 bool MPU6050::GetInterruptLatch()
 {
-    I2Cdev::ReadBit(_devAddr, MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_LATCH_INT_EN_BIT, _buffer);
+    _bus->ReadBit(_devAddr, MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_LATCH_INT_EN_BIT, _buffer);
     return _buffer[0];
 }
 /** Set interrupt latch mode.
@@ -1507,7 +1539,7 @@ bool MPU6050::GetInterruptLatch()
  */
 void MPU6050::SetInterruptLatch(bool latch)
 {
-    I2Cdev::WriteBit(_devAddr, MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_LATCH_INT_EN_BIT, latch);
+    _bus->WriteBit(_devAddr, MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_LATCH_INT_EN_BIT, latch);
 }
 /** Get interrupt latch clear mode.
  * Will be set 0 for status-read-only, 1 for any-register-read.
@@ -1517,7 +1549,7 @@ void MPU6050::SetInterruptLatch(bool latch)
  */
 bool MPU6050::GetInterruptLatchClear()
 {
-    I2Cdev::ReadBit(_devAddr, MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_INT_RD_CLEAR_BIT, _buffer);
+    _bus->ReadBit(_devAddr, MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_INT_RD_CLEAR_BIT, _buffer);
     return _buffer[0];
 }
 /** Set interrupt latch clear mode.
@@ -1528,7 +1560,7 @@ bool MPU6050::GetInterruptLatchClear()
  */
 void MPU6050::SetInterruptLatchClear(bool clear)
 {
-    I2Cdev::WriteBit(_devAddr, MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_INT_RD_CLEAR_BIT, clear);
+    _bus->WriteBit(_devAddr, MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_INT_RD_CLEAR_BIT, clear);
 }
 /** Get FSYNC interrupt logic level mode.
  * @return Current FSYNC interrupt mode (0=active-high, 1=active-low)
@@ -1538,7 +1570,7 @@ void MPU6050::SetInterruptLatchClear(bool clear)
  */
 bool MPU6050::GetFSyncInterruptLevel()
 {
-    I2Cdev::ReadBit(_devAddr, MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_FSYNC_INT_LEVEL_BIT, _buffer);
+    _bus->ReadBit(_devAddr, MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_FSYNC_INT_LEVEL_BIT, _buffer);
     return _buffer[0];
 }
 /** Set FSYNC interrupt logic level mode.
@@ -1549,7 +1581,7 @@ bool MPU6050::GetFSyncInterruptLevel()
  */
 void MPU6050::SetFSyncInterruptLevel(bool level)
 {
-    I2Cdev::WriteBit(_devAddr, MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_FSYNC_INT_LEVEL_BIT, level);
+    _bus->WriteBit(_devAddr, MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_FSYNC_INT_LEVEL_BIT, level);
 }
 /** Get FSYNC pin interrupt enabled setting.
  * Will be set 0 for disabled, 1 for enabled.
@@ -1559,7 +1591,7 @@ void MPU6050::SetFSyncInterruptLevel(bool level)
  */
 bool MPU6050::GetFSyncInterruptEnabled()
 {
-    I2Cdev::ReadBit(_devAddr, MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_FSYNC_INT_EN_BIT, _buffer);
+    _bus->ReadBit(_devAddr, MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_FSYNC_INT_EN_BIT, _buffer);
     return _buffer[0];
 }
 /** Set FSYNC pin interrupt enabled setting.
@@ -1570,7 +1602,7 @@ bool MPU6050::GetFSyncInterruptEnabled()
  */
 void MPU6050::SetFSyncInterruptEnabled(bool enabled)
 {
-    I2Cdev::WriteBit(_devAddr, MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_FSYNC_INT_EN_BIT, enabled);
+    _bus->WriteBit(_devAddr, MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_FSYNC_INT_EN_BIT, enabled);
 }
 /** Get I2C bypass enabled status.
  * When this bit is equal to 1 and I2C_MST_EN (Register 106 bit[5]) is equal to
@@ -1585,7 +1617,7 @@ void MPU6050::SetFSyncInterruptEnabled(bool enabled)
  */
 bool MPU6050::GetI2CBypassEnabled()
 {
-    I2Cdev::ReadBit(_devAddr, MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_I2C_BYPASS_EN_BIT, _buffer);
+    _bus->ReadBit(_devAddr, MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_I2C_BYPASS_EN_BIT, _buffer);
     return _buffer[0];
 }
 /** Set I2C bypass enabled status.
@@ -1601,7 +1633,7 @@ bool MPU6050::GetI2CBypassEnabled()
  */
 void MPU6050::SetI2CBypassEnabled(bool enabled)
 {
-    I2Cdev::WriteBit(_devAddr, MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_I2C_BYPASS_EN_BIT, enabled);
+    _bus->WriteBit(_devAddr, MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_I2C_BYPASS_EN_BIT, enabled);
 }
 /** Get reference clock output enabled status.
  * When this bit is equal to 1, a reference clock output is provided at the
@@ -1614,7 +1646,7 @@ void MPU6050::SetI2CBypassEnabled(bool enabled)
  */
 bool MPU6050::GetClockOutputEnabled()
 {
-    I2Cdev::ReadBit(_devAddr, MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_CLKOUT_EN_BIT, _buffer);
+    _bus->ReadBit(_devAddr, MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_CLKOUT_EN_BIT, _buffer);
     return _buffer[0];
 }
 /** Set reference clock output enabled status.
@@ -1628,7 +1660,7 @@ bool MPU6050::GetClockOutputEnabled()
  */
 void MPU6050::SetClockOutputEnabled(bool enabled)
 {
-    I2Cdev::WriteBit(_devAddr, MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_CLKOUT_EN_BIT, enabled);
+    _bus->WriteBit(_devAddr, MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_CLKOUT_EN_BIT, enabled);
 }
 
 // INT_ENABLE register
@@ -1642,7 +1674,7 @@ void MPU6050::SetClockOutputEnabled(bool enabled)
  **/
 uint8_t MPU6050::GetIntEnabled()
 {
-    I2Cdev::ReadByte(_devAddr, MPU6050_RA_INT_ENABLE, _buffer);
+    _bus->ReadByte(_devAddr, MPU6050_RA_INT_ENABLE, _buffer);
     return _buffer[0];
 }
 /** Set full interrupt enabled status.
@@ -1655,7 +1687,7 @@ uint8_t MPU6050::GetIntEnabled()
  **/
 void MPU6050::SetIntEnabled(uint8_t enabled)
 {
-    I2Cdev::WriteByte(_devAddr, MPU6050_RA_INT_ENABLE, enabled);
+    _bus->WriteByte(_devAddr, MPU6050_RA_INT_ENABLE, enabled);
 }
 /** Get Free Fall interrupt enabled status.
  * Will be set 0 for disabled, 1 for enabled.
@@ -1665,7 +1697,7 @@ void MPU6050::SetIntEnabled(uint8_t enabled)
  **/
 bool MPU6050::GetIntFreefallEnabled()
 {
-    I2Cdev::ReadBit(_devAddr, MPU6050_RA_INT_ENABLE, MPU6050_INTERRUPT_FF_BIT, _buffer);
+    _bus->ReadBit(_devAddr, MPU6050_RA_INT_ENABLE, MPU6050_INTERRUPT_FF_BIT, _buffer);
     return _buffer[0];
 }
 /** Set Free Fall interrupt enabled status.
@@ -1676,7 +1708,7 @@ bool MPU6050::GetIntFreefallEnabled()
  **/
 void MPU6050::SetIntFreefallEnabled(bool enabled)
 {
-    I2Cdev::WriteBit(_devAddr, MPU6050_RA_INT_ENABLE, MPU6050_INTERRUPT_FF_BIT, enabled);
+    _bus->WriteBit(_devAddr, MPU6050_RA_INT_ENABLE, MPU6050_INTERRUPT_FF_BIT, enabled);
 }
 /** Get Motion Detection interrupt enabled status.
  * Will be set 0 for disabled, 1 for enabled.
@@ -1686,7 +1718,7 @@ void MPU6050::SetIntFreefallEnabled(bool enabled)
  **/
 bool MPU6050::GetIntMotionEnabled()
 {
-    I2Cdev::ReadBit(_devAddr, MPU6050_RA_INT_ENABLE, MPU6050_INTERRUPT_MOT_BIT, _buffer);
+    _bus->ReadBit(_devAddr, MPU6050_RA_INT_ENABLE, MPU6050_INTERRUPT_MOT_BIT, _buffer);
     return _buffer[0];
 }
 /** Set Motion Detection interrupt enabled status.
@@ -1697,7 +1729,7 @@ bool MPU6050::GetIntMotionEnabled()
  **/
 void MPU6050::SetIntMotionEnabled(bool enabled)
 {
-    I2Cdev::WriteBit(_devAddr, MPU6050_RA_INT_ENABLE, MPU6050_INTERRUPT_MOT_BIT, enabled);
+    _bus->WriteBit(_devAddr, MPU6050_RA_INT_ENABLE, MPU6050_INTERRUPT_MOT_BIT, enabled);
 }
 /** Get Zero Motion Detection interrupt enabled status.
  * Will be set 0 for disabled, 1 for enabled.
@@ -1707,7 +1739,7 @@ void MPU6050::SetIntMotionEnabled(bool enabled)
  **/
 bool MPU6050::GetIntZeroMotionEnabled()
 {
-    I2Cdev::ReadBit(_devAddr, MPU6050_RA_INT_ENABLE, MPU6050_INTERRUPT_ZMOT_BIT, _buffer);
+    _bus->ReadBit(_devAddr, MPU6050_RA_INT_ENABLE, MPU6050_INTERRUPT_ZMOT_BIT, _buffer);
     return _buffer[0];
 }
 /** Set Zero Motion Detection interrupt enabled status.
@@ -1718,7 +1750,7 @@ bool MPU6050::GetIntZeroMotionEnabled()
  **/
 void MPU6050::SetIntZeroMotionEnabled(bool enabled)
 {
-    I2Cdev::WriteBit(_devAddr, MPU6050_RA_INT_ENABLE, MPU6050_INTERRUPT_ZMOT_BIT, enabled);
+    _bus->WriteBit(_devAddr, MPU6050_RA_INT_ENABLE, MPU6050_INTERRUPT_ZMOT_BIT, enabled);
 }
 /** Get FIFO Buffer Overflow interrupt enabled status.
  * Will be set 0 for disabled, 1 for enabled.
@@ -1728,7 +1760,7 @@ void MPU6050::SetIntZeroMotionEnabled(bool enabled)
  **/
 bool MPU6050::GetIntFIFOBufferOverflowEnabled()
 {
-    I2Cdev::ReadBit(_devAddr, MPU6050_RA_INT_ENABLE, MPU6050_INTERRUPT_FIFO_OFLOW_BIT, _buffer);
+    _bus->ReadBit(_devAddr, MPU6050_RA_INT_ENABLE, MPU6050_INTERRUPT_FIFO_OFLOW_BIT, _buffer);
     return _buffer[0];
 }
 /** Set FIFO Buffer Overflow interrupt enabled status.
@@ -1739,7 +1771,7 @@ bool MPU6050::GetIntFIFOBufferOverflowEnabled()
  **/
 void MPU6050::SetIntFIFOBufferOverflowEnabled(bool enabled)
 {
-    I2Cdev::WriteBit(_devAddr, MPU6050_RA_INT_ENABLE, MPU6050_INTERRUPT_FIFO_OFLOW_BIT, enabled);
+    _bus->WriteBit(_devAddr, MPU6050_RA_INT_ENABLE, MPU6050_INTERRUPT_FIFO_OFLOW_BIT, enabled);
 }
 /** Get I2C Master interrupt enabled status.
  * This enables any of the I2C Master interrupt sources to generate an
@@ -1750,7 +1782,7 @@ void MPU6050::SetIntFIFOBufferOverflowEnabled(bool enabled)
  **/
 bool MPU6050::GetIntI2CMasterEnabled()
 {
-    I2Cdev::ReadBit(_devAddr, MPU6050_RA_INT_ENABLE, MPU6050_INTERRUPT_I2C_MST_INT_BIT, _buffer);
+    _bus->ReadBit(_devAddr, MPU6050_RA_INT_ENABLE, MPU6050_INTERRUPT_I2C_MST_INT_BIT, _buffer);
     return _buffer[0];
 }
 /** Set I2C Master interrupt enabled status.
@@ -1761,7 +1793,7 @@ bool MPU6050::GetIntI2CMasterEnabled()
  **/
 void MPU6050::SetIntI2CMasterEnabled(bool enabled)
 {
-    I2Cdev::WriteBit(_devAddr, MPU6050_RA_INT_ENABLE, MPU6050_INTERRUPT_I2C_MST_INT_BIT, enabled);
+    _bus->WriteBit(_devAddr, MPU6050_RA_INT_ENABLE, MPU6050_INTERRUPT_I2C_MST_INT_BIT, enabled);
 }
 /** Get Data Ready interrupt enabled setting.
  * This event occurs each time a write operation to all of the sensor registers
@@ -1772,7 +1804,7 @@ void MPU6050::SetIntI2CMasterEnabled(bool enabled)
  */
 bool MPU6050::GetIntDataReadyEnabled()
 {
-    I2Cdev::ReadBit(_devAddr, MPU6050_RA_INT_ENABLE, MPU6050_INTERRUPT_DATA_RDY_BIT, _buffer);
+    _bus->ReadBit(_devAddr, MPU6050_RA_INT_ENABLE, MPU6050_INTERRUPT_DATA_RDY_BIT, _buffer);
     return _buffer[0];
 }
 /** Set Data Ready interrupt enabled status.
@@ -1783,7 +1815,7 @@ bool MPU6050::GetIntDataReadyEnabled()
  */
 void MPU6050::SetIntDataReadyEnabled(bool enabled)
 {
-    I2Cdev::WriteBit(_devAddr, MPU6050_RA_INT_ENABLE, MPU6050_INTERRUPT_DATA_RDY_BIT, enabled);
+    _bus->WriteBit(_devAddr, MPU6050_RA_INT_ENABLE, MPU6050_INTERRUPT_DATA_RDY_BIT, enabled);
 }
 
 // INT_STATUS register
@@ -1797,7 +1829,7 @@ void MPU6050::SetIntDataReadyEnabled(bool enabled)
  */
 uint8_t MPU6050::GetIntStatus()
 {
-    I2Cdev::ReadByte(_devAddr, MPU6050_RA_INT_STATUS, _buffer);
+    _bus->ReadByte(_devAddr, MPU6050_RA_INT_STATUS, _buffer);
     return _buffer[0];
 }
 /** Get Free Fall interrupt status.
@@ -1809,7 +1841,7 @@ uint8_t MPU6050::GetIntStatus()
  */
 bool MPU6050::GetIntFreefallStatus()
 {
-    I2Cdev::ReadBit(_devAddr, MPU6050_RA_INT_STATUS, MPU6050_INTERRUPT_FF_BIT, _buffer);
+    _bus->ReadBit(_devAddr, MPU6050_RA_INT_STATUS, MPU6050_INTERRUPT_FF_BIT, _buffer);
     return _buffer[0];
 }
 /** Get Motion Detection interrupt status.
@@ -1821,7 +1853,7 @@ bool MPU6050::GetIntFreefallStatus()
  */
 bool MPU6050::GetIntMotionStatus()
 {
-    I2Cdev::ReadBit(_devAddr, MPU6050_RA_INT_STATUS, MPU6050_INTERRUPT_MOT_BIT, _buffer);
+    _bus->ReadBit(_devAddr, MPU6050_RA_INT_STATUS, MPU6050_INTERRUPT_MOT_BIT, _buffer);
     return _buffer[0];
 }
 /** Get Zero Motion Detection interrupt status.
@@ -1833,7 +1865,7 @@ bool MPU6050::GetIntMotionStatus()
  */
 bool MPU6050::GetIntZeroMotionStatus()
 {
-    I2Cdev::ReadBit(_devAddr, MPU6050_RA_INT_STATUS, MPU6050_INTERRUPT_ZMOT_BIT, _buffer);
+    _bus->ReadBit(_devAddr, MPU6050_RA_INT_STATUS, MPU6050_INTERRUPT_ZMOT_BIT, _buffer);
     return _buffer[0];
 }
 /** Get FIFO Buffer Overflow interrupt status.
@@ -1845,7 +1877,7 @@ bool MPU6050::GetIntZeroMotionStatus()
  */
 bool MPU6050::GetIntFIFOBufferOverflowStatus()
 {
-    I2Cdev::ReadBit(_devAddr, MPU6050_RA_INT_STATUS, MPU6050_INTERRUPT_FIFO_OFLOW_BIT, _buffer);
+    _bus->ReadBit(_devAddr, MPU6050_RA_INT_STATUS, MPU6050_INTERRUPT_FIFO_OFLOW_BIT, _buffer);
     return _buffer[0];
 }
 /** Get I2C Master interrupt status.
@@ -1858,7 +1890,7 @@ bool MPU6050::GetIntFIFOBufferOverflowStatus()
  */
 bool MPU6050::GetIntI2CMasterStatus()
 {
-    I2Cdev::ReadBit(_devAddr, MPU6050_RA_INT_STATUS, MPU6050_INTERRUPT_I2C_MST_INT_BIT, _buffer);
+    _bus->ReadBit(_devAddr, MPU6050_RA_INT_STATUS, MPU6050_INTERRUPT_I2C_MST_INT_BIT, _buffer);
     return _buffer[0];
 }
 /** Get Data Ready interrupt status.
@@ -1870,7 +1902,7 @@ bool MPU6050::GetIntI2CMasterStatus()
  */
 bool MPU6050::GetIntDataReadyStatus()
 {
-    I2Cdev::ReadBit(_devAddr, MPU6050_RA_INT_STATUS, MPU6050_INTERRUPT_DATA_RDY_BIT, _buffer);
+    _bus->ReadBit(_devAddr, MPU6050_RA_INT_STATUS, MPU6050_INTERRUPT_DATA_RDY_BIT, _buffer);
     return _buffer[0];
 }
 
@@ -1911,7 +1943,7 @@ void MPU6050::GetMotion9(int16_t *ax, int16_t *ay, int16_t *az, int16_t *gx, int
  */
 void MPU6050::GetMotion6(int16_t *ax, int16_t *ay, int16_t *az, int16_t *gx, int16_t *gy, int16_t *gz)
 {
-    I2Cdev::ReadBytes(_devAddr, MPU6050_RA_ACCEL_XOUT_H, 14, _buffer);
+    _bus->ReadBytes(_devAddr, MPU6050_RA_ACCEL_XOUT_H, 14, _buffer);
     *ax = (((int16_t)_buffer[0]) << 8) | _buffer[1];
     *ay = (((int16_t)_buffer[2]) << 8) | _buffer[3];
     *az = (((int16_t)_buffer[4]) << 8) | _buffer[5];
@@ -1957,7 +1989,7 @@ void MPU6050::GetMotion6(int16_t *ax, int16_t *ay, int16_t *az, int16_t *gx, int
  */
 void MPU6050::GetAcceleration(int16_t *x, int16_t *y, int16_t *z)
 {
-    I2Cdev::ReadBytes(_devAddr, MPU6050_RA_ACCEL_XOUT_H, 6, _buffer);
+    _bus->ReadBytes(_devAddr, MPU6050_RA_ACCEL_XOUT_H, 6, _buffer);
     *x = (((int16_t)_buffer[0]) << 8) | _buffer[1];
     *y = (((int16_t)_buffer[2]) << 8) | _buffer[3];
     *z = (((int16_t)_buffer[4]) << 8) | _buffer[5];
@@ -1969,7 +2001,7 @@ void MPU6050::GetAcceleration(int16_t *x, int16_t *y, int16_t *z)
  */
 int16_t MPU6050::GetAccelerationX()
 {
-    I2Cdev::ReadBytes(_devAddr, MPU6050_RA_ACCEL_XOUT_H, 2, _buffer);
+    _bus->ReadBytes(_devAddr, MPU6050_RA_ACCEL_XOUT_H, 2, _buffer);
     return (((int16_t)_buffer[0]) << 8) | _buffer[1];
 }
 /** Get Y-axis accelerometer reading.
@@ -1979,7 +2011,7 @@ int16_t MPU6050::GetAccelerationX()
  */
 int16_t MPU6050::GetAccelerationY()
 {
-    I2Cdev::ReadBytes(_devAddr, MPU6050_RA_ACCEL_YOUT_H, 2, _buffer);
+    _bus->ReadBytes(_devAddr, MPU6050_RA_ACCEL_YOUT_H, 2, _buffer);
     return (((int16_t)_buffer[0]) << 8) | _buffer[1];
 }
 /** Get Z-axis accelerometer reading.
@@ -1989,7 +2021,7 @@ int16_t MPU6050::GetAccelerationY()
  */
 int16_t MPU6050::GetAccelerationZ()
 {
-    I2Cdev::ReadBytes(_devAddr, MPU6050_RA_ACCEL_ZOUT_H, 2, _buffer);
+    _bus->ReadBytes(_devAddr, MPU6050_RA_ACCEL_ZOUT_H, 2, _buffer);
     return (((int16_t)_buffer[0]) << 8) | _buffer[1];
 }
 
@@ -2001,7 +2033,7 @@ int16_t MPU6050::GetAccelerationZ()
  */
 int16_t MPU6050::GetTemperature()
 {
-    I2Cdev::ReadBytes(_devAddr, MPU6050_RA_TEMP_OUT_H, 2, _buffer);
+    _bus->ReadBytes(_devAddr, MPU6050_RA_TEMP_OUT_H, 2, _buffer);
     return (((int16_t)_buffer[0]) << 8) | _buffer[1];
 }
 
@@ -2041,7 +2073,7 @@ int16_t MPU6050::GetTemperature()
  */
 void MPU6050::GetRotation(int16_t *x, int16_t *y, int16_t *z)
 {
-    I2Cdev::ReadBytes(_devAddr, MPU6050_RA_GYRO_XOUT_H, 6, _buffer);
+    _bus->ReadBytes(_devAddr, MPU6050_RA_GYRO_XOUT_H, 6, _buffer);
     *x = (((int16_t)_buffer[0]) << 8) | _buffer[1];
     *y = (((int16_t)_buffer[2]) << 8) | _buffer[3];
     *z = (((int16_t)_buffer[4]) << 8) | _buffer[5];
@@ -2053,7 +2085,7 @@ void MPU6050::GetRotation(int16_t *x, int16_t *y, int16_t *z)
  */
 int16_t MPU6050::GetRotationX()
 {
-    I2Cdev::ReadBytes(_devAddr, MPU6050_RA_GYRO_XOUT_H, 2, _buffer);
+    _bus->ReadBytes(_devAddr, MPU6050_RA_GYRO_XOUT_H, 2, _buffer);
     return (((int16_t)_buffer[0]) << 8) | _buffer[1];
 }
 /** Get Y-axis gyroscope reading.
@@ -2063,7 +2095,7 @@ int16_t MPU6050::GetRotationX()
  */
 int16_t MPU6050::GetRotationY()
 {
-    I2Cdev::ReadBytes(_devAddr, MPU6050_RA_GYRO_YOUT_H, 2, _buffer);
+    _bus->ReadBytes(_devAddr, MPU6050_RA_GYRO_YOUT_H, 2, _buffer);
     return (((int16_t)_buffer[0]) << 8) | _buffer[1];
 }
 /** Get Z-axis gyroscope reading.
@@ -2073,7 +2105,7 @@ int16_t MPU6050::GetRotationY()
  */
 int16_t MPU6050::GetRotationZ()
 {
-    I2Cdev::ReadBytes(_devAddr, MPU6050_RA_GYRO_ZOUT_H, 2, _buffer);
+    _bus->ReadBytes(_devAddr, MPU6050_RA_GYRO_ZOUT_H, 2, _buffer);
     return (((int16_t)_buffer[0]) << 8) | _buffer[1];
 }
 
@@ -2155,7 +2187,7 @@ int16_t MPU6050::GetRotationZ()
  */
 uint8_t MPU6050::GetExternalSensorByte(int position)
 {
-    I2Cdev::ReadByte(_devAddr, MPU6050_RA_EXT_SENS_DATA_00 + position, _buffer);
+    _bus->ReadByte(_devAddr, MPU6050_RA_EXT_SENS_DATA_00 + position, _buffer);
     return _buffer[0];
 }
 /** Read word (2 bytes) from external sensor data registers.
@@ -2165,7 +2197,7 @@ uint8_t MPU6050::GetExternalSensorByte(int position)
  */
 uint16_t MPU6050::GetExternalSensorWord(int position)
 {
-    I2Cdev::ReadBytes(_devAddr, MPU6050_RA_EXT_SENS_DATA_00 + position, 2, _buffer);
+    _bus->ReadBytes(_devAddr, MPU6050_RA_EXT_SENS_DATA_00 + position, 2, _buffer);
     return (((uint16_t)_buffer[0]) << 8) | _buffer[1];
 }
 /** Read double word (4 bytes) from external sensor data registers.
@@ -2175,7 +2207,7 @@ uint16_t MPU6050::GetExternalSensorWord(int position)
  */
 uint32_t MPU6050::GetExternalSensorDWord(int position)
 {
-    I2Cdev::ReadBytes(_devAddr, MPU6050_RA_EXT_SENS_DATA_00 + position, 4, _buffer);
+    _bus->ReadBytes(_devAddr, MPU6050_RA_EXT_SENS_DATA_00 + position, 4, _buffer);
     return (((uint32_t)_buffer[0]) << 24) | (((uint32_t)_buffer[1]) << 16) | (((uint16_t)_buffer[2]) << 8) | _buffer[3];
 }
 
@@ -2188,7 +2220,7 @@ uint32_t MPU6050::GetExternalSensorDWord(int position)
  */
 bool MPU6050::GetXNegMotionDetected()
 {
-    I2Cdev::ReadBit(_devAddr, MPU6050_RA_MOT_DETECT_STATUS, MPU6050_MOTION_MOT_XNEG_BIT, _buffer);
+    _bus->ReadBit(_devAddr, MPU6050_RA_MOT_DETECT_STATUS, MPU6050_MOTION_MOT_XNEG_BIT, _buffer);
     return _buffer[0];
 }
 /** Get X-axis positive motion detection interrupt status.
@@ -2198,7 +2230,7 @@ bool MPU6050::GetXNegMotionDetected()
  */
 bool MPU6050::GetXPosMotionDetected()
 {
-    I2Cdev::ReadBit(_devAddr, MPU6050_RA_MOT_DETECT_STATUS, MPU6050_MOTION_MOT_XPOS_BIT, _buffer);
+    _bus->ReadBit(_devAddr, MPU6050_RA_MOT_DETECT_STATUS, MPU6050_MOTION_MOT_XPOS_BIT, _buffer);
     return _buffer[0];
 }
 /** Get Y-axis negative motion detection interrupt status.
@@ -2208,7 +2240,7 @@ bool MPU6050::GetXPosMotionDetected()
  */
 bool MPU6050::GetYNegMotionDetected()
 {
-    I2Cdev::ReadBit(_devAddr, MPU6050_RA_MOT_DETECT_STATUS, MPU6050_MOTION_MOT_YNEG_BIT, _buffer);
+    _bus->ReadBit(_devAddr, MPU6050_RA_MOT_DETECT_STATUS, MPU6050_MOTION_MOT_YNEG_BIT, _buffer);
     return _buffer[0];
 }
 /** Get Y-axis positive motion detection interrupt status.
@@ -2218,7 +2250,7 @@ bool MPU6050::GetYNegMotionDetected()
  */
 bool MPU6050::GetYPosMotionDetected()
 {
-    I2Cdev::ReadBit(_devAddr, MPU6050_RA_MOT_DETECT_STATUS, MPU6050_MOTION_MOT_YPOS_BIT, _buffer);
+    _bus->ReadBit(_devAddr, MPU6050_RA_MOT_DETECT_STATUS, MPU6050_MOTION_MOT_YPOS_BIT, _buffer);
     return _buffer[0];
 }
 /** Get Z-axis negative motion detection interrupt status.
@@ -2228,7 +2260,7 @@ bool MPU6050::GetYPosMotionDetected()
  */
 bool MPU6050::GetZNegMotionDetected()
 {
-    I2Cdev::ReadBit(_devAddr, MPU6050_RA_MOT_DETECT_STATUS, MPU6050_MOTION_MOT_ZNEG_BIT, _buffer);
+    _bus->ReadBit(_devAddr, MPU6050_RA_MOT_DETECT_STATUS, MPU6050_MOTION_MOT_ZNEG_BIT, _buffer);
     return _buffer[0];
 }
 /** Get Z-axis positive motion detection interrupt status.
@@ -2238,7 +2270,7 @@ bool MPU6050::GetZNegMotionDetected()
  */
 bool MPU6050::GetZPosMotionDetected()
 {
-    I2Cdev::ReadBit(_devAddr, MPU6050_RA_MOT_DETECT_STATUS, MPU6050_MOTION_MOT_ZPOS_BIT, _buffer);
+    _bus->ReadBit(_devAddr, MPU6050_RA_MOT_DETECT_STATUS, MPU6050_MOTION_MOT_ZPOS_BIT, _buffer);
     return _buffer[0];
 }
 /** Get zero motion detection interrupt status.
@@ -2248,7 +2280,7 @@ bool MPU6050::GetZPosMotionDetected()
  */
 bool MPU6050::GetZeroMotionDetected()
 {
-    I2Cdev::ReadBit(_devAddr, MPU6050_RA_MOT_DETECT_STATUS, MPU6050_MOTION_MOT_ZRMOT_BIT, _buffer);
+    _bus->ReadBit(_devAddr, MPU6050_RA_MOT_DETECT_STATUS, MPU6050_MOTION_MOT_ZRMOT_BIT, _buffer);
     return _buffer[0];
 }
 
@@ -2268,7 +2300,7 @@ void MPU6050::SetSlaveOutputByte(uint8_t num, uint8_t data)
     {
         return;
     }
-    I2Cdev::WriteByte(_devAddr, MPU6050_RA_I2C_SLV0_DO + num, data);
+    _bus->WriteByte(_devAddr, MPU6050_RA_I2C_SLV0_DO + num, data);
 }
 
 // I2C_MST_DELAY_CTRL register
@@ -2283,7 +2315,7 @@ void MPU6050::SetSlaveOutputByte(uint8_t num, uint8_t data)
  */
 bool MPU6050::GetExternalShadowDelayEnabled()
 {
-    I2Cdev::ReadBit(_devAddr, MPU6050_RA_I2C_MST_DELAY_CTRL, MPU6050_DELAYCTRL_DELAY_ES_SHADOW_BIT, _buffer);
+    _bus->ReadBit(_devAddr, MPU6050_RA_I2C_MST_DELAY_CTRL, MPU6050_DELAYCTRL_DELAY_ES_SHADOW_BIT, _buffer);
     return _buffer[0];
 }
 /** Set external data shadow delay enabled status.
@@ -2294,7 +2326,7 @@ bool MPU6050::GetExternalShadowDelayEnabled()
  */
 void MPU6050::SetExternalShadowDelayEnabled(bool enabled)
 {
-    I2Cdev::WriteBit(_devAddr, MPU6050_RA_I2C_MST_DELAY_CTRL, MPU6050_DELAYCTRL_DELAY_ES_SHADOW_BIT, enabled);
+    _bus->WriteBit(_devAddr, MPU6050_RA_I2C_MST_DELAY_CTRL, MPU6050_DELAYCTRL_DELAY_ES_SHADOW_BIT, enabled);
 }
 /** Get slave delay enabled status.
  * When a particular slave delay is enabled, the rate of access for the that
@@ -2321,7 +2353,7 @@ bool MPU6050::GetSlaveDelayEnabled(uint8_t num)
     {
         return 0;
     }
-    I2Cdev::ReadBit(_devAddr, MPU6050_RA_I2C_MST_DELAY_CTRL, num, _buffer);
+    _bus->ReadBit(_devAddr, MPU6050_RA_I2C_MST_DELAY_CTRL, num, _buffer);
     return _buffer[0];
 }
 /** Set slave delay enabled status.
@@ -2332,7 +2364,7 @@ bool MPU6050::GetSlaveDelayEnabled(uint8_t num)
  */
 void MPU6050::SetSlaveDelayEnabled(uint8_t num, bool enabled)
 {
-    I2Cdev::WriteBit(_devAddr, MPU6050_RA_I2C_MST_DELAY_CTRL, num, enabled);
+    _bus->WriteBit(_devAddr, MPU6050_RA_I2C_MST_DELAY_CTRL, num, enabled);
 }
 
 // SIGNAL_PATH_RESET register
@@ -2345,7 +2377,7 @@ void MPU6050::SetSlaveDelayEnabled(uint8_t num, bool enabled)
  */
 void MPU6050::ResetGyroscopePath()
 {
-    I2Cdev::WriteBit(_devAddr, MPU6050_RA_SIGNAL_PATH_RESET, MPU6050_PATHRESET_GYRO_RESET_BIT, true);
+    _bus->WriteBit(_devAddr, MPU6050_RA_SIGNAL_PATH_RESET, MPU6050_PATHRESET_GYRO_RESET_BIT, true);
 }
 /** Reset accelerometer signal path.
  * The reset will revert the signal path analog to digital converters and
@@ -2355,7 +2387,7 @@ void MPU6050::ResetGyroscopePath()
  */
 void MPU6050::ResetAccelerometerPath()
 {
-    I2Cdev::WriteBit(_devAddr, MPU6050_RA_SIGNAL_PATH_RESET, MPU6050_PATHRESET_ACCEL_RESET_BIT, true);
+    _bus->WriteBit(_devAddr, MPU6050_RA_SIGNAL_PATH_RESET, MPU6050_PATHRESET_ACCEL_RESET_BIT, true);
 }
 /** Reset temperature sensor signal path.
  * The reset will revert the signal path analog to digital converters and
@@ -2365,7 +2397,7 @@ void MPU6050::ResetAccelerometerPath()
  */
 void MPU6050::ResetTemperaturePath()
 {
-    I2Cdev::WriteBit(_devAddr, MPU6050_RA_SIGNAL_PATH_RESET, MPU6050_PATHRESET_TEMP_RESET_BIT, true);
+    _bus->WriteBit(_devAddr, MPU6050_RA_SIGNAL_PATH_RESET, MPU6050_PATHRESET_TEMP_RESET_BIT, true);
 }
 
 // MOT_DETECT_CTRL register
@@ -2386,7 +2418,7 @@ void MPU6050::ResetTemperaturePath()
  */
 uint8_t MPU6050::GetAccelerometerPowerOnDelay()
 {
-    I2Cdev::ReadBits(_devAddr, MPU6050_RA_MOT_DETECT_CTRL, MPU6050_DETECT_ACCEL_ON_DELAY_BIT, MPU6050_DETECT_ACCEL_ON_DELAY_LENGTH, _buffer);
+    _bus->ReadBits(_devAddr, MPU6050_RA_MOT_DETECT_CTRL, MPU6050_DETECT_ACCEL_ON_DELAY_BIT, MPU6050_DETECT_ACCEL_ON_DELAY_LENGTH, _buffer);
     return _buffer[0];
 }
 /** Set accelerometer power-on delay.
@@ -2397,7 +2429,7 @@ uint8_t MPU6050::GetAccelerometerPowerOnDelay()
  */
 void MPU6050::SetAccelerometerPowerOnDelay(uint8_t delay)
 {
-    I2Cdev::WriteBits(_devAddr, MPU6050_RA_MOT_DETECT_CTRL, MPU6050_DETECT_ACCEL_ON_DELAY_BIT, MPU6050_DETECT_ACCEL_ON_DELAY_LENGTH, delay);
+    _bus->WriteBits(_devAddr, MPU6050_RA_MOT_DETECT_CTRL, MPU6050_DETECT_ACCEL_ON_DELAY_BIT, MPU6050_DETECT_ACCEL_ON_DELAY_LENGTH, delay);
 }
 /** Get Free Fall detection counter decrement configuration.
  * Detection is registered by the Free Fall detection module after accelerometer
@@ -2427,7 +2459,7 @@ void MPU6050::SetAccelerometerPowerOnDelay(uint8_t delay)
  */
 uint8_t MPU6050::GetFreefallDetectionCounterDecrement()
 {
-    I2Cdev::ReadBits(_devAddr, MPU6050_RA_MOT_DETECT_CTRL, MPU6050_DETECT_FF_COUNT_BIT, MPU6050_DETECT_FF_COUNT_LENGTH, _buffer);
+    _bus->ReadBits(_devAddr, MPU6050_RA_MOT_DETECT_CTRL, MPU6050_DETECT_FF_COUNT_BIT, MPU6050_DETECT_FF_COUNT_LENGTH, _buffer);
     return _buffer[0];
 }
 /** Set Free Fall detection counter decrement configuration.
@@ -2438,7 +2470,7 @@ uint8_t MPU6050::GetFreefallDetectionCounterDecrement()
  */
 void MPU6050::SetFreefallDetectionCounterDecrement(uint8_t decrement)
 {
-    I2Cdev::WriteBits(_devAddr, MPU6050_RA_MOT_DETECT_CTRL, MPU6050_DETECT_FF_COUNT_BIT, MPU6050_DETECT_FF_COUNT_LENGTH, decrement);
+    _bus->WriteBits(_devAddr, MPU6050_RA_MOT_DETECT_CTRL, MPU6050_DETECT_FF_COUNT_BIT, MPU6050_DETECT_FF_COUNT_LENGTH, decrement);
 }
 /** Get Motion detection counter decrement configuration.
  * Detection is registered by the Motion detection module after accelerometer
@@ -2465,7 +2497,7 @@ void MPU6050::SetFreefallDetectionCounterDecrement(uint8_t decrement)
  */
 uint8_t MPU6050::GetMotionDetectionCounterDecrement()
 {
-    I2Cdev::ReadBits(_devAddr, MPU6050_RA_MOT_DETECT_CTRL, MPU6050_DETECT_MOT_COUNT_BIT, MPU6050_DETECT_MOT_COUNT_LENGTH, _buffer);
+    _bus->ReadBits(_devAddr, MPU6050_RA_MOT_DETECT_CTRL, MPU6050_DETECT_MOT_COUNT_BIT, MPU6050_DETECT_MOT_COUNT_LENGTH, _buffer);
     return _buffer[0];
 }
 /** Set Motion detection counter decrement configuration.
@@ -2476,7 +2508,7 @@ uint8_t MPU6050::GetMotionDetectionCounterDecrement()
  */
 void MPU6050::SetMotionDetectionCounterDecrement(uint8_t decrement)
 {
-    I2Cdev::WriteBits(_devAddr, MPU6050_RA_MOT_DETECT_CTRL, MPU6050_DETECT_MOT_COUNT_BIT, MPU6050_DETECT_MOT_COUNT_LENGTH, decrement);
+    _bus->WriteBits(_devAddr, MPU6050_RA_MOT_DETECT_CTRL, MPU6050_DETECT_MOT_COUNT_BIT, MPU6050_DETECT_MOT_COUNT_LENGTH, decrement);
 }
 
 // USER_CTRL register
@@ -2491,7 +2523,7 @@ void MPU6050::SetMotionDetectionCounterDecrement(uint8_t decrement)
  */
 bool MPU6050::GetFIFOEnabled()
 {
-    I2Cdev::ReadBit(_devAddr, MPU6050_RA_USER_CTRL, MPU6050_USERCTRL_FIFO_EN_BIT, _buffer);
+    _bus->ReadBit(_devAddr, MPU6050_RA_USER_CTRL, MPU6050_USERCTRL_FIFO_EN_BIT, _buffer);
     return _buffer[0];
 }
 /** Set FIFO enabled status.
@@ -2502,7 +2534,7 @@ bool MPU6050::GetFIFOEnabled()
  */
 void MPU6050::SetFIFOEnabled(bool enabled)
 {
-    I2Cdev::WriteBit(_devAddr, MPU6050_RA_USER_CTRL, MPU6050_USERCTRL_FIFO_EN_BIT, enabled);
+    _bus->WriteBit(_devAddr, MPU6050_RA_USER_CTRL, MPU6050_USERCTRL_FIFO_EN_BIT, enabled);
 }
 /** Get I2C Master Mode enabled status.
  * When this mode is enabled, the MPU-60X0 acts as the I2C Master to the
@@ -2517,7 +2549,7 @@ void MPU6050::SetFIFOEnabled(bool enabled)
  */
 bool MPU6050::GetI2CMasterModeEnabled()
 {
-    I2Cdev::ReadBit(_devAddr, MPU6050_RA_USER_CTRL, MPU6050_USERCTRL_I2C_MST_EN_BIT, _buffer);
+    _bus->ReadBit(_devAddr, MPU6050_RA_USER_CTRL, MPU6050_USERCTRL_I2C_MST_EN_BIT, _buffer);
     return _buffer[0];
 }
 /** Set I2C Master Mode enabled status.
@@ -2528,7 +2560,7 @@ bool MPU6050::GetI2CMasterModeEnabled()
  */
 void MPU6050::SetI2CMasterModeEnabled(bool enabled)
 {
-    I2Cdev::WriteBit(_devAddr, MPU6050_RA_USER_CTRL, MPU6050_USERCTRL_I2C_MST_EN_BIT, enabled);
+    _bus->WriteBit(_devAddr, MPU6050_RA_USER_CTRL, MPU6050_USERCTRL_I2C_MST_EN_BIT, enabled);
 }
 /** Switch from I2C to SPI mode (MPU-6000 only)
  * If this is set, the primary SPI interface will be enabled in place of the
@@ -2536,7 +2568,7 @@ void MPU6050::SetI2CMasterModeEnabled(bool enabled)
  */
 void MPU6050::SwitchSPIEnabled(bool enabled)
 {
-    I2Cdev::WriteBit(_devAddr, MPU6050_RA_USER_CTRL, MPU6050_USERCTRL_I2C_IF_DIS_BIT, enabled);
+    _bus->WriteBit(_devAddr, MPU6050_RA_USER_CTRL, MPU6050_USERCTRL_I2C_IF_DIS_BIT, enabled);
 }
 /** Reset the FIFO.
  * This bit resets the FIFO _buffer when set to 1 while FIFO_EN equals 0. This
@@ -2546,7 +2578,7 @@ void MPU6050::SwitchSPIEnabled(bool enabled)
  */
 void MPU6050::ResetFIFO()
 {
-    I2Cdev::WriteBit(_devAddr, MPU6050_RA_USER_CTRL, MPU6050_USERCTRL_FIFO_RESET_BIT, true);
+    _bus->WriteBit(_devAddr, MPU6050_RA_USER_CTRL, MPU6050_USERCTRL_FIFO_RESET_BIT, true);
 }
 /** Reset the I2C Master.
  * This bit resets the I2C Master when set to 1 while I2C_MST_EN equals 0.
@@ -2556,7 +2588,7 @@ void MPU6050::ResetFIFO()
  */
 void MPU6050::ResetI2CMaster()
 {
-    I2Cdev::WriteBit(_devAddr, MPU6050_RA_USER_CTRL, MPU6050_USERCTRL_I2C_MST_RESET_BIT, true);
+    _bus->WriteBit(_devAddr, MPU6050_RA_USER_CTRL, MPU6050_USERCTRL_I2C_MST_RESET_BIT, true);
 }
 /** Reset all sensor registers and signal paths.
  * When set to 1, this bit resets the signal paths for all sensors (gyroscopes,
@@ -2572,7 +2604,7 @@ void MPU6050::ResetI2CMaster()
  */
 void MPU6050::ResetSensors()
 {
-    I2Cdev::WriteBit(_devAddr, MPU6050_RA_USER_CTRL, MPU6050_USERCTRL_SIG_COND_RESET_BIT, true);
+    _bus->WriteBit(_devAddr, MPU6050_RA_USER_CTRL, MPU6050_USERCTRL_SIG_COND_RESET_BIT, true);
 }
 
 // PWR_MGMT_1 register
@@ -2584,7 +2616,9 @@ void MPU6050::ResetSensors()
  */
 void MPU6050::Reset()
 {
-    I2Cdev::WriteBit(_devAddr, MPU6050_RA_PWR_MGMT_1, MPU6050_PWR1_DEVICE_RESET_BIT, true);
+    _bus->WriteBit(_devAddr, MPU6050_RA_PWR_MGMT_1, MPU6050_PWR1_DEVICE_RESET_BIT, true);
+    // Every register goes back to its power-on value
+    _bus->InvalidateCache(_devAddr);
 }
 /** Get sleep mode status.
  * Setting the SLEEP bit in the register puts the device into very low power
@@ -2599,7 +2633,7 @@ void MPU6050::Reset()
  */
 bool MPU6050::GetSleepEnabled()
 {
-    I2Cdev::ReadBit(_devAddr, MPU6050_RA_PWR_MGMT_1, MPU6050_PWR1_SLEEP_BIT, _buffer);
+    _bus->ReadBit(_devAddr, MPU6050_RA_PWR_MGMT_1, MPU6050_PWR1_SLEEP_BIT, _buffer);
     return _buffer[0];
 }
 /** Set sleep mode status.
@@ -2610,7 +2644,7 @@ bool MPU6050::GetSleepEnabled()
  */
 void MPU6050::SetSleepEnabled(bool enabled)
 {
-    I2Cdev::WriteBit(_devAddr, MPU6050_RA_PWR_MGMT_1, MPU6050_PWR1_SLEEP_BIT, enabled);
+    _bus->WriteBit(_devAddr, MPU6050_RA_PWR_MGMT_1, MPU6050_PWR1_SLEEP_BIT, enabled);
 }
 /** Get wake cycle enabled status.
  * When this bit is set to 1 and SLEEP is disabled, the MPU-60X0 will cycle
@@ -2622,7 +2656,7 @@ void MPU6050::SetSleepEnabled(bool enabled)
  */
 bool MPU6050::GetWakeCycleEnabled()
 {
-    I2Cdev::ReadBit(_devAddr, MPU6050_RA_PWR_MGMT_1, MPU6050_PWR1_CYCLE_BIT, _buffer);
+    _bus->ReadBit(_devAddr, MPU6050_RA_PWR_MGMT_1, MPU6050_PWR1_CYCLE_BIT, _buffer);
     return _buffer[0];
 }
 /** Set wake cycle enabled status.
@@ -2633,7 +2667,7 @@ bool MPU6050::GetWakeCycleEnabled()
  */
 void MPU6050::SetWakeCycleEnabled(bool enabled)
 {
-    I2Cdev::WriteBit(_devAddr, MPU6050_RA_PWR_MGMT_1, MPU6050_PWR1_CYCLE_BIT, enabled);
+    _bus->WriteBit(_devAddr, MPU6050_RA_PWR_MGMT_1, MPU6050_PWR1_CYCLE_BIT, enabled);
 }
 /** Get temperature sensor enabled status.
  * Control the usage of the internal temperature sensor.
@@ -2648,7 +2682,7 @@ void MPU6050::SetWakeCycleEnabled(bool enabled)
  */
 bool MPU6050::GetTempSensorEnabled()
 {
-    I2Cdev::ReadBit(_devAddr, MPU6050_RA_PWR_MGMT_1, MPU6050_PWR1_TEMP_DIS_BIT, _buffer);
+    _bus->ReadBit(_devAddr, MPU6050_RA_PWR_MGMT_1, MPU6050_PWR1_TEMP_DIS_BIT, _buffer);
     return _buffer[0] == 0; // 1 is actually disabled here
 }
 /** Set temperature sensor enabled status.
@@ -2664,7 +2698,7 @@ bool MPU6050::GetTempSensorEnabled()
 void MPU6050::SetTempSensorEnabled(bool enabled)
 {
     // 1 is actually disabled here
-    I2Cdev::WriteBit(_devAddr, MPU6050_RA_PWR_MGMT_1, MPU6050_PWR1_TEMP_DIS_BIT, !enabled);
+    _bus->WriteBit(_devAddr, MPU6050_RA_PWR_MGMT_1, MPU6050_PWR1_TEMP_DIS_BIT, !enabled);
 }
 /** Get clock source setting.
  * @return Current clock source setting
@@ -2674,7 +2708,7 @@ void MPU6050::SetTempSensorEnabled(bool enabled)
  */
 uint8_t MPU6050::GetClockSource()
 {
-    I2Cdev::ReadBits(_devAddr, MPU6050_RA_PWR_MGMT_1, MPU6050_PWR1_CLKSEL_BIT, MPU6050_PWR1_CLKSEL_LENGTH, _buffer);
+    _bus->ReadBits(_devAddr, MPU6050_RA_PWR_MGMT_1, MPU6050_PWR1_CLKSEL_BIT, MPU6050_PWR1_CLKSEL_LENGTH, _buffer);
     return _buffer[0];
 }
 /** Set clock source setting.
@@ -2709,7 +2743,7 @@ uint8_t MPU6050::GetClockSource()
  */
 void MPU6050::SetClockSource(uint8_t source)
 {
-    I2Cdev::WriteBits(_devAddr, MPU6050_RA_PWR_MGMT_1, MPU6050_PWR1_CLKSEL_BIT, MPU6050_PWR1_CLKSEL_LENGTH, source);
+    _bus->WriteBits(_devAddr, MPU6050_RA_PWR_MGMT_1, MPU6050_PWR1_CLKSEL_BIT, MPU6050_PWR1_CLKSEL_LENGTH, source);
 }
 
 // PWR_MGMT_2 register
@@ -2739,7 +2773,7 @@ void MPU6050::SetClockSource(uint8_t source)
  */
 uint8_t MPU6050::GetWakeFrequency()
 {
-    I2Cdev::ReadBits(_devAddr, MPU6050_RA_PWR_MGMT_2, MPU6050_PWR2_LP_WAKE_CTRL_BIT, MPU6050_PWR2_LP_WAKE_CTRL_LENGTH, _buffer);
+    _bus->ReadBits(_devAddr, MPU6050_RA_PWR_MGMT_2, MPU6050_PWR2_LP_WAKE_CTRL_BIT, MPU6050_PWR2_LP_WAKE_CTRL_LENGTH, _buffer);
     return _buffer[0];
 }
 /** Set wake frequency in Accel-Only Low Power Mode.
@@ -2748,7 +2782,7 @@ uint8_t MPU6050::GetWakeFrequency()
  */
 void MPU6050::SetWakeFrequency(uint8_t frequency)
 {
-    I2Cdev::WriteBits(_devAddr, MPU6050_RA_PWR_MGMT_2, MPU6050_PWR2_LP_WAKE_CTRL_BIT, MPU6050_PWR2_LP_WAKE_CTRL_LENGTH, frequency);
+    _bus->WriteBits(_devAddr, MPU6050_RA_PWR_MGMT_2, MPU6050_PWR2_LP_WAKE_CTRL_BIT, MPU6050_PWR2_LP_WAKE_CTRL_LENGTH, frequency);
 }
 
 /** Get X-axis accelerometer standby enabled status.
@@ -2759,7 +2793,7 @@ void MPU6050::SetWakeFrequency(uint8_t frequency)
  */
 bool MPU6050::GetStandbyXAccelEnabled()
 {
-    I2Cdev::ReadBit(_devAddr, MPU6050_RA_PWR_MGMT_2, MPU6050_PWR2_STBY_XA_BIT, _buffer);
+    _bus->ReadBit(_devAddr, MPU6050_RA_PWR_MGMT_2, MPU6050_PWR2_STBY_XA_BIT, _buffer);
     return _buffer[0];
 }
 /** Set X-axis accelerometer standby enabled status.
@@ -2770,7 +2804,7 @@ bool MPU6050::GetStandbyXAccelEnabled()
  */
 void MPU6050::SetStandbyXAccelEnabled(bool enabled)
 {
-    I2Cdev::WriteBit(_devAddr, MPU6050_RA_PWR_MGMT_2, MPU6050_PWR2_STBY_XA_BIT, enabled);
+    _bus->WriteBit(_devAddr, MPU6050_RA_PWR_MGMT_2, MPU6050_PWR2_STBY_XA_BIT, enabled);
 }
 /** Get Y-axis accelerometer standby enabled status.
  * If enabled, the Y-axis will not gather or report data (or use power).
@@ -2780,7 +2814,7 @@ void MPU6050::SetStandbyXAccelEnabled(bool enabled)
  */
 bool MPU6050::GetStandbyYAccelEnabled()
 {
-    I2Cdev::ReadBit(_devAddr, MPU6050_RA_PWR_MGMT_2, MPU6050_PWR2_STBY_YA_BIT, _buffer);
+    _bus->ReadBit(_devAddr, MPU6050_RA_PWR_MGMT_2, MPU6050_PWR2_STBY_YA_BIT, _buffer);
     return _buffer[0];
 }
 /** Set Y-axis accelerometer standby enabled status.
@@ -2791,7 +2825,7 @@ bool MPU6050::GetStandbyYAccelEnabled()
  */
 void MPU6050::SetStandbyYAccelEnabled(bool enabled)
 {
-    I2Cdev::WriteBit(_devAddr, MPU6050_RA_PWR_MGMT_2, MPU6050_PWR2_STBY_YA_BIT, enabled);
+    _bus->WriteBit(_devAddr, MPU6050_RA_PWR_MGMT_2, MPU6050_PWR2_STBY_YA_BIT, enabled);
 }
 /** Get Z-axis accelerometer standby enabled status.
  * If enabled, the Z-axis will not gather or report data (or use power).
@@ -2801,7 +2835,7 @@ void MPU6050::SetStandbyYAccelEnabled(bool enabled)
  */
 bool MPU6050::GetStandbyZAccelEnabled()
 {
-    I2Cdev::ReadBit(_devAddr, MPU6050_RA_PWR_MGMT_2, MPU6050_PWR2_STBY_ZA_BIT, _buffer);
+    _bus->ReadBit(_devAddr, MPU6050_RA_PWR_MGMT_2, MPU6050_PWR2_STBY_ZA_BIT, _buffer);
     return _buffer[0];
 }
 /** Set Z-axis accelerometer standby enabled status.
@@ -2812,7 +2846,7 @@ bool MPU6050::GetStandbyZAccelEnabled()
  */
 void MPU6050::SetStandbyZAccelEnabled(bool enabled)
 {
-    I2Cdev::WriteBit(_devAddr, MPU6050_RA_PWR_MGMT_2, MPU6050_PWR2_STBY_ZA_BIT, enabled);
+    _bus->WriteBit(_devAddr, MPU6050_RA_PWR_MGMT_2, MPU6050_PWR2_STBY_ZA_BIT, enabled);
 }
 /** Get X-axis gyroscope standby enabled status.
  * If enabled, the X-axis will not gather or report data (or use power).
@@ -2822,7 +2856,7 @@ void MPU6050::SetStandbyZAccelEnabled(bool enabled)
  */
 bool MPU6050::GetStandbyXGyroEnabled()
 {
-    I2Cdev::ReadBit(_devAddr, MPU6050_RA_PWR_MGMT_2, MPU6050_PWR2_STBY_XG_BIT, _buffer);
+    _bus->ReadBit(_devAddr, MPU6050_RA_PWR_MGMT_2, MPU6050_PWR2_STBY_XG_BIT, _buffer);
     return _buffer[0];
 }
 /** Set X-axis gyroscope standby enabled status.
@@ -2833,7 +2867,7 @@ bool MPU6050::GetStandbyXGyroEnabled()
  */
 void MPU6050::SetStandbyXGyroEnabled(bool enabled)
 {
-    I2Cdev::WriteBit(_devAddr, MPU6050_RA_PWR_MGMT_2, MPU6050_PWR2_STBY_XG_BIT, enabled);
+    _bus->WriteBit(_devAddr, MPU6050_RA_PWR_MGMT_2, MPU6050_PWR2_STBY_XG_BIT, enabled);
 }
 /** Get Y-axis gyroscope standby enabled status.
  * If enabled, the Y-axis will not gather or report data (or use power).
@@ -2843,7 +2877,7 @@ void MPU6050::SetStandbyXGyroEnabled(bool enabled)
  */
 bool MPU6050::GetStandbyYGyroEnabled()
 {
-    I2Cdev::ReadBit(_devAddr, MPU6050_RA_PWR_MGMT_2, MPU6050_PWR2_STBY_YG_BIT, _buffer);
+    _bus->ReadBit(_devAddr, MPU6050_RA_PWR_MGMT_2, MPU6050_PWR2_STBY_YG_BIT, _buffer);
     return _buffer[0];
 }
 /** Set Y-axis gyroscope standby enabled status.
@@ -2854,7 +2888,7 @@ bool MPU6050::GetStandbyYGyroEnabled()
  */
 void MPU6050::SetStandbyYGyroEnabled(bool enabled)
 {
-    I2Cdev::WriteBit(_devAddr, MPU6050_RA_PWR_MGMT_2, MPU6050_PWR2_STBY_YG_BIT, enabled);
+    _bus->WriteBit(_devAddr, MPU6050_RA_PWR_MGMT_2, MPU6050_PWR2_STBY_YG_BIT, enabled);
 }
 /** Get Z-axis gyroscope standby enabled status.
  * If enabled, the Z-axis will not gather or report data (or use power).
@@ -2864,7 +2898,7 @@ void MPU6050::SetStandbyYGyroEnabled(bool enabled)
  */
 bool MPU6050::GetStandbyZGyroEnabled()
 {
-    I2Cdev::ReadBit(_devAddr, MPU6050_RA_PWR_MGMT_2, MPU6050_PWR2_STBY_ZG_BIT, _buffer);
+    _bus->ReadBit(_devAddr, MPU6050_RA_PWR_MGMT_2, MPU6050_PWR2_STBY_ZG_BIT, _buffer);
     return _buffer[0];
 }
 /** Set Z-axis gyroscope standby enabled status.
@@ -2875,7 +2909,7 @@ bool MPU6050::GetStandbyZGyroEnabled()
  */
 void MPU6050::SetStandbyZGyroEnabled(bool enabled)
 {
-    I2Cdev::WriteBit(_devAddr, MPU6050_RA_PWR_MGMT_2, MPU6050_PWR2_STBY_ZG_BIT, enabled);
+    _bus->WriteBit(_devAddr, MPU6050_RA_PWR_MGMT_2, MPU6050_PWR2_STBY_ZG_BIT, enabled);
 }
 
 // FIFO_COUNT* registers
@@ -2889,7 +2923,7 @@ void MPU6050::SetStandbyZGyroEnabled(bool enabled)
  */
 uint16_t MPU6050::GetFIFOCount()
 {
-    I2Cdev::ReadBytes(_devAddr, MPU6050_RA_FIFO_COUNTH, 2, _buffer);
+    _bus->ReadBytes(_devAddr, MPU6050_RA_FIFO_COUNTH, 2, _buffer);
     return (((uint16_t)_buffer[0]) << 8) | _buffer[1];
 }
 
@@ -2922,12 +2956,18 @@ uint16_t MPU6050::GetFIFOCount()
  */
 uint8_t MPU6050::GetFIFOByte()
 {
-    I2Cdev::ReadByte(_devAddr, MPU6050_RA_FIFO_R_W, _buffer);
+    _bus->ReadByte(_devAddr, MPU6050_RA_FIFO_R_W, _buffer);
     return _buffer[0];
 }
-void MPU6050::GetFIFOBytes(uint8_t *data, uint8_t length)
+/** Read a burst of bytes from the FIFO _buffer.
+ * @param data Buffer receiving the bytes
+ * @param length Number of bytes to read
+ * @return True if the bytes were read
+ * @see GetFIFOByte()
+ */
+bool MPU6050::GetFIFOBytes(uint8_t *data, uint8_t length)
 {
-    I2Cdev::ReadBytes(_devAddr, MPU6050_RA_FIFO_R_W, length, data);
+    return _bus->ReadBytes(_devAddr, MPU6050_RA_FIFO_R_W, length, data);
 }
 /** Write byte to FIFO _buffer.
  * @see GetFIFOByte()
@@ -2935,7 +2975,7 @@ void MPU6050::GetFIFOBytes(uint8_t *data, uint8_t length)
  */
 void MPU6050::SetFIFOByte(uint8_t data)
 {
-    I2Cdev::WriteByte(_devAddr, MPU6050_RA_FIFO_R_W, data);
+    _bus->WriteByte(_devAddr, MPU6050_RA_FIFO_R_W, data);
 }
 
 // WHO_AM_I register
@@ -2949,7 +2989,7 @@ void MPU6050::SetFIFOByte(uint8_t data)
  */
 uint8_t MPU6050::GetDeviceID()
 {
-    I2Cdev::ReadBits(_devAddr, MPU6050_RA_WHO_AM_I, MPU6050_WHO_AM_I_BIT, MPU6050_WHO_AM_I_LENGTH, _buffer);
+    _bus->ReadBits(_devAddr, MPU6050_RA_WHO_AM_I, MPU6050_WHO_AM_I_BIT, MPU6050_WHO_AM_I_LENGTH, _buffer);
     return _buffer[0];
 }
 /** Set Device ID.
@@ -2963,7 +3003,7 @@ uint8_t MPU6050::GetDeviceID()
  */
 void MPU6050::SetDeviceID(uint8_t id)
 {
-    I2Cdev::WriteBits(_devAddr, MPU6050_RA_WHO_AM_I, MPU6050_WHO_AM_I_BIT, MPU6050_WHO_AM_I_LENGTH, id);
+    _bus->WriteBits(_devAddr, MPU6050_RA_WHO_AM_I, MPU6050_WHO_AM_I_BIT, MPU6050_WHO_AM_I_LENGTH, id);
 }
 
 // ======== UNDOCUMENTED/DMP REGISTERS/METHODS ========
@@ -2972,206 +3012,206 @@ void MPU6050::SetDeviceID(uint8_t id)
 
 uint8_t MPU6050::GetOTPBankValid()
 {
-    I2Cdev::ReadBit(_devAddr, MPU6050_RA_XG_OFFS_TC, MPU6050_TC_OTP_BNK_VLD_BIT, _buffer);
+    _bus->ReadBit(_devAddr, MPU6050_RA_XG_OFFS_TC, MPU6050_TC_OTP_BNK_VLD_BIT, _buffer);
     return _buffer[0];
 }
 void MPU6050::SetOTPBankValid(bool enabled)
 {
-    I2Cdev::WriteBit(_devAddr, MPU6050_RA_XG_OFFS_TC, MPU6050_TC_OTP_BNK_VLD_BIT, enabled);
+    _bus->WriteBit(_devAddr, MPU6050_RA_XG_OFFS_TC, MPU6050_TC_OTP_BNK_VLD_BIT, enabled);
 }
 int8_t MPU6050::GetXGyroOffsetTC()
 {
-    I2Cdev::ReadBits(_devAddr, MPU6050_RA_XG_OFFS_TC, MPU6050_TC_OFFSET_BIT, MPU6050_TC_OFFSET_LENGTH, _buffer);
+    _bus->ReadBits(_devAddr, MPU6050_RA_XG_OFFS_TC, MPU6050_TC_OFFSET_BIT, MPU6050_TC_OFFSET_LENGTH, _buffer);
     return _buffer[0];
 }
 void MPU6050::SetXGyroOffsetTC(int8_t offset)
 {
-    I2Cdev::WriteBits(_devAddr, MPU6050_RA_XG_OFFS_TC, MPU6050_TC_OFFSET_BIT, MPU6050_TC_OFFSET_LENGTH, offset);
+    _bus->WriteBits(_devAddr, MPU6050_RA_XG_OFFS_TC, MPU6050_TC_OFFSET_BIT, MPU6050_TC_OFFSET_LENGTH, offset);
 }
 
 // YG_OFFS_TC register
 
 int8_t MPU6050::GetYGyroOffsetTC()
 {
-    I2Cdev::ReadBits(_devAddr, MPU6050_RA_YG_OFFS_TC, MPU6050_TC_OFFSET_BIT, MPU6050_TC_OFFSET_LENGTH, _buffer);
+    _bus->ReadBits(_devAddr, MPU6050_RA_YG_OFFS_TC, MPU6050_TC_OFFSET_BIT, MPU6050_TC_OFFSET_LENGTH, _buffer);
     return _buffer[0];
 }
 void MPU6050::SetYGyroOffsetTC(int8_t offset)
 {
-    I2Cdev::WriteBits(_devAddr, MPU6050_RA_YG_OFFS_TC, MPU6050_TC_OFFSET_BIT, MPU6050_TC_OFFSET_LENGTH, offset);
+    _bus->WriteBits(_devAddr, MPU6050_RA_YG_OFFS_TC, MPU6050_TC_OFFSET_BIT, MPU6050_TC_OFFSET_LENGTH, offset);
 }
 
 // ZG_OFFS_TC register
 
 int8_t MPU6050::GetZGyroOffsetTC()
 {
-    I2Cdev::ReadBits(_devAddr, MPU6050_RA_ZG_OFFS_TC, MPU6050_TC_OFFSET_BIT, MPU6050_TC_OFFSET_LENGTH, _buffer);
+    _bus->ReadBits(_devAddr, MPU6050_RA_ZG_OFFS_TC, MPU6050_TC_OFFSET_BIT, MPU6050_TC_OFFSET_LENGTH, _buffer);
     return _buffer[0];
 }
 void MPU6050::SetZGyroOffsetTC(int8_t offset)
 {
-    I2Cdev::WriteBits(_devAddr, MPU6050_RA_ZG_OFFS_TC, MPU6050_TC_OFFSET_BIT, MPU6050_TC_OFFSET_LENGTH, offset);
+    _bus->WriteBits(_devAddr, MPU6050_RA_ZG_OFFS_TC, MPU6050_TC_OFFSET_BIT, MPU6050_TC_OFFSET_LENGTH, offset);
 }
 
 // X_FINE_GAIN register
 
 int8_t MPU6050::GetXFineGain()
 {
-    I2Cdev::ReadByte(_devAddr, MPU6050_RA_X_FINE_GAIN, _buffer);
+    _bus->ReadByte(_devAddr, MPU6050_RA_X_FINE_GAIN, _buffer);
     return _buffer[0];
 }
 void MPU6050::SetXFineGain(int8_t gain)
 {
-    I2Cdev::WriteByte(_devAddr, MPU6050_RA_X_FINE_GAIN, gain);
+    _bus->WriteByte(_devAddr, MPU6050_RA_X_FINE_GAIN, gain);
 }
 
 // Y_FINE_GAIN register
 
 int8_t MPU6050::GetYFineGain()
 {
-    I2Cdev::ReadByte(_devAddr, MPU6050_RA_Y_FINE_GAIN, _buffer);
+    _bus->ReadByte(_devAddr, MPU6050_RA_Y_FINE_GAIN, _buffer);
     return _buffer[0];
 }
 void MPU6050::SetYFineGain(int8_t gain)
 {
-    I2Cdev::WriteByte(_devAddr, MPU6050_RA_Y_FINE_GAIN, gain);
+    _bus->WriteByte(_devAddr, MPU6050_RA_Y_FINE_GAIN, gain);
 }
 
 // Z_FINE_GAIN register
 
 int8_t MPU6050::GetZFineGain()
 {
-    I2Cdev::ReadByte(_devAddr, MPU6050_RA_Z_FINE_GAIN, _buffer);
+    _bus->ReadByte(_devAddr, MPU6050_RA_Z_FINE_GAIN, _buffer);
     return _buffer[0];
 }
 void MPU6050::SetZFineGain(int8_t gain)
 {
-    I2Cdev::WriteByte(_devAddr, MPU6050_RA_Z_FINE_GAIN, gain);
+    _bus->WriteByte(_devAddr, MPU6050_RA_Z_FINE_GAIN, gain);
 }
 
 // XA_OFFS_* registers
 
 int16_t MPU6050::GetXAccelOffset()
 {
-    I2Cdev::ReadBytes(_devAddr, MPU6050_RA_XA_OFFS_H, 2, _buffer);
+    _bus->ReadBytes(_devAddr, MPU6050_RA_XA_OFFS_H, 2, _buffer);
     return (((int16_t)_buffer[0]) << 8) | _buffer[1];
 }
 void MPU6050::SetXAccelOffset(int16_t offset)
 {
-    I2Cdev::WriteWord(_devAddr, MPU6050_RA_XA_OFFS_H, offset);
+    _bus->WriteWord(_devAddr, MPU6050_RA_XA_OFFS_H, offset);
 }
 
 // YA_OFFS_* register
 
 int16_t MPU6050::GetYAccelOffset()
 {
-    I2Cdev::ReadBytes(_devAddr, MPU6050_RA_YA_OFFS_H, 2, _buffer);
+    _bus->ReadBytes(_devAddr, MPU6050_RA_YA_OFFS_H, 2, _buffer);
     return (((int16_t)_buffer[0]) << 8) | _buffer[1];
 }
 void MPU6050::SetYAccelOffset(int16_t offset)
 {
-    I2Cdev::WriteWord(_devAddr, MPU6050_RA_YA_OFFS_H, offset);
+    _bus->WriteWord(_devAddr, MPU6050_RA_YA_OFFS_H, offset);
 }
 
 // ZA_OFFS_* register
 
 int16_t MPU6050::GetZAccelOffset()
 {
-    I2Cdev::ReadBytes(_devAddr, MPU6050_RA_ZA_OFFS_H, 2, _buffer);
+    _bus->ReadBytes(_devAddr, MPU6050_RA_ZA_OFFS_H, 2, _buffer);
     return (((int16_t)_buffer[0]) << 8) | _buffer[1];
 }
 void MPU6050::SetZAccelOffset(int16_t offset)
 {
-    I2Cdev::WriteWord(_devAddr, MPU6050_RA_ZA_OFFS_H, offset);
+    _bus->WriteWord(_devAddr, MPU6050_RA_ZA_OFFS_H, offset);
 }
 
 // XG_OFFS_USR* registers
 
 int16_t MPU6050::GetXGyroOffset()
 {
-    I2Cdev::ReadBytes(_devAddr, MPU6050_RA_XG_OFFS_USRH, 2, _buffer);
+    _bus->ReadBytes(_devAddr, MPU6050_RA_XG_OFFS_USRH, 2, _buffer);
     return (((int16_t)_buffer[0]) << 8) | _buffer[1];
 }
 void MPU6050::SetXGyroOffset(int16_t offset)
 {
-    I2Cdev::WriteWord(_devAddr, MPU6050_RA_XG_OFFS_USRH, offset);
+    _bus->WriteWord(_devAddr, MPU6050_RA_XG_OFFS_USRH, offset);
 }
 
 // YG_OFFS_USR* register
 
 int16_t MPU6050::GetYGyroOffset()
 {
-    I2Cdev::ReadBytes(_devAddr, MPU6050_RA_YG_OFFS_USRH, 2, _buffer);
+    _bus->ReadBytes(_devAddr, MPU6050_RA_YG_OFFS_USRH, 2, _buffer);
     return (((int16_t)_buffer[0]) << 8) | _buffer[1];
 }
 void MPU6050::SetYGyroOffset(int16_t offset)
 {
-    I2Cdev::WriteWord(_devAddr, MPU6050_RA_YG_OFFS_USRH, offset);
+    _bus->WriteWord(_devAddr, MPU6050_RA_YG_OFFS_USRH, offset);
 }
 
 // ZG_OFFS_USR* register
 
 int16_t MPU6050::GetZGyroOffset()
 {
-    I2Cdev::ReadBytes(_devAddr, MPU6050_RA_ZG_OFFS_USRH, 2, _buffer);
+    _bus->ReadBytes(_devAddr, MPU6050_RA_ZG_OFFS_USRH, 2, _buffer);
     return (((int16_t)_buffer[0]) << 8) | _buffer[1];
 }
 void MPU6050::SetZGyroOffset(int16_t offset)
 {
-    I2Cdev::WriteWord(_devAddr, MPU6050_RA_ZG_OFFS_USRH, offset);
+    _bus->WriteWord(_devAddr, MPU6050_RA_ZG_OFFS_USRH, offset);
 }
 
 // INT_ENABLE register (DMP functions)
 
 bool MPU6050::GetIntPLLReadyEnabled()
 {
-    I2Cdev::ReadBit(_devAddr, MPU6050_RA_INT_ENABLE, MPU6050_INTERRUPT_PLL_RDY_INT_BIT, _buffer);
+    _bus->ReadBit(_devAddr, MPU6050_RA_INT_ENABLE, MPU6050_INTERRUPT_PLL_RDY_INT_BIT, _buffer);
     return _buffer[0];
 }
 void MPU6050::SetIntPLLReadyEnabled(bool enabled)
 {
-    I2Cdev::WriteBit(_devAddr, MPU6050_RA_INT_ENABLE, MPU6050_INTERRUPT_PLL_RDY_INT_BIT, enabled);
+    _bus->WriteBit(_devAddr, MPU6050_RA_INT_ENABLE, MPU6050_INTERRUPT_PLL_RDY_INT_BIT, enabled);
 }
 bool MPU6050::GetIntDMPEnabled()
 {
-    I2Cdev::ReadBit(_devAddr, MPU6050_RA_INT_ENABLE, MPU6050_INTERRUPT_DMP_INT_BIT, _buffer);
+    _bus->ReadBit(_devAddr, MPU6050_RA_INT_ENABLE, MPU6050_INTERRUPT_DMP_INT_BIT, _buffer);
     return _buffer[0];
 }
 void MPU6050::SetIntDMPEnabled(bool enabled)
 {
-    I2Cdev::WriteBit(_devAddr, MPU6050_RA_INT_ENABLE, MPU6050_INTERRUPT_DMP_INT_BIT, enabled);
+    _bus->WriteBit(_devAddr, MPU6050_RA_INT_ENABLE, MPU6050_INTERRUPT_DMP_INT_BIT, enabled);
 }
 
 // DMP_INT_STATUS
 
 bool MPU6050::GetDMPInt5Status()
 {
-    I2Cdev::ReadBit(_devAddr, MPU6050_RA_DMP_INT_STATUS, MPU6050_DMPINT_5_BIT, _buffer);
+    _bus->ReadBit(_devAddr, MPU6050_RA_DMP_INT_STATUS, MPU6050_DMPINT_5_BIT, _buffer);
     return _buffer[0];
 }
 bool MPU6050::GetDMPInt4Status()
 {
-    I2Cdev::ReadBit(_devAddr, MPU6050_RA_DMP_INT_STATUS, MPU6050_DMPINT_4_BIT, _buffer);
+    _bus->ReadBit(_devAddr, MPU6050_RA_DMP_INT_STATUS, MPU6050_DMPINT_4_BIT, _buffer);
     return _buffer[0];
 }
 bool MPU6050::GetDMPInt3Status()
 {
-    I2Cdev::ReadBit(_devAddr, MPU6050_RA_DMP_INT_STATUS, MPU6050_DMPINT_3_BIT, _buffer);
+    _bus->ReadBit(_devAddr, MPU6050_RA_DMP_INT_STATUS, MPU6050_DMPINT_3_BIT, _buffer);
     return _buffer[0];
 }
 bool MPU6050::GetDMPInt2Status()
 {
-    I2Cdev::ReadBit(_devAddr, MPU6050_RA_DMP_INT_STATUS, MPU6050_DMPINT_2_BIT, _buffer);
+    _bus->ReadBit(_devAddr, MPU6050_RA_DMP_INT_STATUS, MPU6050_DMPINT_2_BIT, _buffer);
     return _buffer[0];
 }
 bool MPU6050::GetDMPInt1Status()
 {
-    I2Cdev::ReadBit(_devAddr, MPU6050_RA_DMP_INT_STATUS, MPU6050_DMPINT_1_BIT, _buffer);
+    _bus->ReadBit(_devAddr, MPU6050_RA_DMP_INT_STATUS, MPU6050_DMPINT_1_BIT, _buffer);
     return _buffer[0];
 }
 bool MPU6050::GetDMPInt0Status()
 {
-    I2Cdev::ReadBit(_devAddr, MPU6050_RA_DMP_INT_STATUS, MPU6050_DMPINT_0_BIT, _buffer);
+    _bus->ReadBit(_devAddr, MPU6050_RA_DMP_INT_STATUS, MPU6050_DMPINT_0_BIT, _buffer);
     return _buffer[0];
 }
 
@@ -3179,12 +3219,12 @@ bool MPU6050::GetDMPInt0Status()
 
 bool MPU6050::GetIntPLLReadyStatus()
 {
-    I2Cdev::ReadBit(_devAddr, MPU6050_RA_INT_STATUS, MPU6050_INTERRUPT_PLL_RDY_INT_BIT, _buffer);
+    _bus->ReadBit(_devAddr, MPU6050_RA_INT_STATUS, MPU6050_INTERRUPT_PLL_RDY_INT_BIT, _buffer);
     return _buffer[0];
 }
 bool MPU6050::GetIntDMPStatus()
 {
-    I2Cdev::ReadBit(_devAddr, MPU6050_RA_INT_STATUS, MPU6050_INTERRUPT_DMP_INT_BIT, _buffer);
+    _bus->ReadBit(_devAddr, MPU6050_RA_INT_STATUS, MPU6050_INTERRUPT_DMP_INT_BIT, _buffer);
     return _buffer[0];
 }
 
@@ -3192,16 +3232,16 @@ bool MPU6050::GetIntDMPStatus()
 
 bool MPU6050::GetDMPEnabled()
 {
-    I2Cdev::ReadBit(_devAddr, MPU6050_RA_USER_CTRL, MPU6050_USERCTRL_DMP_EN_BIT, _buffer);
+    _bus->ReadBit(_devAddr, MPU6050_RA_USER_CTRL, MPU6050_USERCTRL_DMP_EN_BIT, _buffer);
     return _buffer[0];
 }
 void MPU6050::SetDMPEnabled(bool enabled)
 {
-    I2Cdev::WriteBit(_devAddr, MPU6050_RA_USER_CTRL, MPU6050_USERCTRL_DMP_EN_BIT, enabled);
+    _bus->WriteBit(_devAddr, MPU6050_RA_USER_CTRL, MPU6050_USERCTRL_DMP_EN_BIT, enabled);
 }
 void MPU6050::ResetDMP()
 {
-    I2Cdev::WriteBit(_devAddr, MPU6050_RA_USER_CTRL, MPU6050_USERCTRL_DMP_RESET_BIT, true);
+    _bus->WriteBit(_devAddr, MPU6050_RA_USER_CTRL, MPU6050_USERCTRL_DMP_RESET_BIT, true);
 }
 
 // BANK_SEL register
@@ -3217,26 +3257,26 @@ void MPU6050::SetMemoryBank(uint8_t bank, bool prefetchEnabled, bool userBank)
     {
         bank |= 0x40;
     }
-    I2Cdev::WriteByte(_devAddr, MPU6050_RA_BANK_SEL, bank);
+    _bus->WriteByte(_devAddr, MPU6050_RA_BANK_SEL, bank);
 }
 
 // MEM_START_ADDR register
 
 void MPU6050::SetMemoryStartAddress(uint8_t address)
 {
-    I2Cdev::WriteByte(_devAddr, MPU6050_RA_MEM_START_ADDR, address);
+    _bus->WriteByte(_devAddr, MPU6050_RA_MEM_START_ADDR, address);
 }
 
 // MEM_R_W register
 
 uint8_t MPU6050::ReadMemoryByte()
 {
-    I2Cdev::ReadByte(_devAddr, MPU6050_RA_MEM_R_W, _buffer);
+    _bus->ReadByte(_devAddr, MPU6050_RA_MEM_R_W, _buffer);
     return _buffer[0];
 }
 void MPU6050::WriteMemoryByte(uint8_t data)
 {
-    I2Cdev::WriteByte(_devAddr, MPU6050_RA_MEM_R_W, data);
+    _bus->WriteByte(_devAddr, MPU6050_RA_MEM_R_W, data);
 }
 void MPU6050::ReadMemoryBlock(uint8_t *data, uint16_t dataSize, uint8_t bank, uint8_t address)
 {
@@ -3261,7 +3301,7 @@ void MPU6050::ReadMemoryBlock(uint8_t *data, uint16_t dataSize, uint8_t bank, ui
         }
 
         // read the chunk of data as specified
-        I2Cdev::ReadBytes(_devAddr, MPU6050_RA_MEM_R_W, chunkSize, data + i);
+        _bus->ReadBytes(_devAddr, MPU6050_RA_MEM_R_W, chunkSize, data + i);
 
         // increase byte index by [chunkSize]
         i += chunkSize;
@@ -3281,3 +3321,102 @@ void MPU6050::ReadMemoryBlock(uint8_t *data, uint16_t dataSize, uint8_t bank, ui
         }
     }
 }
+/** Write a block of data to the DMP memory.
+ * The block is written in chunks that never cross a memory bank boundary. The
+ * Raspberry Pi has no separate program memory, so useProgMem has no effect.
+ * @param data Block to write
+ * @param dataSize Size of the block, which may span several banks
+ * @param bank First memory bank
+ * @param address Start address in the first bank
+ * @param verify Read back each chunk and compare it to the data
+ * @return True if every chunk was written (and verified)
+ */
+bool MPU6050::WriteMemoryBlock(const uint8_t *data, uint16_t dataSize, uint8_t bank, uint8_t address, bool verify, bool useProgMem)
+{
+    SetMemoryBank(bank);
+    SetMemoryStartAddress(address);
+    uint8_t chunkSize;
+    uint8_t chunk[MPU6050_DMP_MEMORY_CHUNK_SIZE];
+    uint8_t verifyChunk[MPU6050_DMP_MEMORY_CHUNK_SIZE];
+    for (uint16_t i = 0; i < dataSize;)
+    {
+        // determine correct chunk size according to bank position and data size
+        chunkSize = MPU6050_DMP_MEMORY_CHUNK_SIZE;
+
+        // make sure we don't go past the data size
+        if (i + chunkSize > dataSize)
+        {
+            chunkSize = dataSize - i;
+        }
+
+        // make sure this chunk doesn't go past the bank boundary (256 bytes)
+        if (chunkSize > 256 - address)
+        {
+            chunkSize = 256 - address;
+        }
+
+        // write the chunk of data as specified
+        memcpy(chunk, data + i, chunkSize);
+        if (!_bus->WriteBytes(_devAddr, MPU6050_RA_MEM_R_W, chunkSize, chunk))
+        {
+            return false;
+        }
+
+        // verify data if needed
+        if (verify)
+        {
+            SetMemoryBank(bank);
+            SetMemoryStartAddress(address);
+            if (!_bus->ReadBytes(_devAddr, MPU6050_RA_MEM_R_W, chunkSize, verifyChunk) || memcmp(chunk, verifyChunk, chunkSize) != 0)
+            {
+                return false;
+            }
+        }
+
+        // increase byte index by [chunkSize]
+        i += chunkSize;
+
+        // uint8_t automatically wraps to 0 at 256
+        address += chunkSize;
+
+        // if we aren't done, update bank (if necessary) and address
+        if (i < dataSize)
+        {
+            if (address == 0)
+            {
+                bank++;
+            }
+            SetMemoryBank(bank);
+            SetMemoryStartAddress(address);
+        }
+    }
+    return true;
+}
+bool MPU6050::WriteProgMemoryBlock(const uint8_t *data, uint16_t dataSize, uint8_t bank, uint8_t address, bool verify)
+{
+    return WriteMemoryBlock(data, dataSize, bank, address, verify, true);
+}
+
+// DMP_CFG_1 register
+
+uint8_t MPU6050::GetDMPConfig1()
+{
+    _bus->ReadByte(_devAddr, MPU6050_RA_DMP_CFG_1, _buffer);
+    return _buffer[0];
+}
+void MPU6050::SetDMPConfig1(uint8_t config)
+{
+    _bus->WriteByte(_devAddr, MPU6050_RA_DMP_CFG_1, config);
+}
+
+// DMP_CFG_2 register
+
+uint8_t MPU6050::GetDMPConfig2()
+{
+    _bus->ReadByte(_devAddr, MPU6050_RA_DMP_CFG_2, _buffer);
+    return _buffer[0];
+}
+void MPU6050::SetDMPConfig2(uint8_t config)
+{
+    _bus->WriteByte(_devAddr, MPU6050_RA_DMP_CFG_2, config);
+}
@@ -399,7 +399,8 @@ class MPU6050
 {
   public:
     MPU6050();
-    MPU6050(uint8_t address);
+    MPU6050(uint8_t address, I2cBusId busId = sensorBus);
+    MPU6050(uint8_t address, I2Cdev *bus);
 
     void Initialize();
     bool TestConnection();
@@ -669,7 +670,7 @@ class MPU6050
     // FIFO_R_W register
     uint8_t GetFIFOByte();
     void SetFIFOByte(uint8_t data);
-    void GetFIFOBytes(uint8_t *data, uint8_t length);
+    bool GetFIFOBytes(uint8_t *data, uint8_t length);
 
     // WHO_AM_I register
     uint8_t GetDeviceID();
@@ -775,6 +776,9 @@ class MPU6050
     void SetDMPConfig2(uint8_t config);
 
   private:
+    void SetCacheableRegisters();
+
+    I2Cdev *_bus;
     uint8_t _devAddr;
     uint8_t _buffer[14];
 };
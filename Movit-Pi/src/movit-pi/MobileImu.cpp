@@ -7,4 +7,5 @@ MobileImu::MobileImu()
 {
     _imuName = MOBILE_IMU_NAME;
     _imu = {0x69};
+    _interruptLine = MOBILE_IMU_INTERRUPT_LINE;
 }
@@ -43,6 +43,8 @@ const char *IS_MOVING_TOPIC = "data/is_moving";
 const char *TILT_INFO_TOPIC = "data/tilt_info";
 
 const char *SENSORS_STATUS_TOPIC = "status/sensors";
+const char *BUS_STATUS_TOPIC = "status/bus";
+const char *IMU_CALIBRATION_STATUS_TOPIC = "status/calib_imu";
 
 const char *EXCEPTION_MESSAGE = "Exception thrown by %s()\n";
 
@@ -261,7 +263,7 @@ void MosquittoBroker::SendPressureMatData(const pressure_mat_data_t data, const
     writer.EndObject();
     writer.Key("quadrants");
     writer.StartArray();
-    for (int i = 0; i < 4; i++)
+    for (size_t i = 0; i < data.quadrantPressure.size(); i++)
     {
         writer.StartObject();
         writer.Key("x");
@@ -271,6 +273,13 @@ void MosquittoBroker::SendPressureMatData(const pressure_mat_data_t data, const
         writer.EndObject();
     }
     writer.EndArray();
+    writer.Key("loads");
+    writer.StartArray();
+    for (float load : data.quadrantLoad)
+    {
+        writer.Double(load);
+    }
+    writer.EndArray();
 
     writer.EndObject();
 
@@ -309,6 +318,44 @@ void MosquittoBroker::SendIsIMUCalib(const bool state, const std::string datetim
     PublishMessage(CALIB_IMU_TOPIC, strMsg);
 }
 
+void MosquittoBroker::SendImuCalibrationProgress(const std::string imuName, const imu_calibration_progress_t progress, const char *stateName, const std::string datetime)
+{
+    StringBuffer strBuff;
+    Writer<StringBuffer> writer(strBuff);
+    writer.StartObject();
+
+    writer.Key("imu");
+    writer.String(imuName.c_str());
+    writer.Key("state");
+    writer.String(stateName);
+    writer.Key("pass");
+    writer.Uint(progress.pass);
+    writer.Key("maxPasses");
+    writer.Uint(progress.maxPasses);
+    writer.Key("passProgress");
+    writer.Uint(progress.passProgress);
+    writer.Key("accelerometerErrors");
+    writer.StartArray();
+    for (uint8_t axis = 0; axis < NUMBER_OF_AXIS; axis++)
+    {
+        writer.Int(progress.accelerometerErrors[axis]);
+    }
+    writer.EndArray();
+    writer.Key("gyroscopeErrors");
+    writer.StartArray();
+    for (uint8_t axis = 0; axis < NUMBER_OF_AXIS; axis++)
+    {
+        writer.Int(progress.gyroscopeErrors[axis]);
+    }
+    writer.EndArray();
+    writer.Key("datetime");
+    writer.String(datetime.c_str());
+
+    writer.EndObject();
+
+    PublishMessage(IMU_CALIBRATION_STATUS_TOPIC, strBuff.GetString());
+}
+
 void MosquittoBroker::SendSpeed(const float speed, const std::string datetime)
 {
     std::string strSpeed = std::to_string(speed);
@@ -317,12 +364,34 @@ void MosquittoBroker::SendSpeed(const float speed, const std::string datetime)
     PublishMessage(CURRENT_CHAIR_SPEED_TOPIC, strMsg);
 }
 
-void MosquittoBroker::SendVibration(double acceleration, const std::string datetime)
+void MosquittoBroker::SendVibration(const vibration_summary_t &summary, const std::string datetime)
 {
-    std::string strAcceleration = std::to_string(acceleration);
-    std::string strMsg = "{\"datetime\":" + datetime + ",\"vibration\":" + strAcceleration + "}";
+    StringBuffer strBuff;
+    Writer<StringBuffer> writer(strBuff);
+    writer.SetMaxDecimalPlaces(3);
+    writer.StartObject();
 
-    PublishMessage(VIBRATION_TOPIC, strMsg);
+    writer.Key("sampleRate");
+    writer.Uint(summary.sampleRate);
+    writer.Key("rms");
+    writer.Double(summary.rms);
+    writer.Key("peak");
+    writer.Double(summary.peak);
+    writer.Key("dominantFrequency");
+    writer.Double(summary.dominantFrequency);
+    writer.Key("bands");
+    writer.StartArray();
+    for (uint8_t band = 0; band < summary.bandCount; band++)
+    {
+        writer.Double(summary.bands[band]);
+    }
+    writer.EndArray();
+    writer.Key("datetime");
+    writer.String(datetime.c_str());
+
+    writer.EndObject();
+
+    PublishMessage(VIBRATION_TOPIC, strBuff.GetString());
 }
 
 void MosquittoBroker::SendIsMoving(const bool state, const std::string datetime)
@@ -370,6 +439,50 @@ void MosquittoBroker::SendSensorsState(sensor_state_t sensorState, const std::st
     PublishMessage(SENSORS_STATUS_TOPIC, strBuff.GetString());
 }
 
+void MosquittoBroker::SendBusStatistics(const std::vector<bus_statistics_t> &statistics, const std::string datetime)
+{
+    StringBuffer strBuff;
+    Writer<StringBuffer> writer(strBuff);
+    writer.StartObject();
+
+    writer.Key("devices");
+    writer.StartArray();
+    for (const bus_statistics_t &device : statistics)
+    {
+        writer.StartObject();
+        writer.Key("bus");
+        writer.String(BusStatistics::GetChannelName(device.channel).c_str());
+        writer.Key("address");
+        writer.Uint(device.address);
+        writer.Key("operation");
+        writer.String(BusStatistics::GetOperationName(device.operation).c_str());
+        writer.Key("count");
+        writer.Uint(device.count);
+        writer.Key("errors");
+        writer.Uint(device.errors);
+        writer.Key("averageUs");
+        writer.Uint(device.averageMicroseconds);
+        writer.Key("maxUs");
+        writer.Uint(device.maxMicroseconds);
+        writer.Key("histogram");
+        writer.StartArray();
+        for (uint8_t bucket = 0; bucket < BUS_LATENCY_BUCKETS; bucket++)
+        {
+            writer.Uint(device.buckets[bucket]);
+        }
+        writer.EndArray();
+        writer.EndObject();
+    }
+    writer.EndArray();
+
+    writer.Key("datetime");
+    writer.String(datetime.c_str());
+
+    writer.EndObject();
+
+    PublishMessage(BUS_STATUS_TOPIC, strBuff.GetString());
+}
+
 bool MosquittoBroker::GetSetAlarmOn()
 {
     _setAlarmOnNew = false;
@@ -4,8 +4,11 @@
 #include "mosquittopp.h"
 #include "Utils.h"
 #include "DataType.h"
+#include "BusStatistics.h"
+#include "VibrationAnalyzer.h"
 #include <stdint.h>
 #include <string>
+#include <vector>
 
 class MosquittoBroker : public mosqpp::mosquittopp
 {
@@ -23,13 +26,15 @@ class MosquittoBroker : public mosqpp::mosquittopp
     void SendIsSomeoneThere(const bool state, const std::string datetime);
     void SendIsPressureMatCalib(const bool state, const std::string datetime);
     void SendIsIMUCalib(const bool state, const std::string datetime);
+    void SendImuCalibrationProgress(const std::string imuName, const imu_calibration_progress_t progress, const char *stateName, const std::string datetime);
     void SendSpeed(const float speed, const std::string datetime);
     void SendHeartbeat(const std::string datetime);
-    void SendVibration(double acceleration, const std::string datetime);
+    void SendVibration(const vibration_summary_t &summary, const std::string datetime);
     void SendIsMoving(const bool state, const std::string datetime);
     void SendTiltInfo(const int info, const std::string datetime);
 
     void SendSensorsState(sensor_state_t sensorState, const std::string datetime);
+    void SendBusStatistics(const std::vector<bus_statistics_t> &statistics, const std::string datetime);
     void SendIsWifiConnected(const bool state, const std::string datetime);
 
     bool GetSetAlarmOn();
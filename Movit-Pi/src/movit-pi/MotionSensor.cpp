@@ -3,14 +3,10 @@
 #include "Utils.h"
 #include "SysTime.h"
 
-#define MOVING_AVG_WINDOW_SIZE 10
-
 const char *FAIL_MESSAGE = "FAIL \n";
 const char *SUCCESS_MESSAGE = "SUCCESS \n";
 
-MotionSensor::MotionSensor() : _rangeAverage(MOVING_AVG_WINDOW_SIZE),
-                               _deltaXAverage(MOVING_AVG_WINDOW_SIZE),
-                               _deltaYAverage(MOVING_AVG_WINDOW_SIZE)
+MotionSensor::MotionSensor()
 {
     _timer.Reset();
 }
@@ -30,7 +26,7 @@ bool MotionSensor::Initialize()
 
 bool MotionSensor::IsConnected()
 {
-    return _rangeSensor.Initialize(false) && _opticalFLowSensor.Initialize();
+    return _rangeSensor.IsConnected() && _opticalFLowSensor.IsConnected();
 }
 
 bool MotionSensor::InitializeRangeSensor()
@@ -80,7 +76,7 @@ void MotionSensor::ReadRangeSensor()
     uint16_t range = _rangeSensor.ReadRangeSingleMillimeters();
     if (range != 8190)
     {
-        _rangeAverage.AddSample(range);
+        _rangeAverage.Push(range);
     }
 }
 
@@ -90,16 +86,16 @@ void MotionSensor::ReadFlowSensor()
     int16_t deltaY = 0;
     _opticalFLowSensor.ReadMotionCount(&deltaX, &deltaY);
 
-    _deltaXAverage.AddSample(deltaX);
-    _deltaYAverage.AddSample(deltaY);
+    _deltaXAverage.Push(deltaX);
+    _deltaYAverage.Push(deltaY);
 
     UpdateTravel();
 }
 
 void MotionSensor::UpdateTravel()
 {
-    int16_t deltaX = _deltaXAverage.GetAverage();
-    int16_t deltaY = _deltaYAverage.GetAverage();
+    int16_t deltaX = _deltaXAverage.Get<1>().GetValue();
+    int16_t deltaY = _deltaYAverage.Get<1>().GetValue();
     double travelInPixels = sqrt(static_cast<double>(((deltaX * deltaX) + (deltaY * deltaY))));
     uint16_t travelInMillimeter = PixelsToMillimeter(travelInPixels);
     _isMovingTravel += travelInMillimeter;
@@ -111,7 +107,7 @@ double MotionSensor::GetAverageRange()
     {
         printf("ERROR: Timeout occurred in range sensor \n");
     }
-    return _rangeAverage.GetAverage();
+    return _rangeAverage.Get<1>().GetValue();
 }
 
 bool MotionSensor::IsMoving()
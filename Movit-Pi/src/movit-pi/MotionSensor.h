@@ -6,13 +6,15 @@
 #include <stdio.h>
 #include <thread>
 
-#include "MovingAverage.h"
+#include "Pipeline.h"
 #include "PMW3901.h"
 #include "VL53L0X.h"
 #include "Utils.h"
 #include "Timer.h"
 #include "Sensor.h"
 
+#define MOVING_AVG_WINDOW_SIZE 10
+
 class MotionSensor: public Sensor
 {
   public:
@@ -52,9 +54,11 @@ class MotionSensor: public Sensor
     PMW3901 _opticalFLowSensor; // Optical Flow Sensor
     VL53L0X _rangeSensor;       // Range Sensor
     uint16_t _isMovingTravel = 0;
-    MovingAverage<uint16_t> _rangeAverage;
-    MovingAverage<int16_t> _deltaXAverage;
-    MovingAverage<int16_t> _deltaYAverage;
+    // Averaged at the rate of the sensors, read at the rate of the main loop
+    typedef Pipeline<Average<MOVING_AVG_WINDOW_SIZE>, Hold> AveragePipeline;
+    AveragePipeline _rangeAverage;
+    AveragePipeline _deltaXAverage;
+    AveragePipeline _deltaYAverage;
 
     Timer _timer;
     bool _lastState = false;
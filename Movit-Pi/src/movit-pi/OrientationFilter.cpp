@@ -0,0 +1,277 @@
+#include "OrientationFilter.h"
+#include "Utils.h"
+
+#include <chrono>
+#include <math.h>
+#include <stdio.h>
+
+#define COMPLEMENTARY_TIME_CONSTANT 0.5f // Seconds for the accelerometer to correct the gyroscope drift
+#define MAHONY_TWO_KP 2.0f               // Twice the proportional gain
+#define MAHONY_TWO_KI 0.02f              // Twice the integral gain
+#define MADGWICK_BETA 0.1f               // Gradient descent gain
+#define BENCHMARK_SAMPLE_COUNT 200000
+#define BENCHMARK_PATTERN_LENGTH 1000
+#define BENCHMARK_SAMPLE_RATE 200 // Hz
+
+namespace
+{
+const char *ALGORITHM_NAMES[fusionAlgorithmCount] = {"complementary", "mahony", "madgwick"};
+const float DEGREES_TO_RADIANS = static_cast<float>(M_PI / 180.0);
+
+float InverseNorm(float x, float y, float z, float w = 0)
+{
+    return 1.0f / sqrtf(x * x + y * y + z * z + w * w);
+}
+
+void NormalizeQuaternion(float *q)
+{
+    const float inverseNorm = InverseNorm(q[0], q[1], q[2], q[3]);
+    for (uint8_t i = 0; i < 4; i++)
+    {
+        q[i] *= inverseNorm;
+    }
+}
+} // namespace
+
+void OrientationFilter::Update(const float *accelerations, const float *rotations, float period)
+{
+    // No usable direction of gravity while in free fall
+    const float norm = sqrtf(accelerations[0] * accelerations[0] + accelerations[1] * accelerations[1] + accelerations[2] * accelerations[2]);
+    if (norm < 0.01f)
+    {
+        return;
+    }
+
+    const float gravity[3] = {accelerations[0] / norm, accelerations[1] / norm, accelerations[2] / norm};
+    if (!_isInitialized)
+    {
+        Initialize(gravity);
+        _isInitialized = true;
+        return;
+    }
+
+    const float radians[3] = {rotations[0] * DEGREES_TO_RADIANS, rotations[1] * DEGREES_TO_RADIANS, rotations[2] * DEGREES_TO_RADIANS};
+    Integrate(gravity, radians, period);
+}
+
+void OrientationFilter::GetTiltQuaternion(const float *gravity, float *quaternion)
+{
+    // Upside down, any horizontal axis will do
+    if (gravity[2] < -0.9999f)
+    {
+        quaternion[0] = 0;
+        quaternion[1] = 1;
+        quaternion[2] = quaternion[3] = 0;
+        return;
+    }
+
+    quaternion[0] = 1 + gravity[2];
+    quaternion[1] = gravity[1];
+    quaternion[2] = -gravity[0];
+    quaternion[3] = 0;
+    NormalizeQuaternion(quaternion);
+}
+
+std::unique_ptr<OrientationFilter> OrientationFilter::Create(FusionAlgorithm algorithm)
+{
+    switch (algorithm)
+    {
+    case complementaryFusion:
+        return std::unique_ptr<OrientationFilter>(new ComplementaryFilter());
+    case madgwickFusion:
+        return std::unique_ptr<OrientationFilter>(new MadgwickFilter());
+    case mahonyFusion:
+    default:
+        return std::unique_ptr<OrientationFilter>(new MahonyFilter());
+    }
+}
+
+bool OrientationFilter::GetAlgorithm(std::string name, FusionAlgorithm &algorithm)
+{
+    for (uint8_t i = 0; i < fusionAlgorithmCount; i++)
+    {
+        if (name == ALGORITHM_NAMES[i])
+        {
+            algorithm = static_cast<FusionAlgorithm>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+const char *OrientationFilter::GetAlgorithmName(FusionAlgorithm algorithm)
+{
+    return algorithm < fusionAlgorithmCount ? ALGORITHM_NAMES[algorithm] : "unknown";
+}
+
+void OrientationFilter::Benchmark()
+{
+    // Slow recline with some vibration, as the IMUs see it
+    const float period = 1.0f / BENCHMARK_SAMPLE_RATE;
+    static float accelerations[BENCHMARK_PATTERN_LENGTH][3];
+    static float rotations[BENCHMARK_PATTERN_LENGTH][3];
+    for (uint16_t i = 0; i < BENCHMARK_PATTERN_LENGTH; i++)
+    {
+        const float angle = 0.5f * sinf(i * period);
+        accelerations[i][0] = cosf(angle) + 0.05f * sinf(i * 1.3f);
+        accelerations[i][1] = 0.02f * cosf(i * 0.7f);
+        accelerations[i][2] = -sinf(angle);
+        rotations[i][0] = 0.3f * sinf(i * 0.9f);
+        rotations[i][1] = 0.5f * cosf(i * period) / DEGREES_TO_RADIANS;
+        rotations[i][2] = 0.2f * cosf(i * 1.1f);
+    }
+
+    for (uint8_t algorithm = 0; algorithm < fusionAlgorithmCount; algorithm++)
+    {
+        std::unique_ptr<OrientationFilter> filter = Create(static_cast<FusionAlgorithm>(algorithm));
+
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for (uint32_t i = 0; i < BENCHMARK_SAMPLE_COUNT; i++)
+        {
+            filter->Update(accelerations[i % BENCHMARK_PATTERN_LENGTH], rotations[i % BENCHMARK_PATTERN_LENGTH], period);
+        }
+        double elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+        float quaternion[4];
+        filter->GetQuaternion(quaternion);
+
+        // Both IMUs at the benchmark sample rate
+        const double nanosecondsPerSample = elapsed / BENCHMARK_SAMPLE_COUNT;
+        const double load = nanosecondsPerSample * 2 * BENCHMARK_SAMPLE_RATE / 1e9 * 100;
+        printf("%-14s %7.1f ns/sample, %.3f%% of a core for 2 IMUs at %i Hz (w = %.3f)\n",
+               ALGORITHM_NAMES[algorithm], nanosecondsPerSample, load, BENCHMARK_SAMPLE_RATE, quaternion[0]);
+    }
+}
+
+void ComplementaryFilter::Initialize(const float *gravity)
+{
+    for (uint8_t axis = 0; axis < 3; axis++)
+    {
+        _gravity[axis] = gravity[axis];
+    }
+}
+
+void ComplementaryFilter::Integrate(const float *gravity, const float *rotations, float period)
+{
+    // Gravity is fixed, in the IMU axes it turns opposite to the rotation
+    const float *g = _gravity;
+    const float predicted[3] = {
+        g[0] + (g[1] * rotations[2] - g[2] * rotations[1]) * period,
+        g[1] + (g[2] * rotations[0] - g[0] * rotations[2]) * period,
+        g[2] + (g[0] * rotations[1] - g[1] * rotations[0]) * period};
+
+    const float alpha = period / (COMPLEMENTARY_TIME_CONSTANT + period);
+    for (uint8_t axis = 0; axis < 3; axis++)
+    {
+        _gravity[axis] = (1 - alpha) * predicted[axis] + alpha * gravity[axis];
+    }
+
+    const float inverseNorm = InverseNorm(_gravity[0], _gravity[1], _gravity[2]);
+    for (uint8_t axis = 0; axis < 3; axis++)
+    {
+        _gravity[axis] *= inverseNorm;
+    }
+}
+
+void ComplementaryFilter::GetQuaternion(float *quaternion)
+{
+    GetTiltQuaternion(_gravity, quaternion);
+}
+
+void MahonyFilter::Initialize(const float *gravity)
+{
+    GetTiltQuaternion(gravity, _q);
+    _integralError[0] = _integralError[1] = _integralError[2] = 0;
+}
+
+void MahonyFilter::Integrate(const float *gravity, const float *rotations, float period)
+{
+    float *q = _q;
+    float gx = rotations[0], gy = rotations[1], gz = rotations[2];
+
+    // Half of the estimated direction of gravity
+    const float halfVx = q[1] * q[3] - q[0] * q[2];
+    const float halfVy = q[0] * q[1] + q[2] * q[3];
+    const float halfVz = q[0] * q[0] - 0.5f + q[3] * q[3];
+
+    // Error between the measured and estimated directions
+    const float halfEx = gravity[1] * halfVz - gravity[2] * halfVy;
+    const float halfEy = gravity[2] * halfVx - gravity[0] * halfVz;
+    const float halfEz = gravity[0] * halfVy - gravity[1] * halfVx;
+
+    _integralError[0] += MAHONY_TWO_KI * halfEx * period;
+    _integralError[1] += MAHONY_TWO_KI * halfEy * period;
+    _integralError[2] += MAHONY_TWO_KI * halfEz * period;
+    gx += _integralError[0] + MAHONY_TWO_KP * halfEx;
+    gy += _integralError[1] + MAHONY_TWO_KP * halfEy;
+    gz += _integralError[2] + MAHONY_TWO_KP * halfEz;
+
+    gx *= 0.5f * period;
+    gy *= 0.5f * period;
+    gz *= 0.5f * period;
+    const float q0 = q[0], q1 = q[1], q2 = q[2], q3 = q[3];
+    q[0] += -q1 * gx - q2 * gy - q3 * gz;
+    q[1] += q0 * gx + q2 * gz - q3 * gy;
+    q[2] += q0 * gy - q1 * gz + q3 * gx;
+    q[3] += q0 * gz + q1 * gy - q2 * gx;
+    NormalizeQuaternion(q);
+}
+
+void MahonyFilter::GetQuaternion(float *quaternion)
+{
+    for (uint8_t i = 0; i < 4; i++)
+    {
+        quaternion[i] = _q[i];
+    }
+}
+
+void MadgwickFilter::Initialize(const float *gravity)
+{
+    GetTiltQuaternion(gravity, _q);
+}
+
+void MadgwickFilter::Integrate(const float *gravity, const float *rotations, float period)
+{
+    float *q = _q;
+    const float q0 = q[0], q1 = q[1], q2 = q[2], q3 = q[3];
+    const float gx = rotations[0], gy = rotations[1], gz = rotations[2];
+    const float ax = gravity[0], ay = gravity[1], az = gravity[2];
+
+    // Rate of change of the quaternion from the gyroscope
+    float qDot0 = 0.5f * (-q1 * gx - q2 * gy - q3 * gz);
+    float qDot1 = 0.5f * (q0 * gx + q2 * gz - q3 * gy);
+    float qDot2 = 0.5f * (q0 * gy - q1 * gz + q3 * gx);
+    float qDot3 = 0.5f * (q0 * gz + q1 * gy - q2 * gx);
+
+    // Gradient of the error between the measured and estimated gravity
+    const float q0q0 = q0 * q0, q1q1 = q1 * q1, q2q2 = q2 * q2, q3q3 = q3 * q3;
+    float s0 = 4 * q0 * q2q2 + 2 * q2 * ax + 4 * q0 * q1q1 - 2 * q1 * ay;
+    float s1 = 4 * q1 * q3q3 - 2 * q3 * ax + 4 * q0q0 * q1 - 2 * q0 * ay - 4 * q1 + 8 * q1 * q1q1 + 8 * q1 * q2q2 + 4 * q1 * az;
+    float s2 = 4 * q0q0 * q2 + 2 * q0 * ax + 4 * q2 * q3q3 - 2 * q3 * ay - 4 * q2 + 8 * q2 * q1q1 + 8 * q2 * q2q2 + 4 * q2 * az;
+    float s3 = 4 * q1q1 * q3 - 2 * q1 * ax + 4 * q2q2 * q3 - 2 * q2 * ay;
+
+    // At the exact orientation the gradient is null
+    const float norm = s0 * s0 + s1 * s1 + s2 * s2 + s3 * s3;
+    if (norm > 0)
+    {
+        const float inverseNorm = 1.0f / sqrtf(norm);
+        qDot0 -= MADGWICK_BETA * s0 * inverseNorm;
+        qDot1 -= MADGWICK_BETA * s1 * inverseNorm;
+        qDot2 -= MADGWICK_BETA * s2 * inverseNorm;
+        qDot3 -= MADGWICK_BETA * s3 * inverseNorm;
+    }
+
+    q[0] += qDot0 * period;
+    q[1] += qDot1 * period;
+    q[2] += qDot2 * period;
+    q[3] += qDot3 * period;
+    NormalizeQuaternion(q);
+}
+
+void MadgwickFilter::GetQuaternion(float *quaternion)
+{
+    for (uint8_t i = 0; i < 4; i++)
+    {
+        quaternion[i] = _q[i];
+    }
+}
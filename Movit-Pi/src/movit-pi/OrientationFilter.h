@@ -0,0 +1,96 @@
+#ifndef ORIENTATION_FILTER_H
+#define ORIENTATION_FILTER_H
+
+#include <memory>
+#include <string>
+
+enum FusionAlgorithm
+{
+    complementaryFusion = 0,
+    mahonyFusion,
+    madgwickFusion,
+    fusionAlgorithmCount
+};
+
+// Orientation of an IMU estimated from its accelerometer and gyroscope
+// samples. The gyroscope follows the fast movements, the accelerometer
+// corrects the drift. Only the tilt is observable, the yaw stays arbitrary.
+// Computed in float, to run at the full sample rate on the Pi Zero.
+class OrientationFilter
+{
+  public:
+    virtual ~OrientationFilter() = default;
+
+    // Accelerations in g, rotations in degrees per second, period since the
+    // previous sample in seconds. The first sample sets the tilt directly.
+    void Update(const float *accelerations, const float *rotations, float period);
+    // Unit quaternion (w, x, y, z), same convention as the DMP
+    virtual void GetQuaternion(float *quaternion) = 0;
+    void Reset() { _isInitialized = false; }
+
+    static std::unique_ptr<OrientationFilter> Create(FusionAlgorithm algorithm);
+    static bool GetAlgorithm(std::string name, FusionAlgorithm &algorithm);
+    static const char *GetAlgorithmName(FusionAlgorithm algorithm);
+
+    // Prints the cost of one update of each algorithm
+    static void Benchmark();
+
+  protected:
+    // Accelerations normalized, rotations in radians per second
+    virtual void Initialize(const float *gravity) = 0;
+    virtual void Integrate(const float *gravity, const float *rotations, float period) = 0;
+
+    // Smallest rotation bringing the gravity measured in the IMU axes on the z axis
+    static void GetTiltQuaternion(const float *gravity, float *quaternion);
+
+  private:
+    bool _isInitialized = false;
+};
+
+// Gravity direction rotated by the gyroscope, pulled toward the measured one
+// with a time constant
+class ComplementaryFilter : public OrientationFilter
+{
+  public:
+    void GetQuaternion(float *quaternion);
+
+  protected:
+    void Initialize(const float *gravity);
+    void Integrate(const float *gravity, const float *rotations, float period);
+
+  private:
+    float _gravity[3] = {0, 0, 1};
+};
+
+// Quaternion integration with a proportional-integral feedback of the error
+// between the measured and estimated gravity (Mahony et al.)
+class MahonyFilter : public OrientationFilter
+{
+  public:
+    void GetQuaternion(float *quaternion);
+
+  protected:
+    void Initialize(const float *gravity);
+    void Integrate(const float *gravity, const float *rotations, float period);
+
+  private:
+    float _q[4] = {1, 0, 0, 0};
+    float _integralError[3] = {0, 0, 0};
+};
+
+// Quaternion integration corrected by a gradient descent step toward the
+// measured gravity (Madgwick)
+class MadgwickFilter : public OrientationFilter
+{
+  public:
+    void GetQuaternion(float *quaternion);
+
+  protected:
+    void Initialize(const float *gravity);
+    void Integrate(const float *gravity, const float *rotations, float period);
+
+  private:
+    float _q[4] = {1, 0, 0, 0};
+};
+
+#endif // ORIENTATION_FILTER_H
@@ -40,6 +40,9 @@
  *==============================================================================================================*/
 PCA9536::PCA9536()
 {
+    _bus = I2Cdev::GetBus(peripheralBus);
+    // Only the input register is driven by the device
+    _bus->SetCacheable(DEV_ADDR, REG_OUTPUT, 3);
 }
 
 /*==============================================================================================================*
@@ -153,13 +156,30 @@ void PCA9536::Reset()
     SetPolarity(IO_NON_INVERTED);
 }
 
+/*==============================================================================================================*
+    IS CONNECTED: THE CONFIGURATION REGISTER CAN BE READ
+ *==============================================================================================================*/
+bool PCA9536::IsConnected()
+{
+    uint8_t regData;
+    return _bus->ReadByte(DEV_ADDR, REG_CONFIG, &regData);
+}
+
+/*==============================================================================================================*
+    INVALIDATE CACHED REGISTERS (NEXT READS GO TO THE DEVICE)
+ *==============================================================================================================*/
+void PCA9536::InvalidateCache()
+{
+    _bus->InvalidateCache(DEV_ADDR);
+}
+
 /*==============================================================================================================*
     GET REGISTER DATA
  *==============================================================================================================*/
 uint8_t PCA9536::GetReg(reg_ptr_t regPtr)
 {
     uint8_t regData = 0;
-    I2Cdev::ReadByte(DEV_ADDR, regPtr, &regData);
+    _bus->ReadByte(DEV_ADDR, regPtr, &regData);
     return regData;
 }
 
@@ -178,7 +198,7 @@ void PCA9536::SetReg(reg_ptr_t regPtr, uint8_t newSetting)
 {
     if (regPtr > 0)
     {
-        I2Cdev::WriteByte(DEV_ADDR, regPtr, newSetting);
+        _bus->WriteByte(DEV_ADDR, regPtr, newSetting);
     }
 }
 
@@ -120,6 +120,8 @@
 
 #include <stdint.h>
 
+class I2Cdev;
+
 namespace Pca9536
 {
 
@@ -184,12 +186,16 @@ class PCA9536
     void SetPolarity(pin_t pin, polarity_t newPolarity);
     void SetPolarity(polarity_t newPolarity);
     void Reset();
+    void InvalidateCache();
+    bool IsConnected();
 
   private:
     uint8_t GetReg(reg_ptr_t regPtr);
     uint8_t GetPin(pin_t pin, reg_ptr_t regPtr);
     void SetReg(reg_ptr_t ptr, uint8_t newSetting);
     void SetPin(pin_t pin, reg_ptr_t regPtr, uint8_t newSetting);
+
+    I2Cdev *_bus;
 };
 }
 
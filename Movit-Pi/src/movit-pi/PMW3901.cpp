@@ -1,4 +1,5 @@
 #include "PMW3901.h"
+#include "SPIdev.h"
 #include "Utils.h"
 #include "SysTime.h"
 
@@ -14,22 +15,19 @@
 
 PMW3901::~PMW3901()
 {
-  bcm2835_close();
+  SPIdev::Close();
 }
 
 bool PMW3901::Initialize()
 {
   //Set the CS pin
-  bcm2835_gpio_fsel(PIN, BCM2835_GPIO_FSEL_OUTP);
-  SetChipSelect(HIGH);
+  SPIdev::SetupChipSelect(PIN);
 
   // Power on reset
   RegisterWrite(0x3A, 0x5A);
 
-  // Test the SPI communication, checking chipId and inverse chipId
-  uint8_t chipId = RegisterRead(0x00);
-  uint8_t dIpihc = RegisterRead(0x5F);
-  if (chipId != 0x49 || dIpihc != 0xB6)
+  // Test the SPI communication
+  if (!IsConnected())
   {
     return false;
   }
@@ -46,6 +44,14 @@ bool PMW3901::Initialize()
   return true;
 }
 
+// Checks chipId and inverse chipId, without resetting the sensor
+bool PMW3901::IsConnected()
+{
+  uint8_t chipId = RegisterRead(0x00);
+  uint8_t dIpihc = RegisterRead(0x5F);
+  return chipId == 0x49 && dIpihc == 0xB6;
+}
+
 void PMW3901::ReadMotionCount(int16_t *deltaX, int16_t *deltaY)
 {
   RegisterRead(0x02);
@@ -61,18 +67,18 @@ void PMW3901::ReadMotionCount(int16_t *deltaX, int16_t *deltaY)
 void PMW3901::RegisterWrite(uint8_t reg, uint8_t value)
 {
   BeginTransaction();
-  bcm2835_spi_transfer(reg | 0x80u);
+  SPIdev::Transfer(reg | 0x80u);
   sleep_for_microseconds(TIME_BETWEEN_COMMANDS);
-  bcm2835_spi_transfer(value);
+  SPIdev::Transfer(value);
   EndTransaction();
 }
 
 uint8_t PMW3901::RegisterRead(uint8_t reg)
 {
   BeginTransaction();
-  bcm2835_spi_transfer(reg & ~0x80u);
+  SPIdev::Transfer(reg & ~0x80u);
   sleep_for_microseconds(TIME_BETWEEN_COMMANDS);
-  uint8_t value = bcm2835_spi_transfer(0x00);
+  uint8_t value = SPIdev::Transfer(0x00);
   EndTransaction();
   return value;
 }
@@ -160,21 +166,12 @@ void PMW3901::InitRegisters()
 
 void PMW3901::BeginTransaction()
 {
-  bcm2835_spi_begin();
-  bcm2835_spi_setDataMode(BCM2835_SPI_MODE0);
-  bcm2835_spi_setClockDivider(BCM2835_SPI_CLOCK_DIVIDER_256);
-  SetChipSelect(LOW);
+  SPIdev::Select(PIN);
   sleep_for_microseconds(TIME_TO_START_TRANSACTION);
 }
 
 void PMW3901::EndTransaction()
 {
   sleep_for_microseconds(TIME_TO_END_TRANSACTION);
-  SetChipSelect(HIGH);
-  bcm2835_spi_end();
-}
-
-void PMW3901::SetChipSelect(uint8_t active)
-{
-  bcm2835_gpio_write(PIN, active);
+  SPIdev::Deselect(PIN);
 }
@@ -10,6 +10,7 @@ public:
   ~PMW3901();
 
   bool Initialize();
+  bool IsConnected();
   void ReadMotionCount(int16_t *deltaX, int16_t *deltaY);
 
 private:
@@ -18,7 +19,6 @@ private:
 
   void BeginTransaction();
   void EndTransaction();
-  void SetChipSelect(uint8_t active);
 
   void InitRegisters();
 };
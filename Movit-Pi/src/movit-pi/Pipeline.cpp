@@ -0,0 +1,69 @@
+#include "Pipeline.h"
+
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define BENCHMARK_SAMPLE_COUNT 10000000
+#define BENCHMARK_PATTERN_LENGTH 1024
+#define BENCHMARK_SAMPLE_RATE 1000   // Hz, the IMUs at full rate
+#define BENCHMARK_CUTOFF_FREQUENCY 40 // Hz
+#define BENCHMARK_DECIMATION 10
+
+namespace
+{
+// Keeps the compiler from dropping the benchmarked computations
+volatile double benchmarkSink = 0;
+
+// Raw accelerometer like samples
+int16_t samples[BENCHMARK_PATTERN_LENGTH];
+
+template <class Function>
+void Measure(const char *name, Function function)
+{
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    const double result = function();
+    const double elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    benchmarkSink = result;
+    printf("%-28s %6.2f ns/sample (%.1f)\n", name, elapsed / BENCHMARK_SAMPLE_COUNT, result);
+}
+} // namespace
+
+void BenchmarkPipeline()
+{
+    srand(1);
+    for (uint16_t i = 0; i < BENCHMARK_PATTERN_LENGTH; i++)
+    {
+        samples[i] = static_cast<int16_t>(-16384 + 800 * sin(i * 0.3) + rand() % 401 - 200);
+    }
+
+    // Raw counts to g, anti-aliasing, 100 Hz out of 1 kHz, summed
+    Measure("pipeline", [] {
+        Pipeline<Calibration, LowPass, Decimation<BENCHMARK_DECIMATION>, Accumulator> pipeline;
+        pipeline.Get<0>().Configure(0, 1.0f / 16384);
+        pipeline.Get<1>().Configure(BENCHMARK_SAMPLE_RATE, BENCHMARK_CUTOFF_FREQUENCY);
+        for (uint32_t i = 0; i < BENCHMARK_SAMPLE_COUNT; i++)
+        {
+            pipeline.Push(samples[i % BENCHMARK_PATTERN_LENGTH]);
+        }
+        return pipeline.Get<3>().GetSum();
+    });
+
+    Measure("hand-written loop", [] {
+        BiquadLowPass lowPass;
+        lowPass.Configure(BENCHMARK_SAMPLE_RATE, BENCHMARK_CUTOFF_FREQUENCY);
+        const float gain = 1.0f / 16384;
+        uint16_t count = 0;
+        double sum = 0;
+        for (uint32_t i = 0; i < BENCHMARK_SAMPLE_COUNT; i++)
+        {
+            const float sample = lowPass.AddSample(samples[i % BENCHMARK_PATTERN_LENGTH] * gain);
+            if (++count == BENCHMARK_DECIMATION)
+            {
+                count = 0;
+                sum += sample;
+            }
+        }
+        return sum;
+    });
+}
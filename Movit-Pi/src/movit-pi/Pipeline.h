@@ -0,0 +1,271 @@
+#ifndef PIPELINE_H
+#define PIPELINE_H
+
+#include "Filters.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Processing of a sensor channel declared once as a list of stages, Ex:
+//
+//     Pipeline<Calibration, LowPass, Decimation<10>, Hold> _pipeline;
+//     _pipeline.Push(sample);
+//     _pipeline.Get<3>().GetValue();
+//
+// The stages are members of the pipeline and Push() chains their Process()
+// calls at compile time, without virtual calls: the compiler inlines the whole
+// pipeline in the loop over the samples. A stage returning false keeps the
+// sample from the next ones, like Decimation. The samples are floats, the
+// sensors give at most 16 bits.
+
+template <class... Stages>
+class Pipeline;
+
+template <size_t Index, class... Stages>
+struct PipelineStage;
+
+template <>
+class Pipeline<>
+{
+  public:
+    bool Push(float) { return true; }
+    void Reset() {}
+};
+
+template <class First, class... Rest>
+class Pipeline<First, Rest...>
+{
+  public:
+    // Runs the sample through the stages, false if one of them kept it
+    bool Push(float sample)
+    {
+        return _first.Process(sample) && _rest.Push(sample);
+    }
+
+    void Reset()
+    {
+        _first.Reset();
+        _rest.Reset();
+    }
+
+    // Stage at this position, to configure it or to read a sink
+    template <size_t Index>
+    typename PipelineStage<Index, First, Rest...>::type &Get()
+    {
+        return PipelineStage<Index, First, Rest...>::Get(*this);
+    }
+
+  private:
+    template <size_t, class...>
+    friend struct PipelineStage;
+
+    First _first;
+    Pipeline<Rest...> _rest;
+};
+
+template <class First, class... Rest>
+struct PipelineStage<0, First, Rest...>
+{
+    typedef First type;
+    static type &Get(Pipeline<First, Rest...> &pipeline) { return pipeline._first; }
+};
+
+template <size_t Index, class First, class... Rest>
+struct PipelineStage<Index, First, Rest...>
+{
+    typedef typename PipelineStage<Index - 1, Rest...>::type type;
+    static type &Get(Pipeline<First, Rest...> &pipeline) { return PipelineStage<Index - 1, Rest...>::Get(pipeline._rest); }
+};
+
+// (sample - offset) * gain
+class Calibration
+{
+  public:
+    void Configure(float offset, float gain = 1)
+    {
+        _offset = offset;
+        _gain = gain;
+    }
+
+    bool Process(float &sample)
+    {
+        sample = (sample - _offset) * _gain;
+        return true;
+    }
+
+    void Reset() {}
+
+  private:
+    float _offset = 0;
+    float _gain = 1;
+};
+
+// Mean of the last WindowSize samples
+template <uint16_t WindowSize>
+class Average
+{
+  public:
+    bool Process(float &sample)
+    {
+        _average.AddSample(sample);
+        sample = static_cast<float>(_average.GetAverage());
+        return true;
+    }
+
+    void Reset() { _average.Reset(); }
+
+  private:
+    MovingAverage<float, WindowSize> _average;
+};
+
+// Median of the last WindowSize samples
+template <uint16_t WindowSize>
+class Median
+{
+  public:
+    bool Process(float &sample)
+    {
+        _median.AddSample(sample);
+        sample = static_cast<float>(_median.GetMedian());
+        return true;
+    }
+
+    void Reset() { _median.Reset(); }
+
+  private:
+    MovingMedian<float, WindowSize> _median;
+};
+
+// First order low-pass
+class Smoothing
+{
+  public:
+    void Configure(float timeConstant, float period) { _average.SetTimeConstant(timeConstant, period); }
+
+    bool Process(float &sample)
+    {
+        sample = _average.AddSample(sample);
+        return true;
+    }
+
+    void Reset() { _average.Reset(); }
+
+  private:
+    ExponentialAverage _average;
+};
+
+// Second order Butterworth low-pass, an anti-aliasing filter before a Decimation
+class LowPass
+{
+  public:
+    void Configure(float sampleRate, float cutoffFrequency) { _filter.Configure(sampleRate, cutoffFrequency); }
+
+    bool Process(float &sample)
+    {
+        sample = _filter.AddSample(sample);
+        return true;
+    }
+
+    void Reset() { _filter.Reset(); }
+
+  private:
+    BiquadLowPass _filter;
+};
+
+// Lets one sample in Factor through, the last one
+template <uint16_t Factor>
+class Decimation
+{
+    static_assert(Factor > 0, "A Decimation needs a factor");
+
+  public:
+    bool Process(float &)
+    {
+        if (++_count < Factor)
+        {
+            return false;
+        }
+        _count = 0;
+        return true;
+    }
+
+    void Reset() { _count = 0; }
+
+  private:
+    uint16_t _count = 0;
+};
+
+// 1 above the threshold, else 0. Once above, the sample must fall below
+// threshold - hysteresis to get back to 0.
+class Threshold
+{
+  public:
+    void Configure(float threshold, float hysteresis = 0)
+    {
+        _threshold = threshold;
+        _hysteresis = hysteresis;
+    }
+
+    bool Process(float &sample)
+    {
+        _isAbove = sample > (_isAbove ? _threshold - _hysteresis : _threshold);
+        sample = _isAbove ? 1.0f : 0.0f;
+        return true;
+    }
+
+    void Reset() { _isAbove = false; }
+
+  private:
+    float _threshold = 0;
+    float _hysteresis = 0;
+    bool _isAbove = false;
+};
+
+// Sink keeping the last sample out of the pipeline
+class Hold
+{
+  public:
+    bool Process(float &sample)
+    {
+        _value = sample;
+        _count++;
+        return true;
+    }
+
+    void Reset()
+    {
+        _value = 0;
+        _count = 0;
+    }
+
+    float GetValue() const { return _value; }
+    uint32_t GetCount() const { return _count; }
+
+  private:
+    float _value = 0;
+    uint32_t _count = 0;
+};
+
+// Sink summing the samples out of the pipeline
+class Accumulator
+{
+  public:
+    bool Process(float &sample)
+    {
+        _sum += sample;
+        return true;
+    }
+
+    void Reset() { _sum = 0; }
+
+    double GetSum() const { return _sum; }
+
+  private:
+    double _sum = 0;
+};
+
+// Prints the cost per sample of a composed pipeline and of the same
+// processing written by hand
+void BenchmarkPipeline();
+
+#endif // PIPELINE_H
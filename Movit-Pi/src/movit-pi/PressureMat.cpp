@@ -1,10 +1,185 @@
 #include "PressureMat.h"
 
-PressureMat::PressureMat() : _forcePlate1(_sensorMatrix, 4, 1, 0, 3, _distX, _distY, _distZ0),
-                             _forcePlate2(_sensorMatrix, 7, 4, 3, 6, _distX, _distY, _distZ0),
-                             _forcePlate3(_sensorMatrix, 5, 2, 1, 4, _distX, _distY, _distZ0),
-                             _forcePlate4(_sensorMatrix, 8, 5, 4, 7, _distX, _distY, _distZ0)
+namespace
 {
+constexpr bool IsChannelMapped(const uint8_t *channels, uint8_t channel, uint8_t index = 0)
+{
+    return index < DEFAULT_PRESSURE_SENSOR_COUNT && (channels[index] == channel || IsChannelMapped(channels, channel, index + 1));
+}
+
+// Each channel once, the map is a permutation
+constexpr bool IsPermutation(const uint8_t *channels, uint8_t channel = 0)
+{
+    return channel == DEFAULT_PRESSURE_SENSOR_COUNT || (IsChannelMapped(channels, channel) && IsPermutation(channels, channel + 1));
+}
+
+static_assert(IsPermutation(DEFAULT_PRESSURE_CHANNEL_MAP), "The default pressure channel map must be a permutation");
+
+uint16_t GetChannelCount(const pressure_mat_geometry_t &geometry)
+{
+    uint16_t channelCount = 0;
+    for (const pressure_mat_adc_t &adc : geometry.adcs)
+    {
+        channelCount += adc.channelCount;
+    }
+    return channelCount;
+}
+
+// Two ADCs at the same place would read the same chip
+bool IsSameAdc(const pressure_mat_adc_t &a, const pressure_mat_adc_t &b)
+{
+    return a.address == b.address && a.muxChannel == b.muxChannel && (a.muxChannel < 0 || a.muxAddress == b.muxAddress);
+}
+
+bool IsSameGeometry(const pressure_mat_geometry_t &a, const pressure_mat_geometry_t &b)
+{
+    if (a.rows != b.rows || a.columns != b.columns || a.adcs.size() != b.adcs.size())
+    {
+        return false;
+    }
+    for (size_t i = 0; i < a.adcs.size(); i++)
+    {
+        if (a.adcs[i].address != b.adcs[i].address || a.adcs[i].muxChannel != b.adcs[i].muxChannel || a.adcs[i].muxAddress != b.adcs[i].muxAddress || a.adcs[i].channelCount != b.adcs[i].channelCount)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+} // namespace
+
+PressureMat::PressureMat()
+{
+    SetGeometry(pressure_mat_geometry_t());
+}
+
+bool PressureMat::SetGeometry(pressure_mat_geometry_t geometry)
+{
+    const uint16_t sensorCount = geometry.rows * geometry.columns;
+    if (geometry.rows < PRESSURE_MAT_MIN_SIZE || geometry.rows > PRESSURE_MAT_MAX_SIZE ||
+        geometry.columns < PRESSURE_MAT_MIN_SIZE || geometry.columns > PRESSURE_MAT_MAX_SIZE)
+    {
+        printf("Invalid pressure mat size %ix%i, the previous geometry is kept\n", geometry.rows, geometry.columns);
+        return false;
+    }
+    if (geometry.adcs.empty())
+    {
+        printf("The pressure mat needs an ADC, the previous geometry is kept\n");
+        return false;
+    }
+    for (const pressure_mat_adc_t &adc : geometry.adcs)
+    {
+        if (adc.channelCount == 0 || adc.channelCount > MAX11611_CHANNEL_COUNT)
+        {
+            printf("Invalid pressure mat ADC channel count %i, the previous geometry is kept\n", adc.channelCount);
+            return false;
+        }
+        if (adc.muxChannel >= TCA9548A_CHANNEL_COUNT)
+        {
+            printf("Invalid pressure mat ADC mux channel %i, the previous geometry is kept\n", adc.muxChannel);
+            return false;
+        }
+        if (adc.muxChannel >= 0 && (adc.muxAddress < TCA9548A_BASE_ADDRESS || adc.muxAddress >= TCA9548A_BASE_ADDRESS + TCA9548A_COUNT))
+        {
+            printf("Invalid pressure mat ADC mux address 0x%02X, the previous geometry is kept\n", adc.muxAddress);
+            return false;
+        }
+    }
+    for (size_t i = 0; i < geometry.adcs.size(); i++)
+    {
+        for (size_t j = 0; j < i; j++)
+        {
+            if (IsSameAdc(geometry.adcs[i], geometry.adcs[j]))
+            {
+                printf("Pressure mat ADCs %i and %i are the same chip, the previous geometry is kept\n", static_cast<int>(j), static_cast<int>(i));
+                return false;
+            }
+        }
+    }
+    if (GetChannelCount(geometry) < sensorCount)
+    {
+        printf("The pressure mat ADCs have %i channels for %i sensors, the previous geometry is kept\n", GetChannelCount(geometry), sensorCount);
+        return false;
+    }
+
+    // The devices are initialized again on each reconnection, the mat stays
+    // as it is
+    if (!_adcs.empty() && IsSameGeometry(geometry, _geometry))
+    {
+        return true;
+    }
+
+    _geometry = geometry;
+    CreatePressureMatLayout(geometry.rows, geometry.columns, _plateGeometry, _layout);
+
+    // A MAX11611 has a fixed address, the others are behind a TCA9548A
+    _adcs.clear();
+    for (const pressure_mat_adc_t &adc : geometry.adcs)
+    {
+        if (adc.muxChannel < 0)
+        {
+            _adcs.push_back(MAX11611(adc.address, sensorBus));
+        }
+        else
+        {
+            _adcs.push_back(MAX11611(adc.address, I2Cdev::GetBus(sensorBus)->GetMuxChannel(adc.muxChannel, adc.muxAddress)));
+        }
+    }
+    _adcData.assign(GetChannelCount(geometry), 0);
+    _sensors.assign(sensorCount, 0);
+    _channelMap.clear();
+    SetChannelMap(pressure_mat_channel_map_t());
+
+    _sensorMatrix.SetSensorCount(sensorCount);
+    _isCalibrated = false;
+    FillPressureFrame(_layout, _sensors.data(), _pressureFrame);
+    _pressureMatData.quadrantPressure.assign(_layout.plateCount, {DEFAULT_CENTER_OF_PRESSURE, DEFAULT_CENTER_OF_PRESSURE});
+    _pressureMatData.quadrantLoad.assign(_layout.plateCount, 0.0f);
+    _pressureMatData.centerOfPressure = {DEFAULT_CENTER_OF_PRESSURE, DEFAULT_CENTER_OF_PRESSURE};
+    return true;
+}
+
+bool PressureMat::SetChannelMap(pressure_mat_channel_map_t channelMap)
+{
+    const uint16_t sensorCount = static_cast<uint16_t>(_sensors.size());
+    if (channelMap.channels.empty())
+    {
+        if (sensorCount == DEFAULT_PRESSURE_SENSOR_COUNT)
+        {
+            _channelMap.assign(DEFAULT_PRESSURE_CHANNEL_MAP, DEFAULT_PRESSURE_CHANNEL_MAP + DEFAULT_PRESSURE_SENSOR_COUNT);
+        }
+        else
+        {
+            _channelMap.resize(sensorCount);
+            for (uint16_t i = 0; i < sensorCount; i++)
+            {
+                _channelMap[i] = i;
+            }
+        }
+        return true;
+    }
+
+    // Each sensor on its own channel, some channels can stay unused
+    bool isValid = channelMap.channels.size() == sensorCount;
+    std::vector<bool> isChannelMapped(_adcData.size(), false);
+    for (uint16_t i = 0; isValid && i < sensorCount; i++)
+    {
+        const uint16_t channel = channelMap.channels[i];
+        isValid = channel < isChannelMapped.size() && !isChannelMapped[channel];
+        if (isValid)
+        {
+            isChannelMapped[channel] = true;
+        }
+    }
+
+    if (!isValid)
+    {
+        printf("Invalid pressure mat channel map, the previous one is kept\n");
+        return false;
+    }
+
+    _channelMap = channelMap.channels;
+    return true;
 }
 
 bool PressureMat::Initialize()
@@ -26,7 +201,14 @@ bool PressureMat::Initialize()
 
 bool PressureMat::IsConnected()
 {
-    return _max11611.Initialize();
+    for (size_t i = 0; i < _adcs.size(); i++)
+    {
+        if (!_adcs[i].Initialize(_geometry.adcs[i].channelCount))
+        {
+            return false;
+        }
+    }
+    return true;
 }
 
 bool PressureMat::InitializeForcePlate()
@@ -34,9 +216,9 @@ bool PressureMat::InitializeForcePlate()
     printf("MAX11611 (ADC) initializing ... ");
     if (IsConnected())
     {
-        for (uint8_t i = 0; i < PRESSURE_SENSOR_COUNT; i++)
+        for (uint16_t i = 0; i < _sensorMatrix.GetSensorCount(); i++)
         {
-            _sensorMatrix.SetAnalogData(0, i);
+            _sensorMatrix.SetAnalogData(i, 0);
         }
 
         printf("success\n");
@@ -51,9 +233,7 @@ bool PressureMat::InitializeForcePlate()
 
 void PressureMat::Calibrate()
 {
-    const uint8_t maxIterations = 10; //Calibration preceision adjustement - Number of measures (1s) in final mean
-    UpdateForcePlateData();
-    _sensorMatrix.CalibrateForceSensor(_max11611, _max11611Data, maxIterations);
+    _sensorMatrix.CalibrateForceSensor([this] { UpdateForcePlateData(); });
     _isCalibrated = true;
 }
 
@@ -69,45 +249,61 @@ void PressureMat::Update()
         {
             DetectCenterOfPressure();
 
-            _pressureMatData.quadrantPressure[GlobalForcePlate::Quadrant::FrontLeft] = _forcePlate1.GetCenterOfPressure();
-            _pressureMatData.quadrantPressure[GlobalForcePlate::Quadrant::FrontRight] = _forcePlate2.GetCenterOfPressure();
-            _pressureMatData.quadrantPressure[GlobalForcePlate::Quadrant::BackLeft] = _forcePlate3.GetCenterOfPressure();
-            _pressureMatData.quadrantPressure[GlobalForcePlate::Quadrant::BackRight] = _forcePlate4.GetCenterOfPressure();
-
-            _pressureMatData.centerOfPressure = _globalForcePlate.GetCenterOfPressure();
+            const float inverseLoad = _centerOfPressure.load != 0 ? 1 / _centerOfPressure.load : 0;
+            for (uint16_t i = 0; i < _layout.plateCount; i++)
+            {
+                _pressureMatData.quadrantPressure[i] = _centerOfPressure.plates[i];
+                _pressureMatData.quadrantLoad[i] = _centerOfPressure.loads[i] * inverseLoad;
+            }
+            _pressureMatData.centerOfPressure = _centerOfPressure.global;
         }
         else
         {
-            for (uint8_t i = 0; i < GlobalForcePlate::Quadrant::Count; i++)
+            for (uint16_t i = 0; i < _layout.plateCount; i++)
             {
                 _pressureMatData.quadrantPressure[i] = {DEFAULT_CENTER_OF_PRESSURE, DEFAULT_CENTER_OF_PRESSURE};
+                _pressureMatData.quadrantLoad[i] = 0.0f;
             }
             _pressureMatData.centerOfPressure = {DEFAULT_CENTER_OF_PRESSURE, DEFAULT_CENTER_OF_PRESSURE};
         }
     }
     else
     {
-        for (uint8_t i = 0; i < GlobalForcePlate::Quadrant::Count; i++)
+        for (uint16_t i = 0; i < _layout.plateCount; i++)
         {
             _pressureMatData.quadrantPressure[i] = {DEFAULT_CENTER_OF_PRESSURE, DEFAULT_CENTER_OF_PRESSURE};
+            _pressureMatData.quadrantLoad[i] = 0.0f;
         }
         _pressureMatData.centerOfPressure = {DEFAULT_CENTER_OF_PRESSURE, DEFAULT_CENTER_OF_PRESSURE};
         _isSomeoneThere = false;
     }
 }
 
+// The frame is stored in the logical order for the presence detection and the
+// calibration, and corner by corner for the center of pressure
 void PressureMat::UpdateForcePlateData()
 {
-    _max11611.GetData(PRESSURE_SENSOR_COUNT, _max11611Data);
-    for (uint8_t i = 0; i < PRESSURE_SENSOR_COUNT; i++)
+    uint16_t *adcData = _adcData.data();
+    for (size_t i = 0; i < _adcs.size(); i++)
     {
-        _sensorMatrix.SetAnalogData(i, _max11611Data[i]);
+        _adcs[i].GetData(_geometry.adcs[i].channelCount, adcData);
+        adcData += _geometry.adcs[i].channelCount;
     }
+    for (uint16_t i = 0; i < _sensors.size(); i++)
+    {
+        _sensors[i] = _adcData[_channelMap[i]];
+        _sensorMatrix.SetAnalogData(i, _sensors[i]);
+    }
+    FillPressureFrame(_layout, _sensors.data(), _pressureFrame);
 }
 
 bool PressureMat::IsPressureMatOffsetValid(pressure_mat_offset_t offset)
 {
-    for (int i = 0; i < PRESSURE_SENSOR_COUNT; i++)
+    if (offset.analogOffset.size() != _sensors.size())
+    {
+        return false;
+    }
+    for (size_t i = 0; i < offset.analogOffset.size(); i++)
     {
         if (offset.analogOffset[i] != 0)
         {
@@ -120,48 +316,10 @@ bool PressureMat::IsPressureMatOffsetValid(pressure_mat_offset_t offset)
 //---------------------------------------------------------------------------------------
 //Function: DetectCenterOfPressure
 //Global coordinate system (treat multiple force plates as one)
-//Global system input is four 2x2 matrix (decomposed from a global 3x3 matrix)
+//Global system input is a 2x2 matrix per force plate (decomposed from the whole mat)
 //Reference: Kistler force plate formulae PDF
 //---------------------------------------------------------------------------------------
 void PressureMat::DetectCenterOfPressure()
 {
-    //Global analysis of the 4 plates (treated as one plate)
-    /*********FORCE PLATES MAP ********** y ********* */
-    /* FRONT LEFT           FRONT RIGHT   |           */
-    /* ForcePlate1         ForcePlate2    |           */
-    /* ForcePlate3         ForcePlate4    |------->x  */
-    /**************************************************/
-
-    const float dax1 = -_distX; //Force plate 1 : bottom-right quadrant
-    const float day1 = _distY;  //(x, -y)
-    const float dax2 = _distX;  //Force plate 2 : bottom-left quadrant
-    const float day2 = _distY;  //(0, -y)
-    const float dax3 = -_distX; //Force plate 3 : top-left quadrant
-    const float day3 = -_distY; //(0, 0)
-    const float dax4 = _distX;  //Force plate 4 : top-right quadrant
-    const float day4 = -_distY; //(-x, 0)
-
-    //Update force plate
-    _forcePlate1.Update();
-    _forcePlate2.Update();
-    _forcePlate3.Update();
-    _forcePlate4.Update();
-
-    //Calculated parameters
-    _globalForcePlate.SetFx(_forcePlate1.GetFx() + _forcePlate2.GetFx() + _forcePlate3.GetFx() + _forcePlate4.GetFx());
-    _globalForcePlate.SetFy(_forcePlate1.GetFy() + _forcePlate2.GetFy() + _forcePlate3.GetFy() + _forcePlate4.GetFy());
-    _globalForcePlate.SetFz(_forcePlate1.GetFz() + _forcePlate2.GetFz() + _forcePlate3.GetFz() + _forcePlate4.GetFz());
-
-    _globalForcePlate.SetMx((day1 + _forcePlate1.GetCenterOfPressure().y) * _forcePlate1.GetFz() + (day2 + _forcePlate2.GetCenterOfPressure().y) * _forcePlate2.GetFz() + (day3 + _forcePlate3.GetCenterOfPressure().y) * _forcePlate3.GetFz() + (day4 + _forcePlate4.GetCenterOfPressure().y) * _forcePlate4.GetFz());
-    _globalForcePlate.SetMy(-(dax1 + _forcePlate1.GetCenterOfPressure().x) * _forcePlate1.GetFz() - (dax2 + _forcePlate2.GetCenterOfPressure().x) * _forcePlate2.GetFz() - (dax3 + _forcePlate3.GetCenterOfPressure().x) * _forcePlate3.GetFz() - (dax4 + _forcePlate4.GetCenterOfPressure().x) * _forcePlate4.GetFz());
-
-    _globalForcePlate.SetMx1(_globalForcePlate.GetMx() + _distZ0 * _forcePlate1.GetFy() + _distZ0 * _forcePlate2.GetFy() + _distZ0 * _forcePlate3.GetFy() + _distZ0 * _forcePlate4.GetFy());
-    _globalForcePlate.SetMy1(_globalForcePlate.GetMy() - _distZ0 * _forcePlate1.GetFx() - _distZ0 * _forcePlate2.GetFx() - _distZ0 * _forcePlate3.GetFx() - _distZ0 * _forcePlate4.GetFx());
-
-    if (_globalForcePlate.GetFx() != 0.0f)
-    {
-        //Coordinate of the force application point (C.O.P.)
-        Coord_t centerOfPressure = {(-_globalForcePlate.GetMy1() / _globalForcePlate.GetFz()), (_globalForcePlate.GetMx1() / _globalForcePlate.GetFz())};
-        _globalForcePlate.SetCenterOfPressure(centerOfPressure);
-    }
+    ComputeCenterOfPressure(_layout, _pressureFrame, _centerOfPressure);
 }
@@ -1,10 +1,9 @@
 #ifndef PRESSURE_MATH_H
 #define PRESSURE_MATH_H
 
-#include "GlobalForcePlate.h"
+#include "CenterOfPressure.h"
 #include "FileManager.h"
 #include "ForceSensor.h"
-#include "ForcePlate.h"
 #include "MAX11611.h"
 #include "Sensor.h"
 #include "Utils.h"
@@ -26,6 +25,13 @@ class PressureMat : public Sensor
 	pressure_mat_offset_t GetOffsets() { return _sensorMatrix.GetOffsets(); }
 	void SetOffsets(pressure_mat_offset_t pressureMatOffset) { _sensorMatrix.SetOffsets(pressureMatOffset); }
 
+	// Size of the mat and its ADCs, false and the geometry is kept if it is
+	// invalid. Resets the channel map and the calibration.
+	bool SetGeometry(pressure_mat_geometry_t geometry);
+	// Wiring of the mat, false and the map is kept if a sensor has no channel
+	// or shares it
+	bool SetChannelMap(pressure_mat_channel_map_t channelMap);
+
 	// Singleton
 	static PressureMat *GetInstance()
 	{
@@ -42,9 +48,9 @@ class PressureMat : public Sensor
 	const float DEFAULT_CENTER_OF_PRESSURE = 0.0f;
 
 	//Constants - physical montage values
-	const float _distX = 2.0f;   //Distance along X axis from SensorNo1 to SensorNo2
-	const float _distY = 2.0f;   //Distance along Y axis from SensorNo2 to SensorNo3
-	const float _distZ0 = 0.001; //Half of the force plate height : 0.5cm approximate for plexiglass? VALIDATE
+	//Half of the distances between the sensors along X and along Y
+	//Half of the force plate height : 0.5cm approximate for plexiglass? VALIDATE
+	const force_plate_geometry_t _plateGeometry = {2.0f, 2.0f, 0.001f};
 
 	bool IsPressureMatOffsetValid(pressure_mat_offset_t offset);
 	bool InitializeForcePlate();
@@ -56,18 +62,18 @@ class PressureMat : public Sensor
 	bool _isForcePlateInitialized = false;
 	bool _isCalibrated = false;
 
-	MAX11611 _max11611;
-	uint16_t _max11611Data[PRESSURE_SENSOR_COUNT];
+	pressure_mat_geometry_t _geometry;
+	std::vector<MAX11611> _adcs;
+	std::vector<uint16_t> _adcData; // The channels of all the ADCs
+	std::vector<uint16_t> _channelMap;
+	std::vector<uint16_t> _sensors; // In the logical order
 
 	ForceSensor _sensorMatrix;
-	GlobalForcePlate _globalForcePlate;
+	pressure_mat_layout_t _layout;
+	pressure_frame_t _pressureFrame;
+	center_of_pressure_t _centerOfPressure;
 
 	pressure_mat_data_t _pressureMatData;
-
-	ForcePlate _forcePlate1;
-	ForcePlate _forcePlate2;
-	ForcePlate _forcePlate3;
-	ForcePlate _forcePlate4;
 };
 
 #endif // PRESSURE_MATH_H
@@ -0,0 +1,74 @@
+#include "RealFft.h"
+
+#include <math.h>
+
+RealFft::RealFft(uint16_t size) : _size(size)
+{
+    const uint16_t half = size / 2;
+
+    _bitReversal.resize(half);
+    uint8_t bits = 0;
+    while ((1u << bits) < half)
+    {
+        bits++;
+    }
+    for (uint16_t i = 0; i < half; i++)
+    {
+        uint16_t reversed = 0;
+        for (uint8_t bit = 0; bit < bits; bit++)
+        {
+            reversed |= ((i >> bit) & 1) << (bits - 1 - bit);
+        }
+        _bitReversal[i] = reversed;
+    }
+
+    _twiddles.resize(half);
+    for (uint16_t k = 0; k < half; k++)
+    {
+        const double angle = -2 * M_PI * k / size;
+        _twiddles[k] = std::complex<float>(static_cast<float>(cos(angle)), static_cast<float>(sin(angle)));
+    }
+
+    _buffer.resize(half);
+}
+
+void RealFft::ComputePowerSpectrum(const float *input, float *power)
+{
+    const uint16_t half = _size / 2;
+
+    // Even samples as the real parts, odd samples as the imaginary parts
+    for (uint16_t i = 0; i < half; i++)
+    {
+        _buffer[_bitReversal[i]] = std::complex<float>(input[2 * i], input[2 * i + 1]);
+    }
+
+    // The twiddles of a stage of length n are every (size / n)th of the table
+    for (uint16_t length = 2; length <= half; length *= 2)
+    {
+        const uint16_t stride = _size / length;
+        for (uint16_t start = 0; start < half; start += length)
+        {
+            for (uint16_t j = 0; j < length / 2; j++)
+            {
+                const std::complex<float> even = _buffer[start + j];
+                const std::complex<float> odd = _buffer[start + j + length / 2] * _twiddles[j * stride];
+                _buffer[start + j] = even + odd;
+                _buffer[start + j + length / 2] = even - odd;
+            }
+        }
+    }
+
+    // Spectra of the even and odd samples, recombined into the real spectrum
+    const float dc = _buffer[0].real() + _buffer[0].imag();
+    const float nyquist = _buffer[0].real() - _buffer[0].imag();
+    power[0] = dc * dc;
+    power[half] = nyquist * nyquist;
+    for (uint16_t k = 1; k < half; k++)
+    {
+        const std::complex<float> z = _buffer[k];
+        const std::complex<float> mirror = std::conj(_buffer[half - k]);
+        const std::complex<float> even = 0.5f * (z + mirror);
+        const std::complex<float> odd = std::complex<float>(0, -0.5f) * (z - mirror);
+        power[k] = std::norm(even + _twiddles[k] * odd);
+    }
+}
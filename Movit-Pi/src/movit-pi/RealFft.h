@@ -0,0 +1,33 @@
+#ifndef REAL_FFT_H
+#define REAL_FFT_H
+
+#include <complex>
+#include <stdint.h>
+#include <vector>
+
+// Discrete Fourier transform of a fixed number of real samples, computed as a
+// radix-2 complex FFT of half the size. The twiddle factors and the bit
+// reversal permutation are computed once, the transform does no allocation.
+// Computed in float, like the orientation filters.
+class RealFft
+{
+  public:
+    // The size must be a power of two, at least 4
+    explicit RealFft(uint16_t size);
+
+    uint16_t GetSize() { return _size; }
+
+    /** Squared magnitude of each bin of the spectrum.
+     * @param input Size samples
+     * @param power Receives Size / 2 + 1 bins, from 0 to the Nyquist frequency
+     */
+    void ComputePowerSpectrum(const float *input, float *power);
+
+  private:
+    uint16_t _size;
+    std::vector<uint16_t> _bitReversal;         // Of the half size complex FFT
+    std::vector<std::complex<float>> _twiddles; // exp(-2 pi i k / size), k < size / 2
+    std::vector<std::complex<float>> _buffer;
+};
+
+#endif // REAL_FFT_H
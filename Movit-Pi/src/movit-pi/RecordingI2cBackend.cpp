@@ -0,0 +1,38 @@
+#include "RecordingI2cBackend.h"
+
+RecordingI2cBackend::RecordingI2cBackend(std::unique_ptr<I2cBackend> backend, std::shared_ptr<TrafficRecorder> recorder, uint8_t channel)
+    : _backend(std::move(backend)), _recorder(recorder), _channel(channel)
+{
+}
+
+bool RecordingI2cBackend::Open()
+{
+    return _backend->Open();
+}
+
+void RecordingI2cBackend::Close()
+{
+    _backend->Close();
+}
+
+bool RecordingI2cBackend::Transfer(i2c_segment_t *segments, uint8_t count)
+{
+    bool response = _backend->Transfer(segments, count);
+
+    uint8_t regAddr = 0;
+    for (uint8_t i = 0; i < count; i++)
+    {
+        i2c_segment_t &segment = segments[i];
+        if (i == 0 && !segment.isRead && segment.length > 0)
+        {
+            regAddr = segment.data[0];
+        }
+
+        uint8_t flags = 0;
+        flags |= segment.isRead ? TRAFFIC_FLAG_READ : 0;
+        flags |= response ? TRAFFIC_FLAG_SUCCESS : 0;
+        flags |= (i + 1 == count) ? TRAFFIC_FLAG_LAST : 0;
+        _recorder->Write(_channel, segment.devAddr, regAddr, flags, segment.data, segment.length);
+    }
+    return response;
+}
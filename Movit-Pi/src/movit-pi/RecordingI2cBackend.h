@@ -0,0 +1,24 @@
+#ifndef RECORDING_I2C_BACKEND_H
+#define RECORDING_I2C_BACKEND_H
+
+#include "I2cBackend.h"
+#include "TrafficRecorder.h"
+#include <memory>
+
+// Runs the transfers on another backend and logs every segment to a capture.
+class RecordingI2cBackend : public I2cBackend
+{
+  public:
+    RecordingI2cBackend(std::unique_ptr<I2cBackend> backend, std::shared_ptr<TrafficRecorder> recorder, uint8_t channel);
+
+    bool Open();
+    void Close();
+    bool Transfer(i2c_segment_t *segments, uint8_t count);
+
+  private:
+    std::unique_ptr<I2cBackend> _backend;
+    std::shared_ptr<TrafficRecorder> _recorder;
+    uint8_t _channel;
+};
+
+#endif // RECORDING_I2C_BACKEND_H
@@ -0,0 +1,47 @@
+#include "RecordingSpiBackend.h"
+
+RecordingSpiBackend::RecordingSpiBackend(std::unique_ptr<SpiBackend> backend, std::shared_ptr<TrafficRecorder> recorder)
+    : _backend(std::move(backend)), _recorder(recorder)
+{
+}
+
+bool RecordingSpiBackend::Open()
+{
+    return _backend->Open();
+}
+
+void RecordingSpiBackend::Close()
+{
+    _backend->Close();
+}
+
+void RecordingSpiBackend::SetupChipSelect(uint8_t pin)
+{
+    _backend->SetupChipSelect(pin);
+}
+
+void RecordingSpiBackend::Select(uint8_t pin)
+{
+    _sent.clear();
+    _received.clear();
+    _backend->Select(pin);
+}
+
+void RecordingSpiBackend::Deselect(uint8_t pin)
+{
+    _backend->Deselect(pin);
+
+    uint8_t regAddr = _sent.empty() ? 0 : _sent[0];
+    std::vector<uint8_t> payload(_sent);
+    payload.insert(payload.end(), _received.begin(), _received.end());
+    _recorder->Write(TRAFFIC_SPI_CHANNEL, pin, regAddr, TRAFFIC_FLAG_READ | TRAFFIC_FLAG_SUCCESS | TRAFFIC_FLAG_LAST,
+                     payload.data(), static_cast<uint16_t>(payload.size()));
+}
+
+uint8_t RecordingSpiBackend::Transfer(uint8_t data)
+{
+    uint8_t received = _backend->Transfer(data);
+    _sent.push_back(data);
+    _received.push_back(received);
+    return received;
+}
@@ -0,0 +1,31 @@
+#ifndef RECORDING_SPI_BACKEND_H
+#define RECORDING_SPI_BACKEND_H
+
+#include "SpiBackend.h"
+#include "TrafficRecorder.h"
+#include <memory>
+#include <vector>
+
+// Runs the transactions on another backend and logs each one to a capture as
+// a single record: the bytes sent, followed by the bytes received.
+class RecordingSpiBackend : public SpiBackend
+{
+  public:
+    RecordingSpiBackend(std::unique_ptr<SpiBackend> backend, std::shared_ptr<TrafficRecorder> recorder);
+
+    bool Open();
+    void Close();
+
+    void SetupChipSelect(uint8_t pin);
+    void Select(uint8_t pin);
+    void Deselect(uint8_t pin);
+    uint8_t Transfer(uint8_t data);
+
+  private:
+    std::unique_ptr<SpiBackend> _backend;
+    std::shared_ptr<TrafficRecorder> _recorder;
+    std::vector<uint8_t> _sent;
+    std::vector<uint8_t> _received;
+};
+
+#endif // RECORDING_SPI_BACKEND_H
@@ -0,0 +1,99 @@
+#include "ReplayI2cBackend.h"
+
+#include <stdio.h>
+#include <string.h>
+
+ReplayI2cBackend::ReplayI2cBackend(std::string fileName, uint8_t channel) : _replay(fileName), _channel(channel)
+{
+}
+
+bool ReplayI2cBackend::Open()
+{
+    if (!_replay.Open())
+    {
+        return false;
+    }
+    IndexStreams();
+    return true;
+}
+
+void ReplayI2cBackend::Close()
+{
+    _replay.Close();
+    _streams.clear();
+}
+
+// One pass over the capture, to find where each transaction of each stream
+// starts. The records themselves stay in the mapped file.
+void ReplayI2cBackend::IndexStreams()
+{
+    _streams.clear();
+
+    size_t cursor = 0;
+    const traffic_record_t *first = nullptr;
+    uint8_t count = 0;
+    const traffic_record_t *record;
+    while ((record = _replay.Next(_channel, cursor)) != nullptr)
+    {
+        if (first == nullptr)
+        {
+            first = record;
+            count = 0;
+        }
+        count++;
+
+        if ((record->flags & TRAFFIC_FLAG_LAST) != 0)
+        {
+            const uint16_t firstLength = (first->flags & TRAFFIC_FLAG_READ) != 0 ? 0 : first->length;
+            _streams[GetStreamKey(first->address, first->regAddr, count, firstLength)].transactions.push_back(_replay.GetOffset(first));
+            first = nullptr;
+        }
+    }
+}
+
+bool ReplayI2cBackend::Transfer(i2c_segment_t *segments, uint8_t count)
+{
+    if (count == 0)
+    {
+        return false;
+    }
+
+    // Same register byte as RecordingI2cBackend
+    const uint8_t regAddr = !segments[0].isRead && segments[0].length > 0 ? segments[0].data[0] : 0;
+    const uint16_t firstLength = segments[0].isRead ? 0 : segments[0].length;
+    replay_stream_t &stream = _streams[GetStreamKey(segments[0].devAddr, regAddr, count, firstLength)];
+    if (stream.next >= stream.transactions.size())
+    {
+        if (!stream.isFinished)
+        {
+            printf("Replay: end of the capture for 0x%02x register 0x%02x on I2C bus %i\n", segments[0].devAddr, regAddr, _channel);
+            stream.isFinished = true;
+        }
+        return false;
+    }
+
+    size_t cursor = stream.transactions[stream.next++];
+    bool response = true;
+    for (uint8_t i = 0; i < count; i++)
+    {
+        i2c_segment_t &segment = segments[i];
+        const traffic_record_t *record = _replay.Next(_channel, cursor);
+        bool isRead = record != nullptr && (record->flags & TRAFFIC_FLAG_READ) != 0;
+        if (record == nullptr || record->address != segment.devAddr || isRead != segment.isRead || record->length != segment.length)
+        {
+            if (!stream.isDesynchronized)
+            {
+                printf("Replay: 0x%02x register 0x%02x on I2C bus %i, segment %i is not the one of the capture\n", segments[0].devAddr, regAddr, _channel, i);
+                stream.isDesynchronized = true;
+            }
+            return false;
+        }
+
+        if (segment.isRead)
+        {
+            memcpy(segment.data, _replay.GetPayload(record), segment.length);
+        }
+        response = response && (record->flags & TRAFFIC_FLAG_SUCCESS) != 0;
+    }
+    return response;
+}
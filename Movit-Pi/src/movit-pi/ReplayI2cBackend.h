@@ -0,0 +1,50 @@
+#ifndef REPLAY_I2C_BACKEND_H
+#define REPLAY_I2C_BACKEND_H
+
+#include "I2cBackend.h"
+#include "TrafficReplay.h"
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Answers the transfers with the records of one bus of a capture. The
+// transactions are replayed in order within each stream, the transactions
+// with the same device, register and shape (segment count and length of the
+// first write), so the reads and the writes of a register from different
+// threads are separate streams, and the interleaving of the
+// threads sharing the bus can differ from the capture. The drivers must issue
+// the same transactions on each stream as during the capture; a mismatch is
+// reported once per stream and the replay goes on with the next transaction
+// of the stream.
+// Devices at the same address behind different mux channels share a stream,
+// they must be accessed from a single thread.
+class ReplayI2cBackend : public I2cBackend
+{
+  public:
+    ReplayI2cBackend(std::string fileName, uint8_t channel);
+
+    bool Open();
+    void Close();
+    bool Transfer(i2c_segment_t *segments, uint8_t count);
+
+  private:
+    struct replay_stream_t
+    {
+        std::vector<size_t> transactions; // Cursor of the first record of each
+        size_t next = 0;
+        bool isDesynchronized = false;
+        bool isFinished = false;
+    };
+
+    static uint32_t GetStreamKey(uint8_t devAddr, uint8_t regAddr, uint8_t count, uint16_t firstLength)
+    {
+        return static_cast<uint32_t>(devAddr) << 24 | static_cast<uint32_t>(regAddr) << 16 | static_cast<uint32_t>(count) << 8 | (firstLength & 0xFF);
+    }
+    void IndexStreams();
+
+    TrafficReplay _replay;
+    uint8_t _channel;
+    std::unordered_map<uint32_t, replay_stream_t> _streams;
+};
+
+#endif // REPLAY_I2C_BACKEND_H
@@ -0,0 +1,45 @@
+#include "ReplaySpiBackend.h"
+
+ReplaySpiBackend::ReplaySpiBackend(std::string fileName) : _replay(fileName)
+{
+}
+
+bool ReplaySpiBackend::Open()
+{
+    _cursor = 0;
+    return _replay.Open();
+}
+
+void ReplaySpiBackend::Close()
+{
+    _replay.Close();
+}
+
+void ReplaySpiBackend::SetupChipSelect(uint8_t pin)
+{
+}
+
+void ReplaySpiBackend::Select(uint8_t pin)
+{
+    const traffic_record_t *record = _replay.Next(TRAFFIC_SPI_CHANNEL, _cursor);
+
+    // The payload holds the bytes sent followed by the bytes received
+    _receivedLength = record != nullptr ? record->length / 2 : 0;
+    _received = record != nullptr ? _replay.GetPayload(record) + _receivedLength : nullptr;
+    _index = 0;
+}
+
+void ReplaySpiBackend::Deselect(uint8_t pin)
+{
+    _received = nullptr;
+    _receivedLength = 0;
+}
+
+uint8_t ReplaySpiBackend::Transfer(uint8_t data)
+{
+    if (_index >= _receivedLength)
+    {
+        return 0;
+    }
+    return _received[_index++];
+}
@@ -0,0 +1,31 @@
+#ifndef REPLAY_SPI_BACKEND_H
+#define REPLAY_SPI_BACKEND_H
+
+#include "SpiBackend.h"
+#include "TrafficReplay.h"
+#include <string>
+
+// Answers each transaction with the bytes received in the next SPI record of
+// a capture.
+class ReplaySpiBackend : public SpiBackend
+{
+  public:
+    ReplaySpiBackend(std::string fileName);
+
+    bool Open();
+    void Close();
+
+    void SetupChipSelect(uint8_t pin);
+    void Select(uint8_t pin);
+    void Deselect(uint8_t pin);
+    uint8_t Transfer(uint8_t data);
+
+  private:
+    TrafficReplay _replay;
+    size_t _cursor = 0;
+    const uint8_t *_received = nullptr;
+    uint16_t _receivedLength = 0;
+    uint16_t _index = 0;
+};
+
+#endif // REPLAY_SPI_BACKEND_H
@@ -0,0 +1,49 @@
+#ifndef RUNNING_STATISTICS_H
+#define RUNNING_STATISTICS_H
+
+#include <math.h>
+#include <stdint.h>
+
+// Mean and variance of a stream of samples, updated one sample at a time with
+// Welford's algorithm. The samples are not kept, and the result does not
+// suffer from the cancellation of a sum of squares.
+class RunningStatistics
+{
+  public:
+    void AddSample(double sample)
+    {
+        _count++;
+        const double delta = sample - _mean;
+        _mean += delta / _count;
+        _squaredDeviations += delta * (sample - _mean);
+    }
+
+    void Reset()
+    {
+        _count = 0;
+        _mean = 0;
+        _squaredDeviations = 0;
+    }
+
+    uint32_t GetCount() { return _count; }
+    double GetMean() { return _mean; }
+
+    // Unbiased variance of the samples
+    double GetVariance()
+    {
+        return _count > 1 ? _squaredDeviations / (_count - 1) : 0;
+    }
+
+    // Standard deviation of the mean itself
+    double GetStandardError()
+    {
+        return _count > 1 ? sqrt(GetVariance() / _count) : INFINITY;
+    }
+
+  private:
+    uint32_t _count = 0;
+    double _mean = 0;
+    double _squaredDeviations = 0;
+};
+
+#endif // RUNNING_STATISTICS_H
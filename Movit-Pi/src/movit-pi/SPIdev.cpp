@@ -0,0 +1,113 @@
+#include "SPIdev.h"
+#include "BusStatistics.h"
+#ifndef MOVIT_SIM
+#include "Bcm2835SpiBackend.h"
+#endif
+#include "RecordingSpiBackend.h"
+#include "ReplaySpiBackend.h"
+#include "SimSpiBackend.h"
+#include <chrono>
+#include <stdio.h>
+
+#ifdef MOVIT_SIM
+SpiBackendType selectedSpiBackend = simSpiBackend;
+#else
+SpiBackendType selectedSpiBackend = bcm2835SpiBackend;
+#endif
+std::string selectedSpiDevice;
+std::shared_ptr<TrafficRecorder> spiRecorder;
+std::unique_ptr<SpiBackend> spiBackend;
+std::chrono::steady_clock::time_point spiSelectTime;
+
+/** Choose the SPI backend. Must be called before Initialize() to have any effect.
+ * @param backendType bcm2835SpiBackend (default, simSpiBackend in the
+ * simulation build), replaySpiBackend or simSpiBackend
+ * @param device Capture file, only used by replaySpiBackend
+ */
+void SPIdev::SelectBackend(SpiBackendType backendType, std::string device)
+{
+    selectedSpiBackend = backendType;
+    selectedSpiDevice = device;
+}
+
+/** Log every SPI transaction to a capture. Must be called before Initialize().
+ * @param recorder Capture shared with the I2C buses
+ */
+void SPIdev::SetRecorder(std::shared_ptr<TrafficRecorder> recorder)
+{
+    spiRecorder = recorder;
+}
+
+void SPIdev::Initialize()
+{
+    if (selectedSpiBackend == replaySpiBackend)
+    {
+        spiBackend.reset(new ReplaySpiBackend(selectedSpiDevice));
+    }
+#ifndef MOVIT_SIM
+    else if (selectedSpiBackend == bcm2835SpiBackend)
+    {
+        spiBackend.reset(new Bcm2835SpiBackend());
+    }
+#endif
+    else
+    {
+        spiBackend.reset(new SimSpiBackend());
+    }
+
+    if (spiRecorder)
+    {
+        spiBackend.reset(new RecordingSpiBackend(std::move(spiBackend), spiRecorder));
+    }
+
+    if (!spiBackend->Open())
+    {
+        printf("Error: Unable to open the SPI bus\n");
+    }
+}
+
+void SPIdev::Close()
+{
+    if (spiBackend)
+    {
+        spiBackend->Close();
+    }
+}
+
+void SPIdev::SetupChipSelect(uint8_t pin)
+{
+    if (spiBackend)
+    {
+        spiBackend->SetupChipSelect(pin);
+    }
+}
+
+void SPIdev::Select(uint8_t pin)
+{
+    if (spiBackend)
+    {
+        spiSelectTime = std::chrono::steady_clock::now();
+        spiBackend->Select(pin);
+    }
+}
+
+void SPIdev::Deselect(uint8_t pin)
+{
+    if (spiBackend)
+    {
+        spiBackend->Deselect(pin);
+
+        // SPI has no acknowledge, a transaction cannot fail
+        uint32_t elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - spiSelectTime).count();
+        BusStatistics::GetInstance()->Record(BUS_SPI_CHANNEL, pin, busTransfer, elapsed, true);
+    }
+}
+
+uint8_t SPIdev::Transfer(uint8_t data)
+{
+    if (!spiBackend)
+    {
+        return 0;
+    }
+    return spiBackend->Transfer(data);
+}
@@ -0,0 +1,24 @@
+#ifndef SPIDEV_H
+#define SPIDEV_H
+
+#include "SpiBackend.h"
+#include "TrafficRecorder.h"
+#include <memory>
+#include <string>
+
+// Access to the SPI bus for the device drivers, through the selected backend.
+class SPIdev
+{
+  public:
+    static void SelectBackend(SpiBackendType backendType, std::string device);
+    static void SetRecorder(std::shared_ptr<TrafficRecorder> recorder);
+    static void Initialize();
+    static void Close();
+
+    static void SetupChipSelect(uint8_t pin);
+    static void Select(uint8_t pin);
+    static void Deselect(uint8_t pin);
+    static uint8_t Transfer(uint8_t data);
+};
+
+#endif // SPIDEV_H
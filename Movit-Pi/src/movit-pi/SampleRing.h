@@ -0,0 +1,91 @@
+#ifndef SAMPLE_RING_H
+#define SAMPLE_RING_H
+
+#include <atomic>
+#include <stdint.h>
+#include <type_traits>
+#include <vector>
+
+// Latest samples written by one thread, read by any number of threads at
+// their own pace. Each reader keeps its own cursor. Neither side ever waits:
+// every slot carries a sequence number, odd while the slot is being written,
+// and a reader drops a sample overwritten during its copy (seqlock). A reader
+// more than Size samples behind loses the oldest ones, the writer is never held
+// back. Size must be a power of two.
+template <class T, uint32_t Size>
+class SampleRing
+{
+    static_assert(Size != 0 && (Size & (Size - 1)) == 0, "The size of a SampleRing must be a power of two");
+    static_assert(std::is_trivially_copyable<T>::value, "The samples are copied while they may be overwritten");
+
+  public:
+    // Index of the next sample a reader will get
+    typedef uint64_t Cursor;
+
+    // Only from the writer thread, or after it was joined
+    void Push(const T &sample)
+    {
+        const uint64_t index = _head.load(std::memory_order_relaxed);
+        slot_t &slot = _slots[index & (Size - 1)];
+
+        slot.sequence.store(2 * index + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        slot.sample = sample;
+        slot.sequence.store(2 * index + 2, std::memory_order_release);
+        _head.store(index + 1, std::memory_order_release);
+    }
+
+    // Cursor of a new reader, which only gets the samples pushed from now on
+    Cursor GetNewestCursor() const { return _head.load(std::memory_order_acquire); }
+
+    /** Append the samples pushed since the cursor, and move it past them.
+     * @return Number of samples the reader lost by falling behind the writer
+     */
+    uint64_t Read(Cursor &cursor, std::vector<T> &samples) const
+    {
+        const uint64_t head = _head.load(std::memory_order_acquire);
+        uint64_t lost = 0;
+        if (cursor > head)
+        {
+            cursor = head;
+        }
+        else if (head - cursor > Size)
+        {
+            lost = head - cursor - Size;
+            cursor = head - Size;
+        }
+
+        for (; cursor < head; cursor++)
+        {
+            const slot_t &slot = _slots[cursor & (Size - 1)];
+            const uint64_t sequence = 2 * cursor + 2;
+            if (slot.sequence.load(std::memory_order_acquire) != sequence)
+            {
+                lost++;
+                continue;
+            }
+
+            T sample = slot.sample;
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.sequence.load(std::memory_order_relaxed) != sequence)
+            {
+                lost++;
+                continue;
+            }
+            samples.push_back(sample);
+        }
+        return lost;
+    }
+
+  private:
+    struct slot_t
+    {
+        std::atomic<uint64_t> sequence{0};
+        T sample;
+    };
+
+    slot_t _slots[Size];
+    std::atomic<uint64_t> _head{0};
+};
+
+#endif // SAMPLE_RING_H
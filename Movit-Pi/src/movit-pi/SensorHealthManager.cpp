@@ -0,0 +1,196 @@
+#include "SensorHealthManager.h"
+#include "I2cScheduler.h"
+#include <algorithm>
+#include <stdio.h>
+
+using std::chrono::milliseconds;
+using std::chrono::steady_clock;
+
+SensorHealthManager::~SensorHealthManager()
+{
+    Stop();
+}
+
+void SensorHealthManager::Register(int device, bool isConnected, std::function<bool()> probe, std::function<bool()> reinitialize)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    device_health_t &health = _devices[device];
+    health.probe = probe;
+    health.reinitialize = reinitialize;
+    health.state = circuitClosed;
+    health.failures = 0;
+    health.attempts = 0;
+    if (!isConnected)
+    {
+        Open(health);
+    }
+    _condition.notify_one();
+}
+
+void SensorHealthManager::Start()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_isRunning)
+    {
+        return;
+    }
+
+    _isRunning = true;
+    _thread = std::thread([=] { Run(); });
+}
+
+void SensorHealthManager::Stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _isRunning = false;
+    }
+    _condition.notify_all();
+
+    if (_thread.joinable())
+    {
+        _thread.join();
+    }
+}
+
+bool SensorHealthManager::IsAvailable(int device)
+{
+    return GetState(device) == circuitClosed;
+}
+
+CircuitState SensorHealthManager::GetState(int device)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    auto health = _devices.find(device);
+    if (health == _devices.end())
+    {
+        return circuitClosed;
+    }
+    return health->second.state;
+}
+
+// Result of a probe made by the main loop. Ignored while the circuit is open,
+// the main loop should not be probing the device then.
+void SensorHealthManager::ReportProbe(int device, bool isConnected)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    auto health = _devices.find(device);
+    if (health == _devices.end() || health->second.state != circuitClosed)
+    {
+        return;
+    }
+
+    if (isConnected)
+    {
+        health->second.failures = 0;
+    }
+    else if (++health->second.failures >= HEALTH_FAILURE_THRESHOLD)
+    {
+        printf("Device %i disconnected, reconnecting in the background\n", device);
+        Open(health->second);
+        _condition.notify_one();
+    }
+}
+
+// Must be called with _mutex held
+void SensorHealthManager::Open(device_health_t &health)
+{
+    uint32_t delay = HEALTH_MAX_RETRY_DELAY_MS;
+    if (health.attempts < 16)
+    {
+        delay = std::min<uint32_t>(HEALTH_MIN_RETRY_DELAY_MS << health.attempts, HEALTH_MAX_RETRY_DELAY_MS);
+    }
+
+    health.state = circuitOpen;
+    health.nextAttempt = steady_clock::now() + milliseconds(delay);
+}
+
+void SensorHealthManager::Run()
+{
+    // Reconnection attempts must not delay the sampling
+    I2cPriorityScope priorityScope(lowPriority);
+
+    std::unique_lock<std::mutex> lock(_mutex);
+    while (_isRunning)
+    {
+        steady_clock::time_point now = steady_clock::now();
+        steady_clock::time_point wakeTime = now + milliseconds(HEALTH_MAX_RETRY_DELAY_MS);
+        device_health_t *due = nullptr;
+
+        for (auto &entry : _devices)
+        {
+            if (entry.second.state != circuitOpen)
+            {
+                continue;
+            }
+            if (entry.second.nextAttempt <= now)
+            {
+                due = &entry.second;
+                break;
+            }
+            wakeTime = std::min(wakeTime, entry.second.nextAttempt);
+        }
+
+        if (due == nullptr)
+        {
+            _condition.wait_until(lock, wakeTime);
+            continue;
+        }
+
+        // The bus operations run unlocked, the main loop keeps checking
+        // IsAvailable() meanwhile
+        due->state = circuitHalfOpen;
+        std::function<bool()> probe = due->probe;
+        lock.unlock();
+
+        bool isConnected = probe();
+
+        lock.lock();
+        if (isConnected)
+        {
+            due->state = circuitRecovered;
+        }
+        else
+        {
+            due->attempts++;
+            Open(*due);
+        }
+    }
+}
+
+void SensorHealthManager::Reinitialize()
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    for (auto &entry : _devices)
+    {
+        if (entry.second.state != circuitRecovered)
+        {
+            continue;
+        }
+
+        // The devices are not removed, the entry stays valid unlocked
+        std::function<bool()> reinitialize = entry.second.reinitialize;
+        lock.unlock();
+
+        bool isRecovered = reinitialize();
+
+        lock.lock();
+        if (isRecovered)
+        {
+            printf("Device %i reconnected after %u attempts\n", entry.first, entry.second.attempts + 1);
+            entry.second.state = circuitClosed;
+            entry.second.failures = 0;
+            entry.second.attempts = 0;
+        }
+        else
+        {
+            entry.second.attempts++;
+            Open(entry.second);
+            _condition.notify_one();
+        }
+    }
+}
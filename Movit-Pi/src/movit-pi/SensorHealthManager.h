@@ -0,0 +1,70 @@
+#ifndef SENSOR_HEALTH_MANAGER_H
+#define SENSOR_HEALTH_MANAGER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
+
+#define HEALTH_FAILURE_THRESHOLD 2      // Consecutive failed probes before a device is declared dead
+#define HEALTH_MIN_RETRY_DELAY_MS 500   // First reconnection attempt
+#define HEALTH_MAX_RETRY_DELAY_MS 60000 // The delay doubles after each failed attempt, up to this limit
+
+enum CircuitState
+{
+    circuitClosed = 0, // Device working, probed by the main loop
+    circuitOpen,       // Device dead, waiting for its next reconnection attempt
+    circuitHalfOpen,   // Reconnection probe in progress
+    circuitRecovered   // Probe succeeded, waiting for the main loop to re-initialize the device
+};
+
+// Circuit breaker for each sensor. While a device works, the main loop probes
+// it and reports the result. Once it fails HEALTH_FAILURE_THRESHOLD times in a
+// row, the circuit opens: the main loop stops touching the device, and the
+// health thread probes it with an exponential backoff. When it answers again,
+// the main loop runs the full re-initialization (calibration included) from
+// Reinitialize(), so the device objects are only rebuilt on the thread that
+// uses them.
+class SensorHealthManager
+{
+  public:
+    ~SensorHealthManager();
+
+    // @param probe Cheap connection test
+    // @param reinitialize Full initialization, called by Reinitialize() once the
+    // probe succeeds again
+    void Register(int device, bool isConnected, std::function<bool()> probe, std::function<bool()> reinitialize);
+
+    void Start();
+    void Stop();
+
+    bool IsAvailable(int device);
+    void ReportProbe(int device, bool isConnected);
+    // Re-initializes the recovered devices, on the calling thread
+    void Reinitialize();
+    CircuitState GetState(int device);
+
+  private:
+    struct device_health_t
+    {
+        std::function<bool()> probe;
+        std::function<bool()> reinitialize;
+        CircuitState state;
+        uint32_t failures;
+        uint32_t attempts;
+        std::chrono::steady_clock::time_point nextAttempt;
+    };
+
+    void Open(device_health_t &health);
+    void Run();
+
+    std::map<int, device_health_t> _devices;
+    std::mutex _mutex;
+    std::condition_variable _condition;
+    std::thread _thread;
+    bool _isRunning = false;
+};
+
+#endif // SENSOR_HEALTH_MANAGER_H
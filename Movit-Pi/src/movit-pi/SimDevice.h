@@ -0,0 +1,69 @@
+#ifndef SIM_DEVICE_H
+#define SIM_DEVICE_H
+
+#include "SimWorld.h"
+#include <stdint.h>
+
+// Behavioural model of an I2C device. Write() and Read() receive the payload
+// of one segment; returning false is a NACK.
+class SimDevice
+{
+  public:
+    SimDevice(SimDeviceId deviceId) : _deviceId(deviceId) {}
+    virtual ~SimDevice() = default;
+
+    bool IsConnected() { return SimWorld::GetInstance()->IsConnected(_deviceId); }
+
+    virtual bool Write(const uint8_t *data, uint16_t length) = 0;
+    virtual bool Read(uint8_t *data, uint16_t length) = 0;
+
+  private:
+    SimDeviceId _deviceId;
+};
+
+// Device with 8-bit registers and an auto-incremented register pointer: the
+// first byte written selects the register, the next ones are written to it.
+class SimRegisterDevice : public SimDevice
+{
+  public:
+    SimRegisterDevice(SimDeviceId deviceId) : SimDevice(deviceId) {}
+
+    bool Write(const uint8_t *data, uint16_t length)
+    {
+        if (length == 0)
+        {
+            return true;
+        }
+        _pointer = data[0];
+        for (uint16_t i = 1; i < length; i++)
+        {
+            WriteRegister(_pointer, data[i]);
+            _pointer = GetNextRegister(_pointer);
+        }
+        return true;
+    }
+
+    bool Read(uint8_t *data, uint16_t length)
+    {
+        BeginRead(_pointer);
+        for (uint16_t i = 0; i < length; i++)
+        {
+            data[i] = ReadRegister(_pointer);
+            _pointer = GetNextRegister(_pointer);
+        }
+        return true;
+    }
+
+  protected:
+    // Called once before each read, to latch the values read together
+    virtual void BeginRead(uint8_t regAddr) {}
+    virtual uint8_t ReadRegister(uint8_t regAddr) = 0;
+    virtual void WriteRegister(uint8_t regAddr, uint8_t value) = 0;
+    // Register accessed after regAddr in a burst, a FIFO register is read again
+    virtual uint8_t GetNextRegister(uint8_t regAddr) { return regAddr + 1; }
+
+  private:
+    uint8_t _pointer = 0;
+};
+
+#endif // SIM_DEVICE_H
@@ -0,0 +1,170 @@
+#include "SimGpioEventLine.h"
+
+#include <algorithm>
+#include <poll.h>
+#include <stdio.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+SimGpio *SimGpio::GetInstance()
+{
+    static SimGpio instance;
+    return &instance;
+}
+
+SimGpio::~SimGpio()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _isRunning = false;
+    }
+    _condition.notify_all();
+    if (_thread.joinable())
+    {
+        _thread.join();
+    }
+
+    // The event file descriptors are left open, the IMU singletons can still
+    // be waiting on them while the program exits
+}
+
+SimGpio::sim_gpio_line_t &SimGpio::GetLine(unsigned line)
+{
+    sim_gpio_line_t &simLine = _lines[line];
+    if (simLine.eventFd < 0)
+    {
+        simLine.eventFd = eventfd(0, EFD_NONBLOCK);
+    }
+    return simLine;
+}
+
+int SimGpio::GetEventFd(unsigned line)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return GetLine(line).eventFd;
+}
+
+void SimGpio::RaiseEdge(unsigned line)
+{
+    int eventFd = GetEventFd(line);
+    uint64_t value = 1;
+    if (write(eventFd, &value, sizeof(value)) < 0)
+    {
+        printf("Error: Unable to raise an edge on the simulated GPIO %u\n", line);
+    }
+}
+
+void SimGpio::SetPeriodicEdges(unsigned line, std::chrono::steady_clock::time_point first, std::chrono::microseconds period)
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        sim_gpio_line_t &simLine = GetLine(line);
+        simLine.nextEdge = first;
+        simLine.period = period;
+
+        if (!_isRunning && period.count() > 0)
+        {
+            _isRunning = true;
+            _thread = std::thread([=] { Run(); });
+        }
+    }
+    _condition.notify_all();
+}
+
+void SimGpio::Run()
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    while (_isRunning)
+    {
+        const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        std::chrono::steady_clock::time_point wakeUp = now + std::chrono::seconds(1);
+
+        for (auto &entry : _lines)
+        {
+            sim_gpio_line_t &simLine = entry.second;
+            if (simLine.period.count() <= 0)
+            {
+                continue;
+            }
+
+            if (simLine.nextEdge <= now)
+            {
+                // Late edges are merged, like a level interrupt not yet served
+                uint64_t value = 1;
+                if (write(simLine.eventFd, &value, sizeof(value)) < 0)
+                {
+                    printf("Error: Unable to raise an edge on the simulated GPIO %u\n", entry.first);
+                }
+                const int64_t missed = (now - simLine.nextEdge) / simLine.period;
+                simLine.nextEdge += simLine.period * (missed + 1);
+            }
+            wakeUp = std::min(wakeUp, simLine.nextEdge);
+        }
+
+        _condition.wait_until(lock, wakeUp);
+    }
+}
+
+SimGpioEventLine::SimGpioEventLine(unsigned line) : _line(line)
+{
+}
+
+SimGpioEventLine::~SimGpioEventLine()
+{
+    Close();
+}
+
+bool SimGpioEventLine::Open()
+{
+    Close();
+    _eventFd = SimGpio::GetInstance()->GetEventFd(_line);
+    _wakeFd = eventfd(0, EFD_NONBLOCK);
+    return _eventFd >= 0 && _wakeFd >= 0;
+}
+
+void SimGpioEventLine::Close()
+{
+    _eventFd = -1;
+    if (_wakeFd >= 0)
+    {
+        close(_wakeFd);
+        _wakeFd = -1;
+    }
+}
+
+GpioWaitResult SimGpioEventLine::Wait(int timeoutMs, uint64_t &timestamp)
+{
+    if (_eventFd < 0)
+    {
+        return gpioError;
+    }
+
+    struct pollfd fds[2] = {{_eventFd, POLLIN, 0}, {_wakeFd, POLLIN, 0}};
+    int count = PollWithoutInterruption(fds, 2, timeoutMs);
+    if (count < 0 || (fds[1].revents & POLLIN))
+    {
+        return gpioError;
+    }
+    if (count == 0)
+    {
+        return gpioTimeout;
+    }
+
+    timestamp = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+
+    // The counter holds the edges since the previous wait
+    uint64_t edges;
+    return read(_eventFd, &edges, sizeof(edges)) == sizeof(edges) ? gpioEdge : gpioError;
+}
+
+void SimGpioEventLine::Interrupt()
+{
+    if (_wakeFd >= 0)
+    {
+        uint64_t value = 1;
+        if (write(_wakeFd, &value, sizeof(value)) < 0)
+        {
+            printf("Error: Unable to wake the simulated GPIO %u waiter\n", _line);
+        }
+    }
+}
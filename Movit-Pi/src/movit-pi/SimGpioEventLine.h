@@ -0,0 +1,66 @@
+#ifndef SIM_GPIO_EVENT_LINE_H
+#define SIM_GPIO_EVENT_LINE_H
+
+#include "GpioEventLine.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <thread>
+
+// GPIO lines of the simulation. A simulated device drives its interrupt line
+// with periodic rising edges, raised on time by a timer thread, so the waiters
+// sleep like with the real GPIO chip.
+class SimGpio
+{
+  public:
+    static SimGpio *GetInstance();
+    ~SimGpio();
+
+    // Event file descriptor signaled by the edges of the line
+    int GetEventFd(unsigned line);
+    void RaiseEdge(unsigned line);
+    // Edges at first, first + period, ... A null period stops them.
+    void SetPeriodicEdges(unsigned line, std::chrono::steady_clock::time_point first, std::chrono::microseconds period);
+
+  private:
+    SimGpio() = default;
+    SimGpio(SimGpio const &) = delete;
+    SimGpio &operator=(SimGpio const &) = delete;
+
+    struct sim_gpio_line_t
+    {
+        int eventFd = -1;
+        std::chrono::steady_clock::time_point nextEdge;
+        std::chrono::microseconds period{0};
+    };
+
+    sim_gpio_line_t &GetLine(unsigned line);
+    void Run();
+
+    std::map<unsigned, sim_gpio_line_t> _lines;
+    std::mutex _mutex;
+    std::condition_variable _condition;
+    std::thread _thread;
+    bool _isRunning = false;
+};
+
+class SimGpioEventLine : public GpioEventLine
+{
+  public:
+    SimGpioEventLine(unsigned line);
+    ~SimGpioEventLine();
+
+    bool Open();
+    void Close();
+    GpioWaitResult Wait(int timeoutMs, uint64_t &timestamp);
+    void Interrupt();
+
+  private:
+    unsigned _line;
+    int _eventFd = -1; // Owned by SimGpio
+    int _wakeFd = -1;
+};
+
+#endif // SIM_GPIO_EVENT_LINE_H
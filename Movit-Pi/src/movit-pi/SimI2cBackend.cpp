@@ -0,0 +1,112 @@
+#include "SimI2cBackend.h"
+#include "GpioEventLine.h"
+#include "SimMax11611.h"
+#include "SimMcp79410.h"
+#include "SimMpu6050.h"
+#include "SimPca9536.h"
+#include "SimVl53l0x.h"
+#include "MAX11611.h"
+#include "MCP79410.h"
+#include "MPU6050.h"
+#include "PCA9536.h"
+#include <stdio.h>
+
+#define SIM_VL53L0X_ADDRESS 0x29
+
+// Each IMU has its own bias, to exercise the calibration
+const int16_t SIM_FIXED_ACCEL_BIAS[3] = {310, -145, 220};
+const int16_t SIM_FIXED_GYRO_BIAS[3] = {-24, 13, 7};
+const int16_t SIM_MOBILE_ACCEL_BIAS[3] = {-180, 95, -260};
+const int16_t SIM_MOBILE_GYRO_BIAS[3] = {18, -9, -30};
+
+SimI2cBackend::SimI2cBackend()
+{
+    _devices[MPU6050_ADDRESS_AD0_LOW].reset(new SimMpu6050(simFixedImu, SIM_FIXED_ACCEL_BIAS, SIM_FIXED_GYRO_BIAS, FIXED_IMU_INTERRUPT_LINE));
+    _devices[MPU6050_ADDRESS_AD0_HIGH].reset(new SimMpu6050(simMobileImu, SIM_MOBILE_ACCEL_BIAS, SIM_MOBILE_GYRO_BIAS, MOBILE_IMU_INTERRUPT_LINE));
+    _devices[MAX11611_DEFAULT_ADDRESS].reset(new SimMax11611());
+    _devices[Pca9536::DEV_ADDR].reset(new SimPca9536());
+    _devices[ADDR_MCP79410].reset(new SimMcp79410());
+    _devices[SIM_VL53L0X_ADDRESS].reset(new SimVl53l0x());
+
+    _channelDevices[2][MPU6050_ADDRESS_AD0_LOW].reset(new SimMpu6050(simFrameImu, SIM_MOBILE_ACCEL_BIAS, SIM_FIXED_GYRO_BIAS));
+}
+
+// Device answering at an address, directly or through a connected mux channel
+SimDevice *SimI2cBackend::GetDevice(uint8_t devAddr, bool *isConflicting)
+{
+    SimDevice *found = nullptr;
+    *isConflicting = false;
+
+    SimDevice *candidates[1 + TCA9548A_CHANNEL_COUNT] = {_devices[devAddr].get()};
+    for (uint8_t channel = 0; channel < TCA9548A_CHANNEL_COUNT; channel++)
+    {
+        candidates[1 + channel] = (_muxSelection & (1 << channel)) ? _channelDevices[channel][devAddr].get() : nullptr;
+    }
+
+    for (SimDevice *device : candidates)
+    {
+        if (device == nullptr || !device->IsConnected())
+        {
+            continue;
+        }
+        if (found != nullptr)
+        {
+            *isConflicting = true;
+        }
+        found = device;
+    }
+    return found;
+}
+
+bool SimI2cBackend::Open()
+{
+    return true;
+}
+
+void SimI2cBackend::Close()
+{
+}
+
+bool SimI2cBackend::Transfer(i2c_segment_t *segments, uint8_t count)
+{
+    for (uint8_t i = 0; i < count; i++)
+    {
+        i2c_segment_t &segment = segments[i];
+        if (segment.devAddr >= 128)
+        {
+            return false;
+        }
+
+        if (segment.devAddr == TCA9548A_DEFAULT_ADDRESS)
+        {
+            if (segment.isRead && segment.length > 0)
+            {
+                segment.data[0] = _muxSelection;
+            }
+            else if (segment.length > 0)
+            {
+                _muxSelection = segment.data[0];
+            }
+            continue;
+        }
+
+        bool isConflicting;
+        SimDevice *device = GetDevice(segment.devAddr, &isConflicting);
+        if (device == nullptr)
+        {
+            return false;
+        }
+        if (isConflicting)
+        {
+            printf("Sim: Address conflict on 0x%02X, mux selection 0x%02X\n", segment.devAddr, _muxSelection);
+            return false;
+        }
+
+        bool response = segment.isRead ? device->Read(segment.data, segment.length) : device->Write(segment.data, segment.length);
+        if (!response)
+        {
+            return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,31 @@
+#ifndef SIM_I2C_BACKEND_H
+#define SIM_I2C_BACKEND_H
+
+#include "I2cBackend.h"
+#include "SimDevice.h"
+#include "TCA9548A.h"
+#include <memory>
+
+// I2C bus populated with the models of the devices of the chair. Unplugged
+// devices, and addresses without a device, do not acknowledge.
+// A TCA9548A at its default address has a frame IMU on its channel 2, at the
+// address of the fixed IMU. Two devices answering at the same address fail
+// the transaction, as the collision would on a real bus.
+class SimI2cBackend : public I2cBackend
+{
+  public:
+    SimI2cBackend();
+
+    bool Open();
+    void Close();
+    bool Transfer(i2c_segment_t *segments, uint8_t count);
+
+  private:
+    SimDevice *GetDevice(uint8_t devAddr, bool *isConflicting);
+
+    std::unique_ptr<SimDevice> _devices[128];
+    std::unique_ptr<SimDevice> _channelDevices[TCA9548A_CHANNEL_COUNT][128];
+    uint8_t _muxSelection = TCA9548A_NO_CHANNEL;
+};
+
+#endif // SIM_I2C_BACKEND_H
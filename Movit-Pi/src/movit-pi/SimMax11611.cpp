@@ -0,0 +1,46 @@
+#include "SimMax11611.h"
+
+#include <algorithm>
+
+#define SIM_SEATED_VALUE 600
+#define SIM_EMPTY_VALUE 8
+#define SIM_ADC_MAX 1023
+
+SimMax11611::SimMax11611() : SimDevice(simPressureMat)
+{
+}
+
+bool SimMax11611::Write(const uint8_t *data, uint16_t length)
+{
+    // Setup and configuration bytes, the scan always covers every channel
+    return true;
+}
+
+uint16_t SimMax11611::GetChannelValue(uint8_t channel, const sim_state_t &state)
+{
+    SimWorld *world = SimWorld::GetInstance();
+    if (!state.isSeated)
+    {
+        return static_cast<uint16_t>(SIM_EMPTY_VALUE + world->Noise(SIM_EMPTY_VALUE));
+    }
+
+    // Channels 0 to 2 are the right column, front to back, then the middle and
+    // left columns
+    const float x = 1.0f - channel / 3;
+    const float y = 1.0f - channel % 3;
+    const float load = 1.0f + 0.6f * (x * state.centerOfPressureX + y * state.centerOfPressureY);
+    const float value = SIM_SEATED_VALUE * std::max(0.0f, load) + world->Noise(5);
+    return static_cast<uint16_t>(std::max(0.0f, std::min<float>(SIM_ADC_MAX, value)));
+}
+
+bool SimMax11611::Read(uint8_t *data, uint16_t length)
+{
+    sim_state_t state = SimWorld::GetInstance()->GetState();
+    for (uint16_t i = 0; i + 1 < length; i += 2)
+    {
+        uint16_t value = GetChannelValue(i / 2, state);
+        data[i] = 0xFC | static_cast<uint8_t>(value >> 8);
+        data[i + 1] = static_cast<uint8_t>(value);
+    }
+    return true;
+}
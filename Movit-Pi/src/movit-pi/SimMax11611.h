@@ -0,0 +1,22 @@
+#ifndef SIM_MAX11611_H
+#define SIM_MAX11611_H
+
+#include "SimDevice.h"
+
+// MAX11611 scanning the force sensors of the pressure mat. A read returns two
+// bytes per channel, the 10-bit result right-aligned with the six upper bits
+// set, like the real ADC. The load is spread on the 3x3 sensor grid according
+// to the center of pressure of the user.
+class SimMax11611 : public SimDevice
+{
+  public:
+    SimMax11611();
+
+    bool Write(const uint8_t *data, uint16_t length);
+    bool Read(uint8_t *data, uint16_t length);
+
+  private:
+    uint16_t GetChannelValue(uint8_t channel, const sim_state_t &state);
+};
+
+#endif // SIM_MAX11611_H
@@ -0,0 +1,84 @@
+#include "SimMcp79410.h"
+#include "Utils.h"
+
+#include <time.h>
+
+#define SIM_RTC_TIME_SIZE 7
+#define SIM_RTC_ST_BIT 0x80
+#define SIM_RTC_OSCRUN_BIT 0x20
+
+// Mask of the BCD value in each time register
+const uint8_t SIM_RTC_TIME_MASKS[SIM_RTC_TIME_SIZE] = {0x7F, 0x7F, 0x3F, 0x07, 0x3F, 0x1F, 0xFF};
+
+// The RTC is battery backed: it starts running at the time of the host, in UTC
+SimMcp79410::SimMcp79410() : SimRegisterDevice(simRtc), _timeSet(std::chrono::steady_clock::now())
+{
+    time_t now = time(nullptr);
+    struct tm t;
+    gmtime_r(&now, &t);
+
+    _registers[0] = DECToBCD(t.tm_sec) | SIM_RTC_ST_BIT;
+    _registers[1] = DECToBCD(t.tm_min);
+    _registers[2] = DECToBCD(t.tm_hour);
+    _registers[3] = t.tm_wday + 1;
+    _registers[4] = DECToBCD(t.tm_mday);
+    _registers[5] = DECToBCD(t.tm_mon + 1);
+    _registers[6] = DECToBCD(t.tm_year % 100);
+}
+
+void SimMcp79410::BeginRead(uint8_t regAddr)
+{
+    for (uint8_t i = 0; i < SIM_RTC_TIME_SIZE; i++)
+    {
+        _time[i] = _registers[i];
+    }
+    if (!(_registers[0] & SIM_RTC_ST_BIT))
+    {
+        return;
+    }
+
+    struct tm t = {0};
+    t.tm_sec = BCDToDEC(_registers[0] & SIM_RTC_TIME_MASKS[0]);
+    t.tm_min = BCDToDEC(_registers[1] & SIM_RTC_TIME_MASKS[1]);
+    t.tm_hour = BCDToDEC(_registers[2] & SIM_RTC_TIME_MASKS[2]);
+    t.tm_mday = BCDToDEC(_registers[4] & SIM_RTC_TIME_MASKS[4]);
+    t.tm_mon = BCDToDEC(_registers[5] & SIM_RTC_TIME_MASKS[5]) - 1;
+    t.tm_year = BCDToDEC(_registers[6]) + 100;
+
+    time_t now = timegm(&t) + std::chrono::duration_cast<std::chrono::seconds>(std::chrono::steady_clock::now() - _timeSet).count();
+    gmtime_r(&now, &t);
+
+    const uint8_t values[SIM_RTC_TIME_SIZE] = {
+        static_cast<uint8_t>(DECToBCD(t.tm_sec)), static_cast<uint8_t>(DECToBCD(t.tm_min)),
+        static_cast<uint8_t>(DECToBCD(t.tm_hour)), static_cast<uint8_t>(t.tm_wday + 1),
+        static_cast<uint8_t>(DECToBCD(t.tm_mday)), static_cast<uint8_t>(DECToBCD(t.tm_mon + 1)),
+        static_cast<uint8_t>(DECToBCD(t.tm_year % 100))};
+    for (uint8_t i = 0; i < SIM_RTC_TIME_SIZE; i++)
+    {
+        _time[i] = (_registers[i] & ~SIM_RTC_TIME_MASKS[i]) | (values[i] & SIM_RTC_TIME_MASKS[i]);
+    }
+    _time[3] |= SIM_RTC_OSCRUN_BIT;
+}
+
+uint8_t SimMcp79410::ReadRegister(uint8_t regAddr)
+{
+    if (regAddr < SIM_RTC_TIME_SIZE)
+    {
+        return _time[regAddr];
+    }
+    return regAddr < sizeof(_registers) ? _registers[regAddr] : 0;
+}
+
+void SimMcp79410::WriteRegister(uint8_t regAddr, uint8_t value)
+{
+    if (regAddr >= sizeof(_registers))
+    {
+        return;
+    }
+    if (regAddr < SIM_RTC_TIME_SIZE)
+    {
+        // The time counts from the last write
+        _timeSet = std::chrono::steady_clock::now();
+    }
+    _registers[regAddr] = value;
+}
@@ -0,0 +1,26 @@
+#ifndef SIM_MCP79410_H
+#define SIM_MCP79410_H
+
+#include "SimDevice.h"
+#include <chrono>
+
+// MCP79410 RTC. The time registers count from the last time they were written
+// while the oscillator (ST bit) is running; the other registers and the SRAM
+// keep what is written to them.
+class SimMcp79410 : public SimRegisterDevice
+{
+  public:
+    SimMcp79410();
+
+  protected:
+    void BeginRead(uint8_t regAddr);
+    uint8_t ReadRegister(uint8_t regAddr);
+    void WriteRegister(uint8_t regAddr, uint8_t value);
+
+  private:
+    uint8_t _registers[0x60] = {};
+    uint8_t _time[7] = {};
+    std::chrono::steady_clock::time_point _timeSet;
+};
+
+#endif // SIM_MCP79410_H
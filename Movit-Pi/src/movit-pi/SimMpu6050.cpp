@@ -0,0 +1,311 @@
+#include "SimMpu6050.h"
+#include "MPU6050.h"
+#include "SimGpioEventLine.h"
+#include "SysTime.h"
+#include "Utils.h"
+
+#include <algorithm>
+#include <math.h>
+#include <string.h>
+
+#define SIM_MPU6050_REGISTER_COUNT 128
+#define SIM_MPU6050_FIFO_SIZE 1024
+#define SIM_MPU6050_DMP_RATE_DIVIDER 2 // Default of the MotionApps 6.12 firmware
+#define SIM_MPU6050_INTERRUPT_DELAY 50 // Microseconds between a sample and its interrupt
+
+SimMpu6050::SimMpu6050(SimDeviceId deviceId, const int16_t *accelBias, const int16_t *gyroBias, int interruptLine)
+    : SimRegisterDevice(deviceId), _deviceId(deviceId), _interruptLine(interruptLine)
+{
+    for (uint8_t i = 0; i < 3; i++)
+    {
+        _accelBias[i] = accelBias[i];
+        _gyroBias[i] = gyroBias[i];
+    }
+    Reset();
+}
+
+SimMpu6050::~SimMpu6050()
+{
+    if (_interruptLine >= 0)
+    {
+        SimGpio::GetInstance()->SetPeriodicEdges(static_cast<unsigned>(_interruptLine), std::chrono::steady_clock::now(), std::chrono::microseconds(0));
+    }
+}
+
+void SimMpu6050::Reset()
+{
+    memset(_registers, 0, sizeof(_registers));
+    _registers[MPU6050_RA_PWR_MGMT_1] = 0x40; // Sleep
+    _registers[MPU6050_RA_WHO_AM_I] = 0x68;
+    _fifo.clear();
+    memset(_memory, 0, sizeof(_memory));
+    UpdateInterrupt();
+}
+
+int16_t SimMpu6050::GetRegisterWord(uint8_t regAddr)
+{
+    return static_cast<int16_t>((_registers[regAddr] << 8) | _registers[regAddr + 1]);
+}
+
+void SimMpu6050::SetRegisterWord(uint8_t regAddr, int32_t value)
+{
+    value = std::max(-32768, std::min(32767, value));
+    _registers[regAddr] = static_cast<uint8_t>(value >> 8);
+    _registers[regAddr + 1] = static_cast<uint8_t>(value);
+}
+
+void SimMpu6050::BeginRead(uint8_t regAddr)
+{
+    UpdateFifo();
+
+    if (regAddr >= MPU6050_RA_ACCEL_XOUT_H && regAddr <= MPU6050_RA_GYRO_ZOUT_L)
+    {
+        LatchOutputs();
+    }
+    else if (regAddr == MPU6050_RA_FIFO_COUNTH)
+    {
+        _registers[MPU6050_RA_FIFO_COUNTH] = static_cast<uint8_t>(_fifo.size() >> 8);
+        _registers[MPU6050_RA_FIFO_COUNTL] = static_cast<uint8_t>(_fifo.size());
+    }
+}
+
+// Period of the samples written to the FIFO
+std::chrono::microseconds SimMpu6050::GetSamplePeriod()
+{
+    // The gyroscope output rate is 8 kHz without the low-pass filter
+    const uint8_t dlpfMode = _registers[MPU6050_RA_CONFIG] & 0x07;
+    const uint32_t outputRate = (dlpfMode == 0 || dlpfMode == 7) ? 8000 : 1000;
+    const bool isDmpEnabled = _registers[MPU6050_RA_USER_CTRL] & (1 << MPU6050_USERCTRL_DMP_EN_BIT);
+    const uint32_t divider = isDmpEnabled ? SIM_MPU6050_DMP_RATE_DIVIDER : 1;
+    return std::chrono::microseconds((_registers[MPU6050_RA_SMPLRT_DIV] + 1) * divider * SECONDS_TO_MICROSECONDS / outputRate);
+}
+
+// Follows the configuration of the sample rate and of the interrupts. The
+// edges are raised on time by the simulated GPIO, not by the bus accesses.
+void SimMpu6050::UpdateInterrupt()
+{
+    if (_interruptLine < 0)
+    {
+        return;
+    }
+
+    const uint8_t enabled = _registers[MPU6050_RA_INT_ENABLE];
+    const bool isDmpEnabled = _registers[MPU6050_RA_USER_CTRL] & (1 << MPU6050_USERCTRL_DMP_EN_BIT);
+    const bool isFifoEnabled = _registers[MPU6050_RA_USER_CTRL] & (1 << MPU6050_USERCTRL_FIFO_EN_BIT);
+    const bool isDataReady = (enabled & (1 << MPU6050_INTERRUPT_DATA_RDY_BIT)) && !isDmpEnabled;
+    const bool isDmpReady = (enabled & (1 << MPU6050_INTERRUPT_DMP_INT_BIT)) && isDmpEnabled;
+
+    std::chrono::microseconds period(0);
+    std::chrono::steady_clock::time_point first = std::chrono::steady_clock::now();
+    if (isDataReady || isDmpReady)
+    {
+        period = GetSamplePeriod();
+        if (isFifoEnabled)
+        {
+            first = _nextSampleTime;
+        }
+        first += std::chrono::microseconds(SIM_MPU6050_INTERRUPT_DELAY);
+    }
+    SimGpio::GetInstance()->SetPeriodicEdges(static_cast<unsigned>(_interruptLine), first, period);
+}
+
+void SimMpu6050::UpdateFifo()
+{
+    if (!(_registers[MPU6050_RA_USER_CTRL] & (1 << MPU6050_USERCTRL_FIFO_EN_BIT)))
+    {
+        return;
+    }
+
+    const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    const std::chrono::microseconds period = GetSamplePeriod();
+    const bool isDmpEnabled = _registers[MPU6050_RA_USER_CTRL] & (1 << MPU6050_USERCTRL_DMP_EN_BIT);
+
+    // Only the samples that can still be in the FIFO are generated
+    if (now - _nextSampleTime > period * SIM_MPU6050_FIFO_SIZE)
+    {
+        _nextSampleTime = now - period * SIM_MPU6050_FIFO_SIZE;
+        _registers[MPU6050_RA_INT_STATUS] |= 1 << MPU6050_INTERRUPT_FIFO_OFLOW_BIT;
+    }
+
+    const uint8_t enabled = _registers[MPU6050_RA_FIFO_EN];
+    for (; _nextSampleTime <= now; _nextSampleTime += period)
+    {
+        LatchOutputs();
+
+        if (isDmpEnabled)
+        {
+            PushDmpPacket();
+            continue;
+        }
+
+        // Written in the order of the register numbers
+        uint8_t regAddr[8];
+        uint8_t count = 0;
+        if (enabled & (1 << MPU6050_ACCEL_FIFO_EN_BIT))
+        {
+            regAddr[count++] = MPU6050_RA_ACCEL_XOUT_H;
+            regAddr[count++] = MPU6050_RA_ACCEL_YOUT_H;
+            regAddr[count++] = MPU6050_RA_ACCEL_ZOUT_H;
+        }
+        if (enabled & (1 << MPU6050_TEMP_FIFO_EN_BIT))
+        {
+            regAddr[count++] = MPU6050_RA_TEMP_OUT_H;
+        }
+        for (uint8_t axis = 0; axis < 3; axis++)
+        {
+            if (enabled & (1 << (MPU6050_XG_FIFO_EN_BIT - axis)))
+            {
+                regAddr[count++] = MPU6050_RA_GYRO_XOUT_H + 2 * axis;
+            }
+        }
+
+        for (uint8_t i = 0; i < count; i++)
+        {
+            PushFifo(_registers[regAddr[i]]);
+            PushFifo(_registers[regAddr[i] + 1]);
+        }
+    }
+}
+
+void SimMpu6050::PushFifo(uint8_t value)
+{
+    _fifo.push_back(value);
+    if (_fifo.size() > SIM_MPU6050_FIFO_SIZE)
+    {
+        _fifo.pop_front();
+        _registers[MPU6050_RA_INT_STATUS] |= 1 << MPU6050_INTERRUPT_FIFO_OFLOW_BIT;
+    }
+}
+
+void SimMpu6050::PushDmpPacket()
+{
+    // Rotation of -(pitch + 90 degrees) around the y axis, which gives the
+    // direction of gravity of LatchOutputs(). The firmware itself is not run.
+    const float angle = -(_pitch + M_PI / 2);
+    const float quaternion[4] = {cosf(angle / 2), 0.0f, sinf(angle / 2), 0.0f};
+    for (uint8_t i = 0; i < 4; i++)
+    {
+        int32_t value = static_cast<int32_t>(quaternion[i] * 1073741823.0f); // Q30
+        for (int8_t shift = 24; shift >= 0; shift -= 8)
+        {
+            PushFifo(static_cast<uint8_t>(value >> shift));
+        }
+    }
+    for (uint8_t regAddr = MPU6050_RA_ACCEL_XOUT_H; regAddr <= MPU6050_RA_ACCEL_ZOUT_L; regAddr++)
+    {
+        PushFifo(_registers[regAddr]);
+    }
+    for (uint8_t regAddr = MPU6050_RA_GYRO_XOUT_H; regAddr <= MPU6050_RA_GYRO_ZOUT_L; regAddr++)
+    {
+        PushFifo(_registers[regAddr]);
+    }
+}
+
+void SimMpu6050::LatchOutputs()
+{
+    SimWorld *world = SimWorld::GetInstance();
+    sim_state_t state = world->GetState();
+
+    float pitch = state.tiltAngle;
+    if (_deviceId == simMobileImu)
+    {
+        pitch += state.reclineAngle;
+    }
+    pitch /= RADIANS_TO_DEGREES;
+    _pitch = pitch;
+
+    const uint8_t accelRange = (_registers[MPU6050_RA_ACCEL_CONFIG] >> 3) & 0x03;
+    const uint8_t gyroRange = (_registers[MPU6050_RA_GYRO_CONFIG] >> 3) & 0x03;
+    const float lsbPerG = 16384 >> accelRange;
+    const float accelOffsetScale = 8.0f / (1 << accelRange);
+    const float gyroOffsetScale = 4.0f / (1 << gyroRange);
+    const float vibration = state.isMoving ? 0.1f : 0.0f;
+
+    const float gravity[3] = {cosf(pitch), 0.0f, -sinf(pitch)};
+    for (uint8_t axis = 0; axis < 3; axis++)
+    {
+        float acceleration = (gravity[axis] + world->Noise(vibration)) * lsbPerG + _accelBias[axis] + world->Noise(4);
+        acceleration += GetRegisterWord(MPU6050_RA_XA_OFFS_H + 2 * axis) * accelOffsetScale;
+        SetRegisterWord(MPU6050_RA_ACCEL_XOUT_H + 2 * axis, static_cast<int32_t>(acceleration));
+
+        float rotation = _gyroBias[axis] + world->Noise(state.isMoving ? 200 : 2);
+        rotation += GetRegisterWord(MPU6050_RA_XG_OFFS_USRH + 2 * axis) * gyroOffsetScale;
+        SetRegisterWord(MPU6050_RA_GYRO_XOUT_H + 2 * axis, static_cast<int32_t>(rotation));
+    }
+    SetRegisterWord(MPU6050_RA_TEMP_OUT_H, static_cast<int32_t>((25.0f - 36.53f) * 340));
+}
+
+uint8_t SimMpu6050::ReadRegister(uint8_t regAddr)
+{
+    if (regAddr == MPU6050_RA_FIFO_R_W)
+    {
+        // An empty FIFO returns the last byte read
+        if (!_fifo.empty())
+        {
+            _lastFifoByte = _fifo.front();
+            _fifo.pop_front();
+        }
+        return _lastFifoByte;
+    }
+    if (regAddr == MPU6050_RA_MEM_R_W)
+    {
+        return _memory[GetMemoryAddress()];
+    }
+    if (regAddr == MPU6050_RA_INT_STATUS)
+    {
+        // Cleared by the read
+        uint8_t status = _registers[regAddr];
+        _registers[regAddr] = 0;
+        return status;
+    }
+    return regAddr < SIM_MPU6050_REGISTER_COUNT ? _registers[regAddr] : 0;
+}
+
+uint8_t SimMpu6050::GetNextRegister(uint8_t regAddr)
+{
+    return regAddr == MPU6050_RA_FIFO_R_W || regAddr == MPU6050_RA_MEM_R_W ? regAddr : regAddr + 1;
+}
+
+uint16_t SimMpu6050::GetMemoryAddress()
+{
+    // The address is incremented by each access, within the bank
+    const uint16_t bank = _registers[MPU6050_RA_BANK_SEL] & 0x1F;
+    return ((bank << 8) | _registers[MPU6050_RA_MEM_START_ADDR]++) % sizeof(_memory);
+}
+
+void SimMpu6050::WriteRegister(uint8_t regAddr, uint8_t value)
+{
+    if (regAddr == MPU6050_RA_PWR_MGMT_1 && (value & (1 << MPU6050_PWR1_DEVICE_RESET_BIT)))
+    {
+        Reset();
+        return;
+    }
+    if (regAddr == MPU6050_RA_MEM_R_W)
+    {
+        _memory[GetMemoryAddress()] = value;
+        return;
+    }
+    if (regAddr == MPU6050_RA_USER_CTRL)
+    {
+        if (value & (1 << MPU6050_USERCTRL_FIFO_RESET_BIT))
+        {
+            _fifo.clear();
+            value &= ~(1 << MPU6050_USERCTRL_FIFO_RESET_BIT);
+        }
+    }
+    if (regAddr < SIM_MPU6050_REGISTER_COUNT && regAddr != MPU6050_RA_WHO_AM_I)
+    {
+        const uint8_t previous = _registers[regAddr];
+        _registers[regAddr] = value;
+
+        if (regAddr == MPU6050_RA_USER_CTRL && (value & ~previous) & (1 << MPU6050_USERCTRL_FIFO_EN_BIT))
+        {
+            _nextSampleTime = std::chrono::steady_clock::now() + GetSamplePeriod();
+        }
+        if (value != previous && (regAddr == MPU6050_RA_USER_CTRL || regAddr == MPU6050_RA_INT_ENABLE ||
+                                  regAddr == MPU6050_RA_SMPLRT_DIV || regAddr == MPU6050_RA_CONFIG))
+        {
+            UpdateInterrupt();
+        }
+    }
+}
@@ -0,0 +1,54 @@
+#ifndef SIM_MPU6050_H
+#define SIM_MPU6050_H
+
+#include "SimDevice.h"
+
+#include <chrono>
+#include <deque>
+
+// MPU6050 with its x axis vertical when the chair is level, like the fixed
+// and mobile IMUs. The seat tilt (and the recline for the backrest IMU)
+// rotates gravity in the x-z plane. The offset registers are applied with the
+// scaling expected by the calibration. The FIFO is filled with the sensor
+// outputs selected in FIFO_EN, at the configured sample rate, as the host time
+// goes by. With the DMP enabled, the FIFO receives the packets of the
+// MotionApps 6.12 firmware instead, computed from the simulated tilt. The
+// data ready and DMP interrupts pulse the simulated GPIO line of the INT pin,
+// when it is wired, shortly after each sample.
+class SimMpu6050 : public SimRegisterDevice
+{
+  public:
+    SimMpu6050(SimDeviceId deviceId, const int16_t *accelBias, const int16_t *gyroBias, int interruptLine = -1);
+    ~SimMpu6050();
+
+  protected:
+    void BeginRead(uint8_t regAddr);
+    uint8_t ReadRegister(uint8_t regAddr);
+    void WriteRegister(uint8_t regAddr, uint8_t value);
+    uint8_t GetNextRegister(uint8_t regAddr);
+
+  private:
+    void Reset();
+    int16_t GetRegisterWord(uint8_t regAddr);
+    void SetRegisterWord(uint8_t regAddr, int32_t value);
+    void LatchOutputs();
+    void UpdateFifo();
+    void PushFifo(uint8_t value);
+    void PushDmpPacket();
+    uint16_t GetMemoryAddress();
+    std::chrono::microseconds GetSamplePeriod();
+    void UpdateInterrupt();
+
+    SimDeviceId _deviceId;
+    int16_t _accelBias[3];
+    int16_t _gyroBias[3];
+    uint8_t _registers[128];
+    uint8_t _memory[16 * 256]; // DMP memory banks
+    float _pitch = 0;          // Of the last outputs, in radians
+    std::deque<uint8_t> _fifo;
+    uint8_t _lastFifoByte = 0;
+    std::chrono::steady_clock::time_point _nextSampleTime;
+    int _interruptLine;
+};
+
+#endif // SIM_MPU6050_H
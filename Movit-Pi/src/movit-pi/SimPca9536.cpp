@@ -0,0 +1,34 @@
+#include "SimPca9536.h"
+#include "PCA9536.h"
+
+SimPca9536::SimPca9536() : SimRegisterDevice(simAlarm)
+{
+}
+
+uint8_t SimPca9536::ReadRegister(uint8_t regAddr)
+{
+    if (regAddr != REG_INPUT)
+    {
+        return _registers[regAddr & 0x03];
+    }
+
+    bool isButtonPressed = SimWorld::GetInstance()->GetState().isButtonPressed;
+    uint8_t levels = 0xFF;
+    if (isButtonPressed)
+    {
+        levels &= ~(1 << PUSH_BUTTON);
+    }
+
+    // Output pins read back the level they drive
+    const uint8_t outputs = ~_registers[REG_CONFIG];
+    levels = (levels & ~outputs) | (_registers[REG_OUTPUT] & outputs);
+    return levels ^ _registers[REG_POLARITY];
+}
+
+void SimPca9536::WriteRegister(uint8_t regAddr, uint8_t value)
+{
+    if (regAddr != REG_INPUT)
+    {
+        _registers[regAddr & 0x03] = value;
+    }
+}
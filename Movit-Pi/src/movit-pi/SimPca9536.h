@@ -0,0 +1,21 @@
+#ifndef SIM_PCA9536_H
+#define SIM_PCA9536_H
+
+#include "SimDevice.h"
+
+// PCA9536 of the alarm module. The push button pulls its pin low when pressed,
+// the other input pins read high through their pull-up.
+class SimPca9536 : public SimRegisterDevice
+{
+  public:
+    SimPca9536();
+
+  protected:
+    uint8_t ReadRegister(uint8_t regAddr);
+    void WriteRegister(uint8_t regAddr, uint8_t value);
+
+  private:
+    uint8_t _registers[4] = {0xFF, 0xFF, 0x00, 0xFF};
+};
+
+#endif // SIM_PCA9536_H
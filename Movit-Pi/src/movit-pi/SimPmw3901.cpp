@@ -0,0 +1,39 @@
+#include "SimPmw3901.h"
+
+#define SIM_PMW3901_PRODUCT_ID 0x49
+#define SIM_PMW3901_INVERSE_PRODUCT_ID 0xB6
+#define SIM_PMW3901_MOVING_COUNTS 40
+
+uint8_t SimPmw3901::ReadRegister(uint8_t regAddr)
+{
+    switch (regAddr)
+    {
+    case 0x00:
+        return SIM_PMW3901_PRODUCT_ID;
+    case 0x5F:
+        return SIM_PMW3901_INVERSE_PRODUCT_ID;
+    case 0x02:
+    {
+        SimWorld *world = SimWorld::GetInstance();
+        bool isMoving = world->GetState().isMoving;
+        _deltaX = static_cast<int16_t>(world->Noise(isMoving ? SIM_PMW3901_MOVING_COUNTS : 1));
+        _deltaY = static_cast<int16_t>((isMoving ? SIM_PMW3901_MOVING_COUNTS : 0) + world->Noise(1));
+        return isMoving ? 0x80 : 0x00;
+    }
+    case 0x03:
+        return static_cast<uint8_t>(_deltaX);
+    case 0x04:
+        return static_cast<uint8_t>(_deltaX >> 8);
+    case 0x05:
+        return static_cast<uint8_t>(_deltaY);
+    case 0x06:
+        return static_cast<uint8_t>(_deltaY >> 8);
+    default:
+        return 0x00;
+    }
+}
+
+void SimPmw3901::WriteRegister(uint8_t regAddr, uint8_t value)
+{
+    // Configuration registers have no effect on the model
+}
@@ -0,0 +1,22 @@
+#ifndef SIM_PMW3901_H
+#define SIM_PMW3901_H
+
+#include "SimWorld.h"
+#include <stdint.h>
+
+// PMW3901 optical flow sensor. Reading the motion register latches the
+// displacement since the previous read, like on the real sensor.
+class SimPmw3901
+{
+  public:
+    bool IsConnected() { return SimWorld::GetInstance()->IsConnected(simFlowSensor); }
+
+    uint8_t ReadRegister(uint8_t regAddr);
+    void WriteRegister(uint8_t regAddr, uint8_t value);
+
+  private:
+    int16_t _deltaX = 0;
+    int16_t _deltaY = 0;
+};
+
+#endif // SIM_PMW3901_H
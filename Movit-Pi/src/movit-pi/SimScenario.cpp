@@ -0,0 +1,164 @@
+#include "SimScenario.h"
+#include "SimWorld.h"
+#include "SysTime.h"
+
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <stdio.h>
+#include <stdlib.h>
+
+SimScenario::~SimScenario()
+{
+    Stop();
+}
+
+bool SimScenario::Load(std::string fileName)
+{
+    std::ifstream file(fileName);
+    if (!file.is_open())
+    {
+        printf("Error: Unable to open the scenario %s\n", fileName.c_str());
+        return false;
+    }
+
+    _commands.clear();
+    std::string line;
+    uint32_t lineNumber = 0;
+    while (std::getline(file, line))
+    {
+        lineNumber++;
+        std::istringstream stream(line);
+        sim_command_t command;
+        if (line.empty() || line[0] == '#' || !(stream >> command.time))
+        {
+            continue;
+        }
+        if (!(stream >> command.name))
+        {
+            printf("Error: %s:%i, missing command\n", fileName.c_str(), lineNumber);
+            return false;
+        }
+
+        std::string argument;
+        while (stream >> argument)
+        {
+            command.arguments.push_back(argument);
+        }
+        _commands.push_back(command);
+    }
+    return true;
+}
+
+void SimScenario::Start()
+{
+    if (_commands.empty())
+    {
+        return;
+    }
+
+    _isRunning = true;
+    _thread = std::thread([=] { Run(); });
+}
+
+void SimScenario::Stop()
+{
+    _isRunning = false;
+    if (_thread.joinable())
+    {
+        // The "end" command exits from the scenario thread itself
+        if (std::this_thread::get_id() == _thread.get_id())
+        {
+            _thread.detach();
+        }
+        else
+        {
+            _thread.join();
+        }
+    }
+}
+
+void SimScenario::Run()
+{
+    auto start = std::chrono::steady_clock::now();
+
+    for (const sim_command_t &command : _commands)
+    {
+        while (_isRunning && std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() < command.time)
+        {
+            sleep_for_milliseconds(10);
+        }
+        if (!_isRunning)
+        {
+            return;
+        }
+
+        printf("Scenario %.1fs: %s\n", command.time, command.name.c_str());
+        if (!Apply(command))
+        {
+            printf("Error: Invalid scenario command %s\n", command.name.c_str());
+        }
+    }
+}
+
+bool SimScenario::Apply(const sim_command_t &command)
+{
+    SimWorld *world = SimWorld::GetInstance();
+    sim_state_t state = world->GetState();
+    const std::vector<std::string> &arguments = command.arguments;
+
+    if (command.name == "end")
+    {
+        exit(0);
+    }
+    if (arguments.empty())
+    {
+        return false;
+    }
+
+    if (command.name == "sit")
+    {
+        state.isSeated = atoi(arguments[0].c_str()) != 0;
+    }
+    else if (command.name == "lean" && arguments.size() == 2)
+    {
+        state.centerOfPressureX = atof(arguments[0].c_str());
+        state.centerOfPressureY = atof(arguments[1].c_str());
+    }
+    else if (command.name == "tilt")
+    {
+        state.tiltAngle = atof(arguments[0].c_str());
+    }
+    else if (command.name == "recline")
+    {
+        state.reclineAngle = atof(arguments[0].c_str());
+    }
+    else if (command.name == "move")
+    {
+        state.isMoving = atoi(arguments[0].c_str()) != 0;
+    }
+    else if (command.name == "button")
+    {
+        state.isButtonPressed = atoi(arguments[0].c_str()) != 0;
+    }
+    else if (command.name == "distance")
+    {
+        state.floorDistance = atoi(arguments[0].c_str());
+    }
+    else if (command.name == "unplug" || command.name == "plug")
+    {
+        SimDeviceId device;
+        if (!SimWorld::GetDeviceId(arguments[0], device))
+        {
+            return false;
+        }
+        state.isConnected[device] = command.name == "plug";
+    }
+    else
+    {
+        return false;
+    }
+
+    world->SetState(state);
+    return true;
+}
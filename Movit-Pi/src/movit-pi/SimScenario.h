@@ -0,0 +1,47 @@
+#ifndef SIM_SCENARIO_H
+#define SIM_SCENARIO_H
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Timed list of changes applied to the simulated world. One command per line,
+// blank lines and lines starting with '#' are ignored:
+//
+//   <seconds> sit <0|1>              User seated or not
+//   <seconds> lean <x> <y>           Center of pressure, from -1 to 1
+//   <seconds> tilt <degrees>         Seat tilt
+//   <seconds> recline <degrees>      Backrest angle relative to the seat
+//   <seconds> move <0|1>             Chair rolling
+//   <seconds> button <0|1>           Alarm push button pressed
+//   <seconds> distance <mm>          Range sensor to floor distance
+//   <seconds> unplug <device>        fixedImu, mobileImu, pressureMat, alarm,
+//   <seconds> plug <device>          rtc, rangeSensor, flowSensor or frameImu
+//   <seconds> end                    Stops the program
+class SimScenario
+{
+  public:
+    ~SimScenario();
+
+    bool Load(std::string fileName);
+    void Start();
+    void Stop();
+
+  private:
+    struct sim_command_t
+    {
+        double time;
+        std::string name;
+        std::vector<std::string> arguments;
+    };
+
+    bool Apply(const sim_command_t &command);
+    void Run();
+
+    std::vector<sim_command_t> _commands;
+    std::thread _thread;
+    std::atomic<bool> _isRunning{false};
+};
+
+#endif // SIM_SCENARIO_H
@@ -0,0 +1,44 @@
+#include "SimSpiBackend.h"
+
+bool SimSpiBackend::Open()
+{
+    return true;
+}
+
+void SimSpiBackend::Close()
+{
+}
+
+void SimSpiBackend::SetupChipSelect(uint8_t pin)
+{
+}
+
+void SimSpiBackend::Select(uint8_t pin)
+{
+    _index = 0;
+}
+
+void SimSpiBackend::Deselect(uint8_t pin)
+{
+}
+
+uint8_t SimSpiBackend::Transfer(uint8_t data)
+{
+    if (!_pmw3901.IsConnected())
+    {
+        return 0xFF; // MISO floating high
+    }
+
+    if (_index++ == 0)
+    {
+        _regAddr = data;
+        return 0x00;
+    }
+
+    if (_regAddr & 0x80)
+    {
+        _pmw3901.WriteRegister(_regAddr & 0x7F, data);
+        return 0x00;
+    }
+    return _pmw3901.ReadRegister(_regAddr);
+}
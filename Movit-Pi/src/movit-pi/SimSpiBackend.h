@@ -0,0 +1,26 @@
+#ifndef SIM_SPI_BACKEND_H
+#define SIM_SPI_BACKEND_H
+
+#include "SimPmw3901.h"
+#include "SpiBackend.h"
+
+// SPI bus with the PMW3901 model. The first byte of a transaction is the
+// register address (bit 7 set for a write), the second one is the data.
+class SimSpiBackend : public SpiBackend
+{
+  public:
+    bool Open();
+    void Close();
+
+    void SetupChipSelect(uint8_t pin);
+    void Select(uint8_t pin);
+    void Deselect(uint8_t pin);
+    uint8_t Transfer(uint8_t data);
+
+  private:
+    SimPmw3901 _pmw3901;
+    uint8_t _index = 0;
+    uint8_t _regAddr = 0;
+};
+
+#endif // SIM_SPI_BACKEND_H
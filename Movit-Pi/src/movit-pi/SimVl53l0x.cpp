@@ -0,0 +1,60 @@
+#include "SimVl53l0x.h"
+#include "VL53L0X.h"
+
+#define SIM_VL53L0X_PAGE_SELECT 0xFF
+#define SIM_VL53L0X_SPAD_INFO_READY 0x83
+#define SIM_VL53L0X_SPAD_INFO 0x92
+#define SIM_VL53L0X_RANGE_RESULT (VL53L0X::RESULT_RANGE_STATUS + 10)
+#define SIM_VL53L0X_OUT_OF_RANGE 8190
+
+SimVl53l0x::SimVl53l0x() : SimRegisterDevice(simRangeSensor)
+{
+    _registers[0][VL53L0X::IDENTIFICATION_MODEL_ID] = 0xEE;
+    _registers[0][VL53L0X::PRE_RANGE_CONFIG_VCSEL_PERIOD] = 0x06;
+    _registers[0][VL53L0X::FINAL_RANGE_CONFIG_VCSEL_PERIOD] = 0x04;
+    _registers[1][SIM_VL53L0X_SPAD_INFO] = 0x86; // Aperture SPADs, 6 reference SPADs
+    _registers[0][VL53L0X::GLOBAL_CONFIG_SPAD_ENABLES_REF_0] = 0xFF;
+}
+
+void SimVl53l0x::BeginRead(uint8_t regAddr)
+{
+    if (_page == 0 && regAddr >= VL53L0X::RESULT_RANGE_STATUS && regAddr <= SIM_VL53L0X_RANGE_RESULT + 1)
+    {
+        sim_state_t state = SimWorld::GetInstance()->GetState();
+        float range = state.floorDistance + SimWorld::GetInstance()->Noise(state.isMoving ? 15 : 3);
+        _range = range > 0 && range < SIM_VL53L0X_OUT_OF_RANGE ? static_cast<uint16_t>(range) : SIM_VL53L0X_OUT_OF_RANGE;
+    }
+}
+
+uint8_t SimVl53l0x::ReadRegister(uint8_t regAddr)
+{
+    if (_page == 0)
+    {
+        switch (regAddr)
+        {
+        case VL53L0X::SYSRANGE_START:
+            return 0x00; // Measurement started right away
+        case VL53L0X::RESULT_INTERRUPT_STATUS:
+            return 0x07; // New sample ready
+        case SIM_VL53L0X_RANGE_RESULT:
+            return static_cast<uint8_t>(_range >> 8);
+        case SIM_VL53L0X_RANGE_RESULT + 1:
+            return static_cast<uint8_t>(_range);
+        }
+    }
+    else if (regAddr == SIM_VL53L0X_SPAD_INFO_READY)
+    {
+        return _registers[1][regAddr] | 0x10;
+    }
+    return _registers[_page][regAddr];
+}
+
+void SimVl53l0x::WriteRegister(uint8_t regAddr, uint8_t value)
+{
+    if (regAddr == SIM_VL53L0X_PAGE_SELECT)
+    {
+        _page = value & 0x01;
+        return;
+    }
+    _registers[_page][regAddr] = value;
+}
@@ -0,0 +1,25 @@
+#ifndef SIM_VL53L0X_H
+#define SIM_VL53L0X_H
+
+#include "SimDevice.h"
+
+// VL53L0X answering the initialization sequence of the driver and returning
+// the distance to the floor. Register 0xFF selects the register page, as on
+// the real sensor; measurements are always ready.
+class SimVl53l0x : public SimRegisterDevice
+{
+  public:
+    SimVl53l0x();
+
+  protected:
+    void BeginRead(uint8_t regAddr);
+    uint8_t ReadRegister(uint8_t regAddr);
+    void WriteRegister(uint8_t regAddr, uint8_t value);
+
+  private:
+    uint8_t _registers[2][256] = {};
+    uint8_t _page = 0;
+    uint16_t _range = 0;
+};
+
+#endif // SIM_VL53L0X_H
@@ -0,0 +1,41 @@
+#include "SimWorld.h"
+
+const char *SIM_DEVICE_NAMES[simDeviceCount] = {"fixedImu", "mobileImu", "pressureMat", "alarm", "rtc", "rangeSensor", "flowSensor", "frameImu"};
+
+sim_state_t SimWorld::GetState()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _state;
+}
+
+void SimWorld::SetState(const sim_state_t &state)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _state = state;
+}
+
+bool SimWorld::IsConnected(SimDeviceId device)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _state.isConnected[device];
+}
+
+float SimWorld::Noise(float amplitude)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    std::uniform_real_distribution<float> distribution(-amplitude, amplitude);
+    return distribution(_random);
+}
+
+bool SimWorld::GetDeviceId(std::string name, SimDeviceId &device)
+{
+    for (uint8_t i = 0; i < simDeviceCount; i++)
+    {
+        if (name == SIM_DEVICE_NAMES[i])
+        {
+            device = static_cast<SimDeviceId>(i);
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,66 @@
+#ifndef SIM_WORLD_H
+#define SIM_WORLD_H
+
+#include <mutex>
+#include <random>
+#include <stdint.h>
+#include <string>
+
+enum SimDeviceId
+{
+    simFixedImu = 0,
+    simMobileImu,
+    simPressureMat,
+    simAlarm,
+    simRtc,
+    simRangeSensor,
+    simFlowSensor,
+    simFrameImu, // Behind the I2C mux, unplugged unless a scenario plugs it
+    simDeviceCount
+};
+
+// Physical state of the chair seen by the simulated devices
+struct sim_state_t
+{
+    bool isSeated = true;
+    float centerOfPressureX = 0; // -1 (left) to 1 (right)
+    float centerOfPressureY = 0; // -1 (back) to 1 (front)
+    float tiltAngle = 0;         // Seat tilt, in degrees
+    float reclineAngle = 0;      // Backrest angle relative to the seat, in degrees
+    bool isMoving = false;
+    bool isButtonPressed = false;
+    uint16_t floorDistance = 120; // In millimeters
+    bool isConnected[simDeviceCount] = {true, true, true, true, true, true, true, false};
+};
+
+// Shared by the device models and the scenario that drives them
+class SimWorld
+{
+  public:
+    static SimWorld *GetInstance()
+    {
+        static SimWorld instance;
+        return &instance;
+    }
+
+    sim_state_t GetState();
+    void SetState(const sim_state_t &state);
+    bool IsConnected(SimDeviceId device);
+
+    // Uniform noise in [-amplitude, amplitude], from a fixed seed so that runs
+    // of the same scenario are reproducible
+    float Noise(float amplitude);
+
+    static bool GetDeviceId(std::string name, SimDeviceId &device);
+
+  private:
+    SimWorld() : _random(42) {}
+    SimWorld(SimWorld const &);       // Don't Implement.
+    void operator=(SimWorld const &); // Don't implement.
+
+    std::mutex _mutex;
+    sim_state_t _state;
+    std::mt19937 _random;
+};
+
+#endif // SIM_WORLD_H
@@ -0,0 +1,29 @@
+#ifndef SPI_BACKEND_H
+#define SPI_BACKEND_H
+
+#include <stdint.h>
+
+enum SpiBackendType
+{
+    bcm2835SpiBackend,
+    replaySpiBackend,
+    simSpiBackend
+};
+
+// SPI bus with software chip select. A transaction is framed by Select() and
+// Deselect(), and every Transfer() clocks one byte out and one byte in.
+class SpiBackend
+{
+  public:
+    virtual ~SpiBackend() = default;
+
+    virtual bool Open() = 0;
+    virtual void Close() = 0;
+
+    virtual void SetupChipSelect(uint8_t pin) = 0;
+    virtual void Select(uint8_t pin) = 0;
+    virtual void Deselect(uint8_t pin) = 0;
+    virtual uint8_t Transfer(uint8_t data) = 0;
+};
+
+#endif // SPI_BACKEND_H
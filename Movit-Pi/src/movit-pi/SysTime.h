@@ -10,3 +10,4 @@ void sleep_for_milliseconds(uint32_t milliseconds);
 void sleep_for_seconds(uint32_t seconds);
 
 const double RUNNING_FREQUENCY = 10.0f; // Hz
+const uint32_t I2C_STATISTICS_PERIOD = 60; // seconds
@@ -0,0 +1,17 @@
+#ifndef TCA9548A_H
+#define TCA9548A_H
+
+// TCA9548A 8-channel I2C multiplexer. The control register, written without a
+// register address, has one bit per channel. A channel is connected to the bus
+// after the stop condition of the write, so the selection cannot share a
+// combined transaction with the accesses to the devices behind it.
+// The mux itself is driven by I2Cdev, see I2Cdev::GetMuxChannel().
+
+#define TCA9548A_BASE_ADDRESS 0x70 // A2 A1 A0 select 0x70 to 0x77
+#define TCA9548A_DEFAULT_ADDRESS TCA9548A_BASE_ADDRESS
+#define TCA9548A_COUNT 8
+#define TCA9548A_CHANNEL_COUNT 8
+#define TCA9548A_NO_CHANNEL 0x00   // Power-on state, every channel disconnected
+#define TCA9548A_ALL_CHANNELS 0xFF // Also assumed when the state of the mux is unknown
+
+#endif // TCA9548A_H
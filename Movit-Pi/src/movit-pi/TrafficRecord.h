@@ -0,0 +1,38 @@
+#ifndef TRAFFIC_RECORD_H
+#define TRAFFIC_RECORD_H
+
+#include <stdint.h>
+
+// Binary format of the bus traffic captures. A capture is a header followed by
+// variable length records, each one immediately followed by its payload. All
+// fields are little-endian and packed, so a capture can be memory-mapped and
+// walked in place.
+
+#define TRAFFIC_FILE_MAGIC 0x5446564D // "MVFT"
+#define TRAFFIC_FILE_VERSION 1
+
+// Channels 0 to 0x7F are I2C bus ids, channel 0x80 is the SPI bus
+#define TRAFFIC_SPI_CHANNEL 0x80
+
+#define TRAFFIC_FLAG_READ 0x01    // Payload was received from the device
+#define TRAFFIC_FLAG_SUCCESS 0x02 // The transaction holding this record succeeded
+#define TRAFFIC_FLAG_LAST 0x04    // Last record of its transaction
+
+struct __attribute__((packed)) traffic_file_header_t
+{
+    uint32_t magic;
+    uint16_t version;
+    uint16_t reserved;
+};
+
+struct __attribute__((packed)) traffic_record_t
+{
+    uint64_t timestamp; // Microseconds since the start of the capture
+    uint8_t channel;
+    uint8_t address;    // I2C slave address or SPI chip select pin
+    uint8_t regAddr;    // First byte written in the transaction
+    uint8_t flags;
+    uint16_t length;    // Payload length
+};
+
+#endif // TRAFFIC_RECORD_H
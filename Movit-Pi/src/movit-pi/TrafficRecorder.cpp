@@ -0,0 +1,65 @@
+#include "TrafficRecorder.h"
+
+#define TRAFFIC_WRITE_BUFFER_SIZE 65536
+
+TrafficRecorder::TrafficRecorder(std::string fileName) : _fileName(fileName)
+{
+}
+
+TrafficRecorder::~TrafficRecorder()
+{
+    Close();
+}
+
+bool TrafficRecorder::Open()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    _file = fopen(_fileName.c_str(), "wb");
+    if (_file == nullptr)
+    {
+        printf("Error: Unable to create the capture %s\n", _fileName.c_str());
+        return false;
+    }
+    setvbuf(_file, nullptr, _IOFBF, TRAFFIC_WRITE_BUFFER_SIZE);
+
+    traffic_file_header_t header = {TRAFFIC_FILE_MAGIC, TRAFFIC_FILE_VERSION, 0};
+    fwrite(&header, sizeof(header), 1, _file);
+    _start = std::chrono::steady_clock::now();
+    return true;
+}
+
+void TrafficRecorder::Close()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if (_file != nullptr)
+    {
+        fclose(_file);
+        _file = nullptr;
+    }
+}
+
+void TrafficRecorder::Write(uint8_t channel, uint8_t address, uint8_t regAddr, uint8_t flags, const uint8_t *payload, uint16_t length)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if (_file == nullptr)
+    {
+        return;
+    }
+
+    traffic_record_t record;
+    record.timestamp = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - _start).count();
+    record.channel = channel;
+    record.address = address;
+    record.regAddr = regAddr;
+    record.flags = flags;
+    record.length = length;
+
+    fwrite(&record, sizeof(record), 1, _file);
+    if (length > 0)
+    {
+        fwrite(payload, 1, length, _file);
+    }
+}
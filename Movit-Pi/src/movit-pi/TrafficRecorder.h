@@ -0,0 +1,30 @@
+#ifndef TRAFFIC_RECORDER_H
+#define TRAFFIC_RECORDER_H
+
+#include "TrafficRecord.h"
+#include <chrono>
+#include <mutex>
+#include <stdio.h>
+#include <string>
+
+// Appends bus transactions to a capture file. Shared by the recording
+// backends of every bus, records are written in the order they complete.
+class TrafficRecorder
+{
+  public:
+    TrafficRecorder(std::string fileName);
+    ~TrafficRecorder();
+
+    bool Open();
+    void Close();
+
+    void Write(uint8_t channel, uint8_t address, uint8_t regAddr, uint8_t flags, const uint8_t *payload, uint16_t length);
+
+  private:
+    std::string _fileName;
+    FILE *_file = nullptr;
+    std::mutex _mutex;
+    std::chrono::steady_clock::time_point _start;
+};
+
+#endif // TRAFFIC_RECORDER_H
@@ -0,0 +1,109 @@
+#include "TrafficReplay.h"
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+TrafficReplay::TrafficReplay(std::string fileName) : _fileName(fileName)
+{
+}
+
+TrafficReplay::~TrafficReplay()
+{
+    Close();
+}
+
+bool TrafficReplay::Open()
+{
+    Close();
+
+    int fd = open(_fileName.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        printf("Error: Unable to open the capture %s\n", _fileName.c_str());
+        return false;
+    }
+
+    struct stat status;
+    if (fstat(fd, &status) < 0 || static_cast<size_t>(status.st_size) < sizeof(traffic_file_header_t))
+    {
+        printf("Error: Invalid capture %s\n", _fileName.c_str());
+        close(fd);
+        return false;
+    }
+
+    void *data = mmap(nullptr, status.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED)
+    {
+        printf("Error: Unable to map the capture %s\n", _fileName.c_str());
+        return false;
+    }
+    madvise(data, status.st_size, MADV_SEQUENTIAL);
+
+    const traffic_file_header_t *header = static_cast<const traffic_file_header_t *>(data);
+    if (header->magic != TRAFFIC_FILE_MAGIC || header->version != TRAFFIC_FILE_VERSION)
+    {
+        printf("Error: %s is not a capture of this version\n", _fileName.c_str());
+        munmap(data, status.st_size);
+        return false;
+    }
+
+    _data = static_cast<const uint8_t *>(data);
+    _size = status.st_size;
+    return true;
+}
+
+void TrafficReplay::Close()
+{
+    if (_data != nullptr)
+    {
+        munmap(const_cast<uint8_t *>(_data), _size);
+        _data = nullptr;
+        _size = 0;
+    }
+}
+
+bool TrafficReplay::HasChannel(uint8_t channel)
+{
+    size_t cursor = 0;
+    return Next(channel, cursor) != nullptr;
+}
+
+const traffic_record_t *TrafficReplay::Next(uint8_t channel, size_t &cursor)
+{
+    if (cursor < sizeof(traffic_file_header_t))
+    {
+        cursor = sizeof(traffic_file_header_t);
+    }
+
+    while (_data != nullptr && cursor + sizeof(traffic_record_t) <= _size)
+    {
+        const traffic_record_t *record = reinterpret_cast<const traffic_record_t *>(_data + cursor);
+        size_t next = cursor + sizeof(traffic_record_t) + record->length;
+        if (next > _size)
+        {
+            // Truncated last record, the capture was not closed properly
+            break;
+        }
+
+        cursor = next;
+        if (record->channel == channel)
+        {
+            return record;
+        }
+    }
+    return nullptr;
+}
+
+const uint8_t *TrafficReplay::GetPayload(const traffic_record_t *record)
+{
+    return reinterpret_cast<const uint8_t *>(record) + sizeof(traffic_record_t);
+}
+
+size_t TrafficReplay::GetOffset(const traffic_record_t *record)
+{
+    return reinterpret_cast<const uint8_t *>(record) - _data;
+}
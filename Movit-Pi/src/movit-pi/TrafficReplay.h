@@ -0,0 +1,34 @@
+#ifndef TRAFFIC_REPLAY_H
+#define TRAFFIC_REPLAY_H
+
+#include "TrafficRecord.h"
+#include <stddef.h>
+#include <string>
+
+// Read-only, memory-mapped view of a capture file. The pages are loaded by the
+// kernel as the capture is walked, so captures of any length can be replayed.
+class TrafficReplay
+{
+  public:
+    TrafficReplay(std::string fileName);
+    ~TrafficReplay();
+
+    bool Open();
+    void Close();
+
+    bool HasChannel(uint8_t channel);
+
+    // Returns the next record of the channel after the cursor, and moves the
+    // cursor past it. Returns nullptr at the end of the capture.
+    const traffic_record_t *Next(uint8_t channel, size_t &cursor);
+    const uint8_t *GetPayload(const traffic_record_t *record);
+    // Cursor that makes Next() return this record
+    size_t GetOffset(const traffic_record_t *record);
+
+  private:
+    std::string _fileName;
+    const uint8_t *_data = nullptr;
+    size_t _size = 0;
+};
+
+#endif // TRAFFIC_REPLAY_H
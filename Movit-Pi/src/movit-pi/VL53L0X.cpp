@@ -12,6 +12,9 @@
 // and sets the last bit correctly based on reads and writes
 #define ADDRESS_DEFAULT 0b0101001
 
+// Value of IDENTIFICATION_MODEL_ID
+#define MODEL_ID 0xEE
+
 #define Millis() (std::chrono::high_resolution_clock::now())
 
 // Record the current time to check an upcoming timeout against
@@ -38,6 +41,7 @@
 
 VL53L0X::VL53L0X() : address(ADDRESS_DEFAULT), io_timeout(500), did_timeout(false)
 {
+    bus = I2Cdev::GetBus(sensorBus);
 }
 
 // Public Methods //////////////////////////////////////////////////////////////
@@ -48,6 +52,12 @@ void VL53L0X::SetAddress(uint8_t new_addr)
   address = new_addr;
 }
 
+// Check that the sensor answers with its model ID, a single register read
+bool VL53L0X::IsConnected()
+{
+  return ReadReg(IDENTIFICATION_MODEL_ID) == MODEL_ID;
+}
+
 // Initialize sensor using sequence based on VL53L0X_DataInit(),
 // VL53L0X_StaticInit(), and VL53L0X_PerformRefCalibration().
 // This function does not perform reference SPAD calibration
@@ -263,20 +273,20 @@ bool VL53L0X::Initialize(bool io_2v8)
 // Write an 8-bit register
 bool VL53L0X::WriteReg(uint8_t reg, uint8_t value)
 {
-  return I2Cdev::WriteByte(address, reg, value);
+  return bus->WriteByte(address, reg, value);
 }
 
 // Write a 16-bit register
 bool VL53L0X::WriteReg16Bit(uint8_t reg, uint16_t value)
 {
-  return I2Cdev::WriteWord(address, reg, value);
+  return bus->WriteWord(address, reg, value);
 }
 
 // Read an 8-bit register
 uint8_t VL53L0X::ReadReg(uint8_t reg)
 {
   uint8_t value;
-  if(I2Cdev::ReadByte(address, reg, &value))
+  if(bus->ReadByte(address, reg, &value))
   {
     return value;
   }
@@ -287,7 +297,7 @@ uint8_t VL53L0X::ReadReg(uint8_t reg)
 uint16_t VL53L0X::ReadReg16Bit(uint8_t reg)
 {
   uint16_t value;
-  if(I2Cdev::ReadWord(address, reg, &value))
+  if(bus->ReadWord(address, reg, &value))
   {
     return value;
   }
@@ -298,14 +308,14 @@ uint16_t VL53L0X::ReadReg16Bit(uint8_t reg)
 // starting at the given register
 bool VL53L0X::WriteMulti(uint8_t reg, uint8_t *src, uint8_t count)
 {
-  return I2Cdev::WriteBytes(address, reg, count, src);
+  return bus->WriteBytes(address, reg, count, src);
 }
 
 // Read an arbitrary number of bytes from the sensor, starting at the given
 // register, into the given array
 bool VL53L0X::ReadMulti(uint8_t reg, uint8_t *dst, uint8_t count)
 {
-  return I2Cdev::ReadBytes(address, reg, count, dst);
+  return bus->ReadBytes(address, reg, count, dst);
 }
 
 // Set the return signal rate limit check value in units of MCPS (mega counts
@@ -732,6 +742,8 @@ uint16_t VL53L0X::ReadRangeContinuousMillimeters()
   // fractional ranging is not enabled
   uint16_t range = ReadReg16Bit(RESULT_RANGE_STATUS + 10);
 
+  // Not batched with the read: a failed batch is not replayed, the interrupt
+  // would stay set and the next call return this range again
   WriteReg(SYSTEM_INTERRUPT_CLEAR, 0x01);
 
   return range;
@@ -742,15 +754,17 @@ uint16_t VL53L0X::ReadRangeContinuousMillimeters()
 // based on VL53L0X_PerformSingleRangingMeasurement()
 uint16_t VL53L0X::ReadRangeSingleMillimeters()
 {
-  WriteReg(0x80, 0x01);
-  WriteReg(0xFF, 0x01);
-  WriteReg(0x00, 0x00);
-  WriteReg(0x91, stop_variable);
-  WriteReg(0x00, 0x01);
-  WriteReg(0xFF, 0x00);
-  WriteReg(0x80, 0x00);
-
-  WriteReg(SYSRANGE_START, 0x01);
+  I2cBatch batch;
+  batch.WriteByte(address, 0x80, 0x01);
+  batch.WriteByte(address, 0xFF, 0x01);
+  batch.WriteByte(address, 0x00, 0x00);
+  batch.WriteByte(address, 0x91, stop_variable);
+  batch.WriteByte(address, 0x00, 0x01);
+  batch.WriteByte(address, 0xFF, 0x00);
+  batch.WriteByte(address, 0x80, 0x00);
+
+  batch.WriteByte(address, SYSRANGE_START, 0x01);
+  bus->Submit(batch);
 
   // "Wait until start bit has been cleared"
   StartTimeout();
@@ -1,6 +1,8 @@
 #include <stdint.h>
 #include <chrono>
 
+class I2Cdev;
+
 #ifndef VL53L0X_H
 #define VL53L0X_H
 
@@ -101,6 +103,7 @@ class VL53L0X
     inline uint8_t GetAddress() { return address; }
 
     bool Initialize(bool io_2v8 = true);
+    bool IsConnected();
 
     bool SetSignalRateLimit(float limit_Mcps);
     float GetSignalRateLimit();
@@ -141,6 +144,7 @@ class VL53L0X
       uint32_t msrc_dss_tcc_us,    pre_range_us,    final_range_us;
     };
 
+    I2Cdev *bus;
     uint8_t address;
     uint32_t io_timeout;
     bool did_timeout;
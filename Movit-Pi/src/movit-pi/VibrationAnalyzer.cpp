@@ -0,0 +1,160 @@
+#include "VibrationAnalyzer.h"
+
+#include <algorithm>
+#include <math.h>
+
+void VibrationAnalyzer::Reset(uint16_t sampleRate)
+{
+    _sampleRate = sampleRate;
+
+    // Power of two nearest to two seconds of samples: 256 at 100 Hz, 1024 at
+    // 500 Hz and 2048 at 1 kHz
+    const uint32_t targetSize = 2 * static_cast<uint32_t>(sampleRate);
+    uint16_t windowSize = 4;
+    while (windowSize * 2 <= VIBRATION_MAX_WINDOW_SIZE && 3 * windowSize < 2 * targetSize)
+    {
+        windowSize *= 2;
+    }
+
+    if (windowSize != _windowSize)
+    {
+        _windowSize = windowSize;
+        _hopSize = windowSize / 4;
+        _fft.reset(new RealFft(windowSize));
+
+        _window.resize(windowSize);
+        _windowPower = 0;
+        for (uint16_t i = 0; i < windowSize; i++)
+        {
+            _window[i] = static_cast<float>(0.5 - 0.5 * cos(2 * M_PI * i / windowSize));
+            _windowPower += _window[i] * _window[i];
+        }
+
+        _history.resize(windowSize);
+        _samples.resize(windowSize);
+        _spectrum.resize(windowSize / 2 + 1);
+        _meanSquares.resize(windowSize / 2 + 1);
+    }
+
+    // First bin of each band, the DC bin is never part of one
+    const double binWidth = static_cast<double>(sampleRate) / windowSize;
+    const uint16_t binCount = windowSize / 2 + 1;
+    for (uint8_t band = 0; band <= VIBRATION_BAND_COUNT; band++)
+    {
+        const double frequency = VIBRATION_LOWEST_FREQUENCY * (1 << band);
+        _bandBins[band] = static_cast<uint16_t>(std::min<double>(std::max(1.0, ceil(frequency / binWidth)), binCount));
+    }
+
+    std::fill(_history.begin(), _history.end(), 0.0f);
+    _sampleCount = 0;
+    _newSamples = 0;
+
+    std::fill(_meanSquares.begin(), _meanSquares.end(), 0.0f);
+    _windows = 0;
+    _squares = 0;
+    _squaresCount = 0;
+    _peak = 0;
+}
+
+void VibrationAnalyzer::AddSample(float acceleration)
+{
+    if (_windowSize == 0)
+    {
+        return;
+    }
+
+    _history[_sampleCount % _windowSize] = acceleration;
+    _sampleCount++;
+    _newSamples++;
+
+    if (_sampleCount >= _windowSize && _newSamples >= _hopSize)
+    {
+        AnalyzeWindow();
+        _newSamples = 0;
+    }
+}
+
+void VibrationAnalyzer::AnalyzeWindow()
+{
+    // The history is full, its oldest sample is the next one overwritten
+    const uint16_t oldest = _sampleCount % _windowSize;
+    double sum = 0;
+    for (uint16_t i = 0; i < _windowSize; i++)
+    {
+        _samples[i] = _history[(oldest + i) % _windowSize];
+        sum += _samples[i];
+    }
+    const float mean = static_cast<float>(sum / _windowSize);
+
+    // The samples new to this window are counted once in the RMS and the peak
+    for (uint16_t i = 0; i < _windowSize; i++)
+    {
+        _samples[i] -= mean;
+        if (i >= _windowSize - _newSamples)
+        {
+            _squares += _samples[i] * _samples[i];
+            _squaresCount++;
+            _peak = std::max(_peak, fabsf(_samples[i]));
+        }
+        _samples[i] *= _window[i];
+    }
+
+    _fft->ComputePowerSpectrum(_samples.data(), _spectrum.data());
+
+    // Mean square of the signal in each bin, one-sided: all bins but the DC
+    // and the Nyquist ones also hold their negative frequency
+    const float scale = 1.0f / (_windowSize * _windowPower);
+    const uint16_t nyquistBin = _windowSize / 2;
+    for (uint16_t k = 1; k <= nyquistBin; k++)
+    {
+        _meanSquares[k] += (k == nyquistBin ? 1 : 2) * _spectrum[k] * scale;
+    }
+    _windows++;
+}
+
+bool VibrationAnalyzer::GetSummary(vibration_summary_t &summary)
+{
+    if (_windows == 0 || _squaresCount == 0)
+    {
+        return false;
+    }
+
+    summary.sampleRate = _sampleRate;
+    summary.windows = _windows;
+    summary.rms = static_cast<float>(sqrt(_squares / _squaresCount));
+    summary.peak = _peak;
+
+    const double binWidth = static_cast<double>(_sampleRate) / _windowSize;
+    uint16_t dominantBin = 1;
+    for (uint16_t k = 1; k < _meanSquares.size(); k++)
+    {
+        if (_meanSquares[k] > _meanSquares[dominantBin])
+        {
+            dominantBin = k;
+        }
+    }
+    summary.dominantFrequency = static_cast<float>(dominantBin * binWidth);
+
+    summary.bandCount = 0;
+    for (uint8_t band = 0; band < VIBRATION_BAND_COUNT; band++)
+    {
+        float meanSquare = 0;
+        for (uint16_t k = _bandBins[band]; k < _bandBins[band + 1]; k++)
+        {
+            meanSquare += _meanSquares[k];
+        }
+        summary.bands[band] = sqrtf(meanSquare / _windows);
+
+        if (VIBRATION_LOWEST_FREQUENCY * (1 << band) < _sampleRate / 2.0)
+        {
+            summary.bandCount = band + 1;
+        }
+    }
+
+    std::fill(_meanSquares.begin(), _meanSquares.end(), 0.0f);
+    _windows = 0;
+    _squares = 0;
+    _squaresCount = 0;
+    _peak = 0;
+    return true;
+}
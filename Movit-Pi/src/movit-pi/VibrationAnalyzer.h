@@ -0,0 +1,70 @@
+#ifndef VIBRATION_ANALYZER_H
+#define VIBRATION_ANALYZER_H
+
+#include "RealFft.h"
+
+#include <memory>
+#include <stdint.h>
+#include <vector>
+
+// Octave bands from 0.5 Hz, the last one ending at 512 Hz. The whole-body
+// vibrations are in the first eight (0.5 to 80 Hz, ISO 2631-1).
+#define VIBRATION_BAND_COUNT 10
+#define VIBRATION_LOWEST_FREQUENCY 0.5 // Hz
+#define VIBRATION_MAX_WINDOW_SIZE 2048 // Samples, 2.05 s at 1 kHz
+
+struct vibration_summary_t
+{
+    uint16_t sampleRate; // Hz
+    uint16_t windows;    // Spectra averaged in the bands
+    float rms;           // m/s^2, without the gravity
+    float peak;          // m/s^2, largest deviation from the gravity
+    float dominantFrequency;
+    uint8_t bandCount; // Bands below the Nyquist frequency
+    float bands[VIBRATION_BAND_COUNT]; // RMS in each octave band, in m/s^2
+};
+
+// Vibrations along one axis of an IMU, summarized over a period. The samples
+// are analyzed in Hann windows of 1.3 to 2.7 s overlapping by 75 %, so
+// that every second has complete spectra. The mean of each window, the
+// gravity, is removed. The band energies are averaged over the windows of the
+// period (Welch), the RMS and the peak cover every sample once.
+class VibrationAnalyzer
+{
+  public:
+    // Clears the samples and the summary, for samples at this rate
+    void Reset(uint16_t sampleRate);
+    uint16_t GetSampleRate() { return _sampleRate; }
+
+    // Acceleration in m/s^2, gravity included
+    void AddSample(float acceleration);
+
+    // Summary of the samples since the previous call, false until a first
+    // window was analyzed
+    bool GetSummary(vibration_summary_t &summary);
+
+  private:
+    void AnalyzeWindow();
+
+    uint16_t _sampleRate = 0;
+    uint16_t _windowSize = 0;
+    uint16_t _hopSize = 0;
+    std::unique_ptr<RealFft> _fft;
+    std::vector<float> _window;   // Hann coefficients
+    std::vector<float> _history;  // Latest samples, circular
+    std::vector<float> _samples;  // Window in order, without its mean
+    std::vector<float> _spectrum; // Squared magnitudes of the window
+    float _windowPower = 0;       // Sum of the squared Hann coefficients
+    uint16_t _bandBins[VIBRATION_BAND_COUNT + 1];
+    uint32_t _sampleCount = 0;
+    uint16_t _newSamples = 0;
+
+    // Accumulated since the previous summary
+    std::vector<float> _meanSquares; // Per bin
+    uint16_t _windows = 0;
+    double _squares = 0;
+    uint32_t _squaresCount = 0;
+    float _peak = 0;
+};
+
+#endif // VIBRATION_ANALYZER_H
@@ -11,21 +11,181 @@
 #include "Utils.h"
 #include "SysTime.h"
 #include "FileManager.h"
+#include "GpioEventLine.h"
+#include "I2Cdev.h"
+#include "CenterOfPressure.h"
+#include "FastMath.h"
+#include "Filters.h"
+#include "Pipeline.h"
+#include "Imu.h"
+#include "BusStatistics.h"
+#include "LinuxI2cBackend.h"
+#include "SPIdev.h"
+#include "SimScenario.h"
+#include "TrafficRecorder.h"
+#include "TrafficReplay.h"
 
 using std::string;
 using std::chrono::duration;
 using std::chrono::milliseconds;
 
+std::shared_ptr<TrafficRecorder> trafficRecorder;
+SimScenario simScenario;
+volatile sig_atomic_t isBusStatisticsRequested = 0;
+
+void print_usage(const char *programName)
+{
+    printf("Usage: %s [-i [i2c-device]] [-p i2c-device] [-r capture | -R capture | -s [scenario]] [-f algorithm] [-a rate] [-g [gpiochip]] [-b]\n", programName);
+    printf("  -i [i2c-device]  Use the kernel i2c-dev driver (default: %s) instead of bcm2835\n", LINUX_I2C_DEFAULT_DEVICE);
+    printf("  -p i2c-device    Access the RTC and the alarm on a second bus (Ex: /dev/i2c-3)\n");
+    printf("  -r capture       Record the I2C and SPI traffic to a capture file\n");
+    printf("  -R capture       Replay a capture file instead of accessing the devices\n");
+    printf("  -s [scenario]    Use the simulated devices, driven by a scenario file\n");
+    printf("  -f algorithm     Fusion of the IMU samples: complementary, mahony (default) or madgwick\n");
+    printf("  -a rate          Sample rate of the IMUs, %i to %i Hz (default: %i)\n", IMU_FIFO_MIN_SAMPLE_RATE, IMU_FIFO_MAX_SAMPLE_RATE, IMU_FIFO_SAMPLE_RATE);
+    printf("  -b               Measure the cost of the fusion algorithms, the angles, the filters, the pipelines, the center of pressure and the I2C backends, and exit\n");
+    printf("  -g [gpiochip]    Sample the IMUs on their INT pin interrupts (default: %s)\n", GPIO_DEFAULT_CHIP);
+}
+
+bool parse_arguments(int argc, char *argv[])
+{
+    for (int i = 1; i < argc; i++)
+    {
+        string argument = argv[i];
+        if (argument == "-i")
+        {
+            string device = LINUX_I2C_DEFAULT_DEVICE;
+            if (i + 1 < argc && argv[i + 1][0] != '-')
+            {
+                device = argv[++i];
+            }
+            I2Cdev::SelectBackend(sensorBus, linuxI2cDevBackend, device);
+        }
+        else if (argument == "-p" && i + 1 < argc)
+        {
+            I2Cdev::SelectBackend(peripheralBus, linuxI2cDevBackend, argv[++i]);
+        }
+        else if (argument == "-r" && i + 1 < argc)
+        {
+            trafficRecorder = std::make_shared<TrafficRecorder>(argv[++i]);
+            if (!trafficRecorder->Open())
+            {
+                return false;
+            }
+            I2Cdev::SetRecorder(trafficRecorder);
+            SPIdev::SetRecorder(trafficRecorder);
+        }
+        else if (argument == "-R" && i + 1 < argc)
+        {
+            string capture = argv[++i];
+            TrafficReplay replay(capture);
+            if (!replay.Open())
+            {
+                return false;
+            }
+            I2Cdev::SelectBackend(sensorBus, replayBackend, capture);
+            if (replay.HasChannel(peripheralBus))
+            {
+                I2Cdev::SelectBackend(peripheralBus, replayBackend, capture);
+            }
+            SPIdev::SelectBackend(replaySpiBackend, capture);
+        }
+        else if (argument == "-s")
+        {
+            if (i + 1 < argc && argv[i + 1][0] != '-' && !simScenario.Load(argv[++i]))
+            {
+                return false;
+            }
+            I2Cdev::SelectBackend(sensorBus, simBackend, "");
+            SPIdev::SelectBackend(simSpiBackend, "");
+            GpioEventLine::SelectBackend(simGpioBackend, "");
+        }
+        else if (argument == "-f" && i + 1 < argc)
+        {
+            FusionAlgorithm algorithm;
+            if (!OrientationFilter::GetAlgorithm(argv[++i], algorithm))
+            {
+                print_usage(argv[0]);
+                return false;
+            }
+            Imu::SetFusionAlgorithm(algorithm);
+        }
+        else if (argument == "-a" && i + 1 < argc)
+        {
+            if (!Imu::SetSampleRate(atoi(argv[++i])))
+            {
+                print_usage(argv[0]);
+                return false;
+            }
+        }
+        else if (argument == "-g")
+        {
+            if (i + 1 < argc && argv[i + 1][0] != '-')
+            {
+                GpioEventLine::SelectBackend(gpiochipBackend, argv[++i]);
+            }
+            Imu::SetInterruptsEnabled(true);
+        }
+        else if (argument == "-b")
+        {
+            OrientationFilter::Benchmark();
+            BenchmarkTiltAngles();
+            BenchmarkFilters();
+            BenchmarkPipeline();
+            BenchmarkCenterOfPressure();
+            BenchmarkI2cBackends();
+            exit(0);
+        }
+        else
+        {
+            print_usage(argv[0]);
+            return false;
+        }
+    }
+    return true;
+}
+
+void print_i2c_statistics()
+{
+    I2Cdev *previousBus = nullptr;
+    for (uint8_t busId = 0; busId < busCount; busId++)
+    {
+        I2Cdev *bus = I2Cdev::GetBus(static_cast<I2cBusId>(busId));
+        if (bus != previousBus)
+        {
+            i2c_cache_statistics_t statistics = bus->GetCacheStatistics();
+            printf("I2C bus %i: %.1f operations/s, %.1f saved/s by the register cache, %.1f mux switches/s (%.1f avoided/s)\n", busId,
+                   statistics.busOperationsPerSecond, statistics.savedOperationsPerSecond, statistics.muxSwitchesPerSecond, statistics.savedMuxSwitchesPerSecond);
+        }
+        previousBus = bus;
+    }
+}
+
+// Printing is not async-signal-safe, the main loop dumps the statistics
+void bus_statistics_handler(int s)
+{
+    isBusStatisticsRequested = 1;
+}
+
 void exit_program_handler(int s)
 {
     FileManager *fileManager = FileManager::GetInstance();
     DeviceManager *deviceManager = DeviceManager::GetInstance(fileManager);
     deviceManager->TurnOff();
+    if (trafficRecorder)
+    {
+        trafficRecorder->Close();
+    }
     exit(1);
 }
 
 int main(int argc, char *argv[])
 {
+    if (!parse_arguments(argc, argv))
+    {
+        return 1;
+    }
+
     struct sigaction sigIntHandler;
 
     sigIntHandler.sa_handler = exit_program_handler;
@@ -34,6 +194,14 @@ int main(int argc, char *argv[])
 
     sigaction(SIGINT, &sigIntHandler, NULL);
 
+    struct sigaction sigUsr1Handler;
+
+    sigUsr1Handler.sa_handler = bus_statistics_handler;
+    sigemptyset(&sigUsr1Handler.sa_mask);
+    sigUsr1Handler.sa_flags = SA_RESTART;
+
+    sigaction(SIGUSR1, &sigUsr1Handler, NULL);
+
     MosquittoBroker mosquittoBroker("embedded");
     FileManager *fileManager = FileManager::GetInstance();
     DeviceManager *deviceManager = DeviceManager::GetInstance(fileManager);
@@ -45,9 +213,12 @@ int main(int argc, char *argv[])
     auto end = std::chrono::system_clock::now();
     auto period = milliseconds(static_cast<int>((1 / RUNNING_FREQUENCY) * SECONDS_TO_MILLISECONDS));
 
-    // Ce feature ne sera pas implemente pour l'instant.
-    // Aussi ca ne devrais pas être un thread car ca cause des problemes avec le port i2c
-    // chairManager.ReadVibrationsThread().detach();
+    // Ce thread lit les echantillons de la centrale fixe sans acceder au bus i2c
+    chairManager.ReadVibrationsThread().detach();
+
+    uint32_t loopCount = 0;
+
+    simScenario.Start();
 
     while (true)
     {
@@ -57,6 +228,19 @@ int main(int argc, char *argv[])
         chairManager.UpdateDevices();
         chairManager.CheckNotification();
 
+        if (++loopCount >= I2C_STATISTICS_PERIOD * RUNNING_FREQUENCY)
+        {
+            print_i2c_statistics();
+            mosquittoBroker.SendBusStatistics(BusStatistics::GetInstance()->GetStatistics(), std::to_string(deviceManager->GetTimeSinceEpoch()));
+            loopCount = 0;
+        }
+
+        if (isBusStatisticsRequested)
+        {
+            isBusStatisticsRequested = 0;
+            BusStatistics::GetInstance()->Print();
+        }
+
         end = std::chrono::system_clock::now();
         auto elapse_time = std::chrono::duration_cast<milliseconds>(end - start);
 